@@ -333,6 +333,17 @@ public class Helper {
             return value;
         }
 
+        if (isUTF8(enc)) {
+            char[] value = new char[length];
+            int size = utf8Decode(buffer, offset, length, value, 0);
+            if (size < length) {
+                char[] trimmed = new char[size];
+                System.arraycopy(value, 0, trimmed, 0, size);
+                value = trimmed;
+            }
+            return value;
+        }
+
         /* If we don't have a cached reader then make one */
         if (lastReaderEncoding == null || !lastReaderEncoding.equals(enc)) {
             lastReader = getStreamReaderPrim(enc);
@@ -395,6 +406,12 @@ public class Helper {
             return value;
         }
 
+        if (isUTF8(enc)) {
+            byte[] value = new byte[utf8EncodedLength(buffer, offset, length)];
+            utf8Encode(buffer, offset, length, value, 0);
+            return value;
+        }
+
         /* If we don't have a cached writer then make one */
         if (lastWriterEncoding == null || !lastWriterEncoding.equals(enc)) {
             lastWriter = getStreamWriterPrim(enc);
@@ -433,6 +450,103 @@ public class Helper {
         return os.toByteArray();
     }
 
+    /**
+     * Tests whether an encoding name denotes UTF-8 without normalizing it.
+     *
+     * @param  enc             The character encoding
+     * @return                 true if <code>enc</code> is UTF-8
+     */
+    private static boolean isUTF8(String enc) {
+        return enc.length() == 5
+            && (enc.equals("UTF-8") || enc.equals("UTF_8")
+                || enc.equals("utf-8"));
+    }
+
+/*------------------------------------------------------------------------------*/
+/*                            Bulk UTF-8 conversion                             */
+/*------------------------------------------------------------------------------*/
+
+    /**
+     * Decode UTF-8 bytes into chars. Malformed input is replaced with
+     * U+FFFD in the same way as by the UTF_8 reader.
+     *
+     * @param  src             The UTF-8 bytes
+     * @param  srcOff          Offset of the first byte
+     * @param  srcLen          Number of bytes to decode
+     * @param  dst             Destination, with room for srcLen chars
+     * @param  dstOff          Offset of the first char in dst
+     * @return                 The number of chars stored
+     */
+    public static native int utf8Decode(byte[] src, int srcOff, int srcLen,
+                                        char[] dst, int dstOff);
+
+    /**
+     * Get the number of bytes that utf8Encode produces.
+     *
+     * @param  src             The chars
+     * @param  off             Offset of the first char
+     * @param  len             Number of chars
+     * @return                 The length of the UTF-8 encoding
+     */
+    public static native int utf8EncodedLength(char[] src, int off, int len);
+
+    /**
+     * Encode chars as UTF-8. Surrogate pairs are encoded as one
+     * character, unpaired surrogates as '?'.
+     *
+     * @param  src             The chars
+     * @param  off             Offset of the first char
+     * @param  len             Number of chars
+     * @param  dst             Destination, with room for
+     *                         utf8EncodedLength(src, off, len) bytes
+     * @param  dstOff          Offset of the first byte in dst
+     * @return                 The number of bytes stored
+     */
+    public static native int utf8Encode(char[] src, int off, int len,
+                                        byte[] dst, int dstOff);
+
+    /**
+     * Decode the modified UTF-8 format used by
+     * <code>DataInput.readUTF</code>.
+     *
+     * @param  src             The encoded bytes
+     * @param  srcOff          Offset of the first byte
+     * @param  srcLen          Number of bytes to decode
+     * @param  dst             Destination, with room for srcLen chars
+     * @param  dstOff          Offset of the first char in dst
+     * @return                 The number of chars stored, or -1 if the
+     *                         input is malformed
+     */
+    public static native int modifiedUtf8Decode(byte[] src, int srcOff,
+                                                int srcLen, char[] dst,
+                                                int dstOff);
+
+    /**
+     * Get the number of bytes that modifiedUtf8Encode produces.
+     *
+     * @param  src             The chars
+     * @param  off             Offset of the first char
+     * @param  len             Number of chars
+     * @return                 The length of the modified UTF-8 encoding
+     */
+    public static native int modifiedUtf8EncodedLength(char[] src, int off,
+                                                       int len);
+
+    /**
+     * Encode chars in the modified UTF-8 format used by
+     * <code>DataOutput.writeUTF</code>.
+     *
+     * @param  src             The chars
+     * @param  off             Offset of the first char
+     * @param  len             Number of chars
+     * @param  dst             Destination, with room for
+     *                         modifiedUtf8EncodedLength(src, off, len) bytes
+     * @param  dstOff          Offset of the first byte in dst
+     * @return                 The number of bytes stored
+     */
+    public static native int modifiedUtf8Encode(char[] src, int off, int len,
+                                                byte[] dst, int dstOff);
+
     /**
      * Get the internal name for an encoding.
      *
@@ -26,6 +26,7 @@
 
 package com.sun.cldc.i18n.j2me;
 
+import com.sun.cldc.i18n.Helper;
 import com.sun.cldc.i18n.StreamReader;
 
 import java.io.*;
@@ -64,6 +65,11 @@ public class UTF_8_Reader extends StreamReader {
          */
         int pendingSurrogate = 0;
     }
+    /** size of the byte buffer used for bulk decoding */
+    private static final int BULK_BUFFER_SIZE = 512;
+    /** byte buffer used for bulk decoding, allocated on first use */
+    private byte[] bulkBuffer;
+
     /** information saved by mark() and later used by reset() */
     MarkInfo markInfo = null;
     /** false if mark() has not been invoked yet */
@@ -99,6 +105,89 @@ public class UTF_8_Reader extends StreamReader {
      * could not be read for the raw unconverted character
      */
     public int read(char cbuf[], int off, int len) throws IOException {
+        if (len > 1 && pendingSurrogate == 0 && readAhead[0] == NO_BYTE) {
+            int count = readBulk(cbuf, off, len);
+            if (count > 0) {
+                return count;
+            }
+        }
+        return readChars(cbuf, off, len);
+    }
+
+    /**
+     * Decode the bytes that are already available in the input stream
+     * with one native call. At most <code>len</code> bytes are read, so
+     * the result always fits. A character whose bytes are not all
+     * available yet is left in the read ahead buffer.
+     *
+     * @param cbuf output buffer for converted characters read
+     * @param off initial offset into the provided buffer
+     * @param len length of characters in the buffer
+     * @return the number of converted characters, 0 if none could be
+     *         converted without blocking
+     * @exception IOException is thrown if the input stream
+     * could not be read for the raw unconverted character
+     */
+    private int readBulk(char cbuf[], int off, int len) throws IOException {
+        int available = in.available();
+        if (available <= 0) {
+            return 0;
+        }
+        if (bulkBuffer == null) {
+            bulkBuffer = new byte[BULK_BUFFER_SIZE];
+        }
+        if (available > len) {
+            available = len;
+        }
+        if (available > BULK_BUFFER_SIZE) {
+            available = BULK_BUFFER_SIZE;
+        }
+        int n = in.read(bulkBuffer, 0, available);
+        if (n <= 0) {
+            return 0;
+        }
+
+        // find the start of the last character and keep it for the
+        // next read if some of its bytes are still missing
+        int start = n - 1;
+        while (start > 0 && start > n - MAX_BYTES_PER_CHAR
+               && (bulkBuffer[start] & 0xC0) == 0x80) {
+            start--;
+        }
+        int lead = bulkBuffer[start] & 0xFF;
+        int needed;
+        if (lead < 0xC0) {
+            needed = 1;
+        } else if (lead < 0xE0) {
+            needed = 2;
+        } else if (lead < 0xF0) {
+            needed = 3;
+        } else if (lead < 0xF8) {
+            needed = 4;
+        } else {
+            needed = 1;
+        }
+        int tail = 0;
+        if (start + needed > n) {
+            tail = n - start;
+            for (int i = 0; i < tail; i++) {
+                readAhead[i] = bulkBuffer[start + i] & 0xFF;
+            }
+        }
+        return Helper.utf8Decode(bulkBuffer, 0, n - tail, cbuf, off);
+    }
+
+    /**
+     * Read a block of UTF8 characters one byte at a time.
+     *
+     * @param cbuf output buffer for converted characters read
+     * @param off initial offset into the provided buffer
+     * @param len length of characters in the buffer
+     * @return the number of converted characters
+     * @exception IOException is thrown if the input stream
+     * could not be read for the raw unconverted character
+     */
+    private int readChars(char cbuf[], int off, int len) throws IOException {
         int count = 0;
         int firstByte;
         int extraBytes;
@@ -28,6 +28,8 @@ package com.sun.cldc.i18n.j2me;
 
 import java.io.*;
 
+import com.sun.cldc.i18n.Helper;
+
 /**
  * Writer for UTF-8 encoded output streams. NOTE: The UTF-8 writer only
  * supports UCS-2, or Unicode, to UTF-8 conversion. There is no support
@@ -44,6 +46,12 @@ public class UTF_8_Writer extends com.sun.cldc.i18n.StreamWriter {
     /** This value replaces invalid characters
      * (that is, surrogates code units without a pair) */
     static final private int replacementValue = 0x3f;
+
+    /** number of characters encoded by one native call */
+    private static final int BULK_CHARS = 256;
+    /** byte buffer used for bulk encoding, allocated on first use */
+    private byte[] bulkBuffer;
+
     /**
      * Write a portion of an array of characters.
      *
@@ -54,6 +62,57 @@ public class UTF_8_Writer extends com.sun.cldc.i18n.StreamWriter {
      * @exception  IOException  If an I/O error occurs
      */
     public void write(char cbuf[], int off, int len) throws IOException {
+        while (len > 0 && 0 != pendingSurrogate) {
+            // the next character completes or breaks the pending pair
+            writeChars(cbuf, off, 1);
+            off++;
+            len--;
+        }
+        if (len <= 0) {
+            return;
+        }
+
+        // a trailing high surrogate waits for the next write()
+        int last = 0xffff & cbuf[off + len - 1];
+        if (0xd800<=last && last<=0xdbff) {
+            len--;
+        }
+
+        if (len > 0 && bulkBuffer == null) {
+            // Never more than 3 bytes per character
+            bulkBuffer = new byte[BULK_CHARS * 3];
+        }
+        while (len > 0) {
+            int chunk = (len > BULK_CHARS) ? BULK_CHARS : len;
+            if (chunk < len) {
+                // don't split a surrogate pair between two chunks
+                int c = 0xffff & cbuf[off + chunk - 1];
+                if (0xd800<=c && c<=0xdbff) {
+                    chunk--;
+                }
+            }
+            int n = Helper.utf8Encode(cbuf, off, chunk, bulkBuffer, 0);
+            out.write(bulkBuffer, 0, n);
+            off += chunk;
+            len -= chunk;
+        }
+
+        if (0xd800<=last && last<=0xdbff) {
+            pendingSurrogate = last;
+        }
+    }
+
+    /**
+     * Write a portion of an array of characters one character at a time.
+     *
+     * @param  cbuf  Array of characters
+     * @param  off   Offset from which to start writing characters
+     * @param  len   Number of characters to write
+     *
+     * @exception  IOException  If an I/O error occurs
+     */
+    private void writeChars(char cbuf[], int off, int len)
+        throws IOException {
         byte[] outputByte = new byte[4];     // Never more than 4 encoded bytes
         int inputChar;
         int outputSize;
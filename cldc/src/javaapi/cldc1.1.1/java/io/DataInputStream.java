@@ -45,6 +45,12 @@ class DataInputStream extends InputStream implements DataInput {
      */
     protected InputStream in;
 
+    /**
+     * Scratch buffer for the multi-byte reads, so that each value is
+     * fetched from the underlying stream with a single call.
+     */
+    private final byte readBuffer[] = new byte[8];
+
     /**
      * Creates a <code>DataInputStream</code>
      * and saves its  argument, the input stream
@@ -269,12 +275,8 @@ class DataInputStream extends InputStream implements DataInput {
      * @exception  IOException   if an I/O error occurs.
      */
     public final int readUnsignedShort() throws IOException {
-        int ch1 = read();
-        int ch2 = read();
-        if ((ch1 | ch2) < 0) {
-             throw new EOFException();
-        }
-        return (ch1 << 8) + (ch2 << 0);
+        readFully(readBuffer, 0, 2);
+        return ((readBuffer[0] & 0xFF) << 8) + (readBuffer[1] & 0xFF);
     }
 
     /**
@@ -308,14 +310,13 @@ class DataInputStream extends InputStream implements DataInput {
      * @exception  IOException   if an I/O error occurs.
      */
     public final int readInt() throws IOException {
-        int ch1 = read();
-        int ch2 = read();
-        int ch3 = read();
-        int ch4 = read();
-        if ((ch1 | ch2 | ch3 | ch4) < 0) {
-             throw new EOFException();
-        }
-        return ((ch1 << 24) + (ch2 << 16) + (ch3 << 8) + (ch4 << 0));
+        readFully(readBuffer, 0, 4);
+        return bigEndianInt(readBuffer, 0);
+    }
+
+    private static int bigEndianInt(byte b[], int off) {
+        return ((b[off] & 0xFF) << 24) + ((b[off + 1] & 0xFF) << 16) +
+               ((b[off + 2] & 0xFF) << 8) + (b[off + 3] & 0xFF);
     }
 
     /**
@@ -332,7 +333,9 @@ class DataInputStream extends InputStream implements DataInput {
      * @exception  IOException   if an I/O error occurs.
      */
     public final long readLong() throws IOException {
-        return ((long)(readInt()) << 32) + (readInt() & 0xFFFFFFFFL);
+        readFully(readBuffer, 0, 8);
+        return ((long)(bigEndianInt(readBuffer, 0)) << 32) +
+               (bigEndianInt(readBuffer, 4) & 0xFFFFFFFFL);
     }
 
     /**
@@ -415,47 +418,14 @@ class DataInputStream extends InputStream implements DataInput {
         int utflen = in.readUnsignedShort();
         char str[] = new char[utflen];
         byte bytearr [] = new byte[utflen];
-        int c, char2, char3;
-        int count = 0;
-        int strlen = 0;
 
         in.readFully(bytearr, 0, utflen);
 
-        while (count < utflen) {
-            c = (int) bytearr[count] & 0xff;
-            switch (c >> 4) {
-                case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7:
-                    /* 0xxxxxxx*/
-                    count++;
-                    str[strlen++] = (char)c;
-                    break;
-                case 12: case 13:
-                    /* 110x xxxx   10xx xxxx*/
-                    count += 2;
-                    if (count > utflen)
-                        throw new UTFDataFormatException();
-                    char2 = (int) bytearr[count-1];
-                    if ((char2 & 0xC0) != 0x80)
-                        throw new UTFDataFormatException();
-                    str[strlen++] = (char)(((c & 0x1F) << 6) | (char2 & 0x3F));
-                    break;
-                case 14:
-                    /* 1110 xxxx  10xx xxxx  10xx xxxx */
-                    count += 3;
-                    if (count > utflen)
-                        throw new UTFDataFormatException();
-                    char2 = (int) bytearr[count-2];
-                    char3 = (int) bytearr[count-1];
-                    if (((char2 & 0xC0) != 0x80) || ((char3 & 0xC0) != 0x80))
-                        throw new UTFDataFormatException();
-                    str[strlen++] = (char)(((c     & 0x0F) << 12) |
-                                           ((char2 & 0x3F) << 6)  |
-                                           ((char3 & 0x3F) << 0));
-                    break;
-                default:
-                    /* 10xx xxxx,  1111 xxxx */
-                    throw new UTFDataFormatException();
-                }
+        int strlen = com.sun.cldc.i18n.Helper.modifiedUtf8Decode(bytearr, 0,
+                                                                 utflen,
+                                                                 str, 0);
+        if (strlen < 0) {
+            throw new UTFDataFormatException();
         }
         // The number of chars produced may be less than utflen
         return new String(str, 0, strlen);
@@ -43,6 +43,12 @@ class DataOutputStream extends OutputStream implements DataOutput {
      */
     protected OutputStream out;
 
+    /**
+     * Scratch buffer for the multi-byte writes, so that each value is
+     * handed to the underlying stream with a single call.
+     */
+    private final byte writeBuffer[] = new byte[8];
+
     /**
      * Creates a new data output stream to write data to the specified
      * underlying output stream.
@@ -143,8 +149,9 @@ class DataOutputStream extends OutputStream implements DataOutput {
      * @exception  IOException  if an I/O error occurs.
      */
     public final void writeShort(int v) throws IOException {
-        write((v >>> 8) & 0xFF);
-        write((v >>> 0) & 0xFF);
+        writeBuffer[0] = (byte)(v >>> 8);
+        writeBuffer[1] = (byte)(v >>> 0);
+        write(writeBuffer, 0, 2);
     }
 
     /**
@@ -155,8 +162,7 @@ class DataOutputStream extends OutputStream implements DataOutput {
      * @exception  IOException  if an I/O error occurs.
      */
     public final void writeChar(int v) throws IOException {
-        write((v >>> 8) & 0xFF);
-        write((v >>> 0) & 0xFF);
+        writeShort(v);
     }
 
     /**
@@ -167,10 +173,11 @@ class DataOutputStream extends OutputStream implements DataOutput {
      * @exception  IOException  if an I/O error occurs.
      */
     public final void writeInt(int v) throws IOException {
-        write((v >>> 24) & 0xFF);
-        write((v >>> 16) & 0xFF);
-        write((v >>>  8) & 0xFF);
-        write((v >>>  0) & 0xFF);
+        writeBuffer[0] = (byte)(v >>> 24);
+        writeBuffer[1] = (byte)(v >>> 16);
+        writeBuffer[2] = (byte)(v >>>  8);
+        writeBuffer[3] = (byte)(v >>>  0);
+        write(writeBuffer, 0, 4);
     }
 
     /**
@@ -181,14 +188,15 @@ class DataOutputStream extends OutputStream implements DataOutput {
      * @exception  IOException  if an I/O error occurs.
      */
     public final void writeLong(long v) throws IOException {
-        write((int)(v >>> 56) & 0xFF);
-        write((int)(v >>> 48) & 0xFF);
-        write((int)(v >>> 40) & 0xFF);
-        write((int)(v >>> 32) & 0xFF);
-        write((int)(v >>> 24) & 0xFF);
-        write((int)(v >>> 16) & 0xFF);
-        write((int)(v >>>  8) & 0xFF);
-        write((int)(v >>>  0) & 0xFF);
+        writeBuffer[0] = (byte)(v >>> 56);
+        writeBuffer[1] = (byte)(v >>> 48);
+        writeBuffer[2] = (byte)(v >>> 40);
+        writeBuffer[3] = (byte)(v >>> 32);
+        writeBuffer[4] = (byte)(v >>> 24);
+        writeBuffer[5] = (byte)(v >>> 16);
+        writeBuffer[6] = (byte)(v >>>  8);
+        writeBuffer[7] = (byte)(v >>>  0);
+        write(writeBuffer, 0, 8);
     }
 
     /**
@@ -274,43 +282,22 @@ class DataOutputStream extends OutputStream implements DataOutput {
      */
     static final int writeUTF(String str, DataOutput out) throws IOException {
         int strlen = str.length();
-        int utflen = 0;
         char[] charr = new char[strlen];
-        int c, count = 0;
 
         str.getChars(0, strlen, charr, 0);
 
-        for (int i = 0; i < strlen; i++) {
-            c = charr[i];
-            if ((c >= 0x0001) && (c <= 0x007F)) {
-                utflen++;
-            } else if (c > 0x07FF) {
-                utflen += 3;
-            } else {
-                utflen += 2;
-            }
-        }
-
+        int utflen = com.sun.cldc.i18n.Helper.modifiedUtf8EncodedLength(charr,
+                                                                        0,
+                                                                        strlen);
         if (utflen > 65535) {
             throw new UTFDataFormatException();
         }
 
         byte[] bytearr = new byte[utflen+2];
-        bytearr[count++] = (byte) ((utflen >>> 8) & 0xFF);
-        bytearr[count++] = (byte) ((utflen >>> 0) & 0xFF);
-        for (int i = 0; i < strlen; i++) {
-            c = charr[i];
-            if ((c >= 0x0001) && (c <= 0x007F)) {
-                bytearr[count++] = (byte) c;
-            } else if (c > 0x07FF) {
-                bytearr[count++] = (byte) (0xE0 | ((c >> 12) & 0x0F));
-                bytearr[count++] = (byte) (0x80 | ((c >>  6) & 0x3F));
-                bytearr[count++] = (byte) (0x80 | ((c >>  0) & 0x3F));
-            } else {
-                bytearr[count++] = (byte) (0xC0 | ((c >>  6) & 0x1F));
-                bytearr[count++] = (byte) (0x80 | ((c >>  0) & 0x3F));
-            }
-        }
+        bytearr[0] = (byte) ((utflen >>> 8) & 0xFF);
+        bytearr[1] = (byte) ((utflen >>> 0) & 0xFF);
+        com.sun.cldc.i18n.Helper.modifiedUtf8Encode(charr, 0, strlen,
+                                                    bytearr, 2);
         out.write(bytearr);
 
         return utflen + 2;
@@ -132,7 +132,7 @@ public final class Double {
      * @return  a string representation of the argument.
      */
     public static String toString(double d){
-        return new FloatingDecimal(d).toJavaFormatString();
+        return FloatingDecimal.doubleToString(d);
     }
 
     /**
@@ -172,7 +172,7 @@ public final class Double {
      *               parsable number.
      */
     public static Double valueOf(String s) throws NumberFormatException {
-        return new Double(FloatingDecimal.readJavaFormatString(s).doubleValue());
+        return new Double(FloatingDecimal.parseDouble(s));
     }
 
     /**
@@ -188,7 +188,7 @@ public final class Double {
      * @since      JDK1.2
      */
     public static double parseDouble(String s) throws NumberFormatException {
-        return FloatingDecimal.readJavaFormatString(s).doubleValue();
+        return FloatingDecimal.parseDouble(s);
     }
 
     /**
@@ -97,12 +97,23 @@ class String {
     /** The count is the number of characters in the String. */
     private int count;
 
+    /**
+     * Compact character storage, used instead of <code>value</code>
+     * when every character of the String is in the range 0 to 255.
+     * Exactly one of <code>value</code> and <code>latin1</code> is
+     * non-null.
+     */
+    private byte latin1[];
+
+    /** Cached hash code, or 0 if it has not been computed yet. */
+    private int hash;
+
     /**
      * Initializes a newly created <code>String</code> object so that it
      * represents an empty character sequence.
      */
     public String() {
-        value = new char[0];
+        latin1 = new byte[0];
     }
 
     /**
@@ -113,9 +124,15 @@ class String {
      * @param   value   a <code>String</code>.
      */
     public String(String value) {
-        count = value.length();
-        this.value = new char[count];
-        value.getChars(0, count, this.value, 0);
+        if (value.latin1 != null) {
+            count = value.count;
+            latin1 = new byte[count];
+            JVM.unchecked_byte_arraycopy(value.latin1, value.offset,
+                                         latin1, 0, count);
+        } else {
+            setChars(value.value, value.offset, value.count);
+        }
+        hash = value.hash;
     }
 
     /**
@@ -129,9 +146,7 @@ class String {
      * @throws NullPointerException if <code>value</code> is <code>null</code>.
      */
     public String(char value[]) {
-        this.count = value.length;
-        this.value = new char[count];
-        JVM.unchecked_char_arraycopy(value, 0, this.value, 0, count);
+        setChars(value, 0, value.length);
     }
 
     /**
@@ -176,9 +191,7 @@ class String {
             );
         }
 
-        this.value = new char[count];
-        this.count = count;
-        JVM.unchecked_char_arraycopy(value, offset, this.value, 0, count);
+        setChars(value, offset, count);
     }
 
     /**
@@ -261,10 +274,22 @@ class String {
      */
     public String (StringBuffer buffer) {
         synchronized(buffer) {
-            buffer.setShared();
-            this.value = buffer.getValue();
+            int len = buffer.length();
+            byte bytes[] = buffer.getLatin1();
+            if (bytes != null) {
+                buffer.setShared();
+                this.latin1 = bytes;
+            } else {
+                bytes = compress(buffer.getValue(), 0, len);
+                if (bytes != null) {
+                    this.latin1 = bytes;
+                } else {
+                    buffer.setShared();
+                    this.value = buffer.getValue();
+                }
+            }
             this.offset = 0;
-            this.count = buffer.length();
+            this.count = len;
         }
     }
 
@@ -275,6 +300,76 @@ class String {
         this.count = count;
     }
 
+    // Package private constructor which shares a Latin-1 array for speed.
+    String(int offset, int count, byte latin1[]) {
+        this.latin1 = latin1;
+        this.offset = offset;
+        this.count = count;
+    }
+
+    /**
+     * Sets the body of this String to a copy of the given characters,
+     * using the compact Latin-1 form if all of them fit.
+     */
+    private void setChars(char chars[], int offset, int count) {
+        this.count = count;
+        this.latin1 = compress(chars, offset, count);
+        if (this.latin1 == null) {
+            this.value = new char[count];
+            JVM.unchecked_char_arraycopy(chars, offset, this.value, 0, count);
+        }
+    }
+
+    /**
+     * Returns a String that takes over <code>buf</code>, or a compact
+     * copy of it if all of its characters fit in Latin-1. The caller
+     * must not modify <code>buf</code> afterwards.
+     */
+    private static String adopt(char buf[], int count) {
+        byte bytes[] = compress(buf, 0, count);
+        return (bytes != null) ? new String(0, count, bytes)
+                               : new String(0, count, buf);
+    }
+
+    /**
+     * Strings of up to this many characters are compared and searched
+     * in Java, where the compiler can inline the loop. Longer ones are
+     * handed to natives that work a word at a time, which only pays off
+     * once the call overhead is amortized.
+     */
+    private static final int SHORT_LENGTH = 16;
+
+    /**
+     * Returns the given characters narrowed to a new byte array, or
+     * <code>null</code> if any of them is greater than 255. The bounds
+     * are not checked. Also used by StringBuffer.
+     */
+    static native byte[] compress(char chars[], int offset, int count);
+
+    /**
+     * Widens <code>count</code> bytes of <code>src</code> into
+     * <code>dst</code>. The bounds are not checked. Also used by
+     * StringBuffer.
+     */
+    static native void inflate(byte src[], int srcOffset,
+                               char dst[], int dstOffset, int count);
+
+    /**
+     * Returns true if this String has the compact Latin-1 body.
+     */
+    final boolean isLatin1() {
+        return latin1 != null;
+    }
+
+    /**
+     * Copies the Latin-1 body of this String into <code>dst</code>,
+     * starting at <code>dstBegin</code>. Must only be called if
+     * isLatin1() is true; the bounds are not checked.
+     */
+    final void copyLatin1(byte dst[], int dstBegin) {
+        JVM.unchecked_byte_arraycopy(latin1, offset, dst, dstBegin, count);
+    }
+
     /**
      * Returns the length of this string.
      * The length is equal to the number of 16-bit
@@ -308,6 +403,10 @@ class String {
 /* #endif */
             );
         }
+        byte b[] = latin1;
+        if (b != null) {
+            return (char)(b[index + offset] & 0xff);
+        }
         return value[index + offset];
     }
 
@@ -364,6 +463,14 @@ class String {
 /* #endif */
             );
         }
+        if (latin1 != null) {
+            int n = srcEnd - srcBegin;
+            if ((dstBegin < 0) || (dstBegin > dst.length - n)) {
+                throw new ArrayIndexOutOfBoundsException();
+            }
+            inflate(latin1, offset + srcBegin, dst, dstBegin, n);
+            return;
+        }
         // NOTE: dst not checked, cannot use unchecked arraycopy
         System.arraycopy(value, offset + srcBegin, dst, dstBegin,
                          srcEnd - srcBegin);
@@ -381,6 +488,9 @@ class String {
      * @since      JDK1.1
      */
     public byte[] getBytes(String enc) throws UnsupportedEncodingException {
+        if (latin1 != null) {
+            return Helper.charToByteArray(toCharArray(), 0, count, enc);
+        }
         return Helper.charToByteArray(value, offset, count, enc);
     }
 
@@ -392,6 +502,9 @@ class String {
      * @since   JDK1.1
      */
     public byte[] getBytes() {
+        if (latin1 != null) {
+            return Helper.charToByteArray(toCharArray(), 0, count);
+        }
         return Helper.charToByteArray(value, offset, count);
     }
 
@@ -408,9 +521,6 @@ class String {
      * @see     java.lang.String#compareTo(java.lang.String)
      * @see     java.lang.String#equalsIgnoreCase(java.lang.String)
      */
-/*
-    public native boolean equals(Object anObject);
-*/
     public boolean equals(Object anObject) {
         if (this == anObject) {
             return true;
@@ -419,12 +529,27 @@ class String {
             String anotherString = (String)anObject;
             int n = count;
             if (n == anotherString.count) {
+                if (n > SHORT_LENGTH) {
+                    return regionEquals(0, anotherString, 0, n);
+                }
+                byte b1[] = latin1;
+                byte b2[] = anotherString.latin1;
                 char v1[] = value;
                 char v2[] = anotherString.value;
                 int i = offset;
                 int j = anotherString.offset;
+                if (b1 != null && b2 != null) {
+                    while (n-- != 0) {
+                        if (b1[i++] != b2[j++]) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
                 while (n-- != 0) {
-                    if (v1[i++] != v2[j++]) {
+                    char c1 = (b1 != null) ? (char)(b1[i++] & 0xff) : v1[i++];
+                    char c2 = (b2 != null) ? (char)(b2[j++] & 0xff) : v2[j++];
+                    if (c1 != c2) {
                         return false;
                     }
                 }
@@ -510,34 +635,32 @@ class String {
         int len1 = count;
         int len2 = anotherString.count;
         int n = Math.min(len1, len2);
+        if (n > SHORT_LENGTH) {
+            return compare(anotherString);
+        }
+        byte b1[] = latin1;
+        byte b2[] = anotherString.latin1;
         char v1[] = value;
         char v2[] = anotherString.value;
         int i = offset;
         int j = anotherString.offset;
 
-        if (i == j) {
-            int k = i;
-            int lim = n + i;
-            while (k < lim) {
-                char c1 = v1[k];
-                char c2 = v2[k];
-                if (c1 != c2) {
-                    return c1 - c2;
-                }
-                k++;
-           }
-        } else {
-            while (n-- != 0) {
-                char c1 = v1[i++];
-                char c2 = v2[j++];
-                if (c1 != c2) {
-                    return c1 - c2;
-                }
+        while (n-- != 0) {
+            char c1 = (b1 != null) ? (char)(b1[i++] & 0xff) : v1[i++];
+            char c2 = (b2 != null) ? (char)(b2[j++] & 0xff) : v2[j++];
+            if (c1 != c2) {
+                return c1 - c2;
             }
         }
         return len1 - len2;
     }
 
+    /**
+     * <code>compareTo</code> for long strings, which compares them a word
+     * at a time.
+     */
+    private native int compare(String anotherString);
+
     /**
      * Tests if two string regions are equal.
      * <p>
@@ -591,9 +714,14 @@ class String {
     public boolean regionMatches(boolean ignoreCase,
                                          int toffset,
                                        String other, int ooffset, int len) {
+        if (!ignoreCase) {
+            return regionEquals(toffset, other, ooffset, len);
+        }
+        byte tb[] = latin1;
         char ta[] = value;
         int to = offset + toffset;
         int tlim = offset + count;
+        byte pb[] = other.latin1;
         char pa[] = other.value;
         int po = other.offset + ooffset;
 
@@ -603,8 +731,8 @@ class String {
             return false;
         }
         while (len-- > 0) {
-            char c1 = ta[to++];
-            char c2 = pa[po++];
+            char c1 = (tb != null) ? (char)(tb[to++] & 0xff) : ta[to++];
+            char c2 = (pb != null) ? (char)(pb[po++] & 0xff) : pa[po++];
             if (c1 == c2)
                 continue;
             if (ignoreCase) {
@@ -628,6 +756,16 @@ class String {
         return true;
     }
 
+    /**
+     * Case-sensitive <code>regionMatches</code>, which compares the
+     * regions a word at a time.
+     *
+     * @exception java.lang.NullPointerException if <code>other</code> is
+     *          <code>null</code>.
+     */
+    private native boolean regionEquals(int toffset, String other,
+                                        int ooffset, int len);
+
     /**
      * Tests if this string starts with the specified prefix beginning
      * at the specified index.
@@ -648,22 +786,7 @@ class String {
      *          <code>null</code>.
      */
     public boolean startsWith(String prefix, int toffset) {
-        char ta[] = value;
-        int to = offset + toffset;
-        int tlim = offset + count;
-        char pa[] = prefix.value;
-        int po = prefix.offset;
-        int pc = prefix.count;
-        // Note: toffset might be near -1>>>1.
-        if ((toffset < 0) || (toffset > count - pc)) {
-            return false;
-        }
-        while (--pc >= 0) {
-            if (ta[to++] != pa[po++]) {
-                return false;
-            }
-        }
-        return true;
+        return regionEquals(toffset, prefix, 0, prefix.count);
     }
 
     /**
@@ -715,7 +838,18 @@ class String {
      *
      * @return  a hash code value for this object.
      */
-    public native int hashCode();
+    public int hashCode() {
+        int h = hash;
+        if (h == 0) {
+            h = computeHash();
+        }
+        return h;
+    }
+
+    /**
+     * Computes the hash code and caches it in <code>hash</code>.
+     */
+    private native int computeHash();
 /*
     public int hashCode() {
         int h = 0;
@@ -911,6 +1045,11 @@ class String {
      *          <code>null</code>
      */
     public int indexOf(String str, int fromIndex) {
+        if (count > SHORT_LENGTH) {
+            return search(str, fromIndex);
+        }
+        byte b1[] = latin1;
+        byte b2[] = str.latin1;
         char v1[] = value;
         char v2[] = str.value;
         int max = offset + (count - str.count);
@@ -930,14 +1069,16 @@ class String {
         }
 
         int strOffset = str.offset;
-        char first  = v2[strOffset];
+        char first  = (b2 != null) ? (char)(b2[strOffset] & 0xff)
+                                   : v2[strOffset];
         int i = offset + fromIndex;
 
     startSearchForFirstChar:
         while (true) {
 
             /* Look for first character. */
-            while (i <= max && v1[i] != first) {
+            while (i <= max &&
+                   ((b1 != null) ? (char)(b1[i] & 0xff) : v1[i]) != first) {
                 i++;
             }
             if (i > max) {
@@ -949,7 +1090,9 @@ class String {
             int end = j + str.count - 1;
             int k = strOffset + 1;
             while (j < end) {
-                if (v1[j++] != v2[k++]) {
+                char c1 = (b1 != null) ? (char)(b1[j++] & 0xff) : v1[j++];
+                char c2 = (b2 != null) ? (char)(b2[k++] & 0xff) : v2[k++];
+                if (c1 != c2) {
                     i++;
                     /* Look for str's first char again. */
                     continue startSearchForFirstChar;
@@ -959,6 +1102,15 @@ class String {
         }
     }
 
+    /**
+     * <code>indexOf(String, int)</code> for long strings, which uses a
+     * word-at-a-time or Boyer-Moore-Horspool search.
+     *
+     * @exception java.lang.NullPointerException if <code>str</code> is
+     *          <code>null</code>
+     */
+    private native int search(String str, int fromIndex);
+
     /**
      * Returns a new string that is a substring of this string. The
      * substring begins with the character at the specified index and
@@ -1024,8 +1176,14 @@ class String {
 /* #endif */
             );
         }
-        return ((beginIndex == 0) && (endIndex == count)) ? this :
-            new String(offset + beginIndex, endIndex - beginIndex, value);
+        if ((beginIndex == 0) && (endIndex == count)) {
+            return this;
+        }
+        if (latin1 != null) {
+            return new String(offset + beginIndex, endIndex - beginIndex,
+                              latin1);
+        }
+        return new String(offset + beginIndex, endIndex - beginIndex, value);
     }
 
     /**
@@ -1055,6 +1213,13 @@ class String {
         if (otherLen == 0) {
             return this;
         }
+        if (latin1 != null && str.latin1 != null) {
+            byte bytes[] = new byte[count + otherLen];
+            JVM.unchecked_byte_arraycopy(latin1, offset, bytes, 0, count);
+            JVM.unchecked_byte_arraycopy(str.latin1, str.offset,
+                                         bytes, count, otherLen);
+            return new String(0, count + otherLen, bytes);
+        }
         char buf[] = new char[count + otherLen];
         getChars(0, count, buf, 0);
         str.getChars(0, otherLen, buf, count);
@@ -1094,25 +1259,26 @@ class String {
         if (oldChar != newChar) {
             int len = count;
             int i = -1;
+            byte[] b = latin1;  /* avoid getfield opcode */
             char[] val = value; /* avoid getfield opcode */
             int off = offset;   /* avoid getfield opcode */
 
             while (++i < len) {
-                if (val[off + i] == oldChar) {
+                char c = (b != null) ? (char)(b[off + i] & 0xff) : val[off + i];
+                if (c == oldChar) {
                     break;
                 }
             }
             if (i < len) {
                 char buf[] = new char[len];
-                for (int j = 0 ; j < i ; j++) {
-                    buf[j] = val[off+j];
-                }
+                getChars(0, i, buf, 0);
                 while (i < len) {
-                    char c = val[off + i];
+                    char c = (b != null) ? (char)(b[off + i] & 0xff)
+                                         : val[off + i];
                     buf[i] = (c == oldChar) ? newChar : c;
                     i++;
                 }
-                return new String(0, len, buf);
+                return adopt(buf, len);
             }
         }
         return this;
@@ -1130,7 +1296,7 @@ class String {
 
         scan : {
             for(i = 0 ; i < count ; i++) {
-                char c = value[offset+i];
+                char c = charAt(i);
                 if (c != Character.toLowerCase(c)) {
                     break scan;
                 }
@@ -1140,12 +1306,12 @@ class String {
 
         char buf[] = new char[count];
 
-        JVM.unchecked_char_arraycopy(value, offset, buf, 0, i);
+        getChars(0, i, buf, 0);
 
         for(; i < count ; i++) {
-            buf[i] = Character.toLowerCase(value[offset+i]);
+            buf[i] = Character.toLowerCase(charAt(i));
         }
-        return new String(0, count, buf);
+        return adopt(buf, count);
     }
 
     /**
@@ -1160,7 +1326,7 @@ class String {
 
         scan : {
             for(i = 0 ; i < count ; i++) {
-                char c = value[offset+i];
+                char c = charAt(i);
                 if (c != Character.toUpperCase(c)) {
                     break scan;
                 }
@@ -1170,12 +1336,12 @@ class String {
 
         char buf[] = new char[count];
 
-        JVM.unchecked_char_arraycopy(value, offset, buf, 0, i);
+        getChars(0, i, buf, 0);
 
         for(; i < count ; i++) {
-            buf[i] = Character.toUpperCase(value[offset+i]);
+            buf[i] = Character.toUpperCase(charAt(i));
         }
-        return new String(0, count, buf);
+        return adopt(buf, count);
     }
 
     /**
@@ -1210,13 +1376,23 @@ class String {
         int len = count;
         int st = 0;
         int off = offset;      /* avoid getfield opcode */
+        byte[] b = latin1;     /* avoid getfield opcode */
         char[] val = value;    /* avoid getfield opcode */
 
-        while ((st < len) && (val[off + st] <= ' ')) {
-            st++;
-        }
-        while ((st < len) && (val[off + len - 1] <= ' ')) {
-            len--;
+        if (b != null) {
+            while ((st < len) && ((b[off + st] & 0xff) <= ' ')) {
+                st++;
+            }
+            while ((st < len) && ((b[off + len - 1] & 0xff) <= ' ')) {
+                len--;
+            }
+        } else {
+            while ((st < len) && (val[off + st] <= ' ')) {
+                st++;
+            }
+            while ((st < len) && (val[off + len - 1] <= ' ')) {
+                len--;
+            }
         }
         return ((st > 0) || (len < count)) ? substring(st, len) : this;
     }
@@ -1319,6 +1495,10 @@ class String {
      *          as its single character the argument <code>c</code>.
      */
     public static String valueOf(char c) {
+        if (c <= 0xff) {
+            byte bytes[] = {(byte)c};
+            return new String(0, 1, bytes);
+        }
         char data[] = {c};
         return new String(0, 1, data);
     }
@@ -91,7 +91,8 @@ import com.sun.cldchi.jvm.JVM;
 public final class StringBuffer {
 
     /**
-     * The value is used for character storage.
+     * The value is used for character storage once the buffer has held
+     * a character greater than 255.
      */
     private char value[];
 
@@ -105,12 +106,26 @@ public final class StringBuffer {
      */
     private boolean shared;
 
+    /**
+     * Compact character storage, used instead of <code>value</code> as
+     * long as every character in the buffer is in the range 0 to 255, so
+     * that toString() can hand it to a Latin-1 String without copying.
+     * Exactly one of <code>value</code> and <code>latin1</code> is
+     * non-null.
+     * <p>
+     * A String shares the storage only up to the <code>count</code> it
+     * was created with, and <code>count</code> never drops below that
+     * without a copy() first. So appending to a shared buffer does not
+     * need a copy; everything that changes the existing characters does.
+     */
+    private byte latin1[];
+
     /**
      * Constructs a string buffer with no characters in it and an 
      * initial capacity of 16 characters. 
      */
     public StringBuffer() {
-        value = new char[16];
+        latin1 = new byte[16];
     }
 
     /**
@@ -122,7 +137,7 @@ public final class StringBuffer {
      *               argument is less than <code>0</code>.
      */
     public StringBuffer(int length) {
-        value = new char[length];
+        latin1 = new byte[length];
     }
 
     /**
@@ -157,7 +172,8 @@ public final class StringBuffer {
      * @return  the current capacity of this string buffer.
      */
     public int capacity() {
-        return value.length;
+        byte b[] = latin1;  /* avoid getfield opcode */
+        return (b != null) ? b.length : value.length;
     }
 
     /**
@@ -165,9 +181,15 @@ public final class StringBuffer {
      * is true.  It should only be called from a synchronized method.
      */
     private final void copy() {
-        char newValue[] = new char[value.length];
-        JVM.unchecked_char_arraycopy(value, 0, newValue, 0, count);
-        value = newValue;
+        if (latin1 != null) {
+            byte newLatin1[] = new byte[latin1.length];
+            JVM.unchecked_byte_arraycopy(latin1, 0, newLatin1, 0, count);
+            latin1 = newLatin1;
+        } else {
+            char newValue[] = new char[value.length];
+            JVM.unchecked_char_arraycopy(value, 0, newValue, 0, count);
+            value = newValue;
+        }
         shared = false;
     }
 
@@ -187,7 +209,7 @@ public final class StringBuffer {
      * @param   minimumCapacity   the minimum desired capacity.
      */
     public synchronized void ensureCapacity(int minimumCapacity) {
-        if (minimumCapacity > value.length) {
+        if (minimumCapacity > capacity()) {
             expandCapacity(minimumCapacity);
         }
     }
@@ -200,16 +222,49 @@ public final class StringBuffer {
      * @see java.lang.StringBuffer#ensureCapacity(int)
      */
     private void expandCapacity(int minimumCapacity) {
-        int newCapacity = (value.length + 1) * 2;
+        int newCapacity = newCapacity(minimumCapacity);
+        if (latin1 != null) {
+            byte newLatin1[] = new byte[newCapacity];
+            JVM.unchecked_byte_arraycopy(latin1, 0, newLatin1, 0, count);
+            latin1 = newLatin1;
+        } else {
+            char newValue[] = new char[newCapacity];
+            JVM.unchecked_char_arraycopy(value, 0, newValue, 0, count);
+            value = newValue;
+        }
+        shared = false;
+    }
+
+    /**
+     * Returns the capacity to grow to for holding at least
+     * <code>minimumCapacity</code> characters, as described in
+     * ensureCapacity().
+     */
+    private int newCapacity(int minimumCapacity) {
+        int newCapacity = (capacity() + 1) * 2;
         if (newCapacity < 0) {
             newCapacity = Integer.MAX_VALUE;
         } else if (minimumCapacity > newCapacity) {
             newCapacity = minimumCapacity;
         }
-        
+        return newCapacity;
+    }
+
+    /**
+     * Moves the characters from the Latin-1 storage to a new UTF-16
+     * value with room for at least <code>minimumCapacity</code>
+     * characters. Called before the first character greater than 255 is
+     * stored.
+     */
+    private void inflate(int minimumCapacity) {
+        int newCapacity = latin1.length;
+        if (minimumCapacity > newCapacity) {
+            newCapacity = newCapacity(minimumCapacity);
+        }
         char newValue[] = new char[newCapacity];
-        JVM.unchecked_char_arraycopy(value, 0, newValue, 0, count);
+        String.inflate(latin1, 0, newValue, 0, count);
         value = newValue;
+        latin1 = null;
         shared = false;
     }
 
@@ -250,24 +305,34 @@ public final class StringBuffer {
             );
         }
         
-        if (newLength > value.length) {
+        if (newLength > capacity()) {
             expandCapacity(newLength);
         }
 
         if (count < newLength) {
-            if (shared) copy();
-            for (; count < newLength; count++) {
-                value[count] = '\0';
+            // Only characters beyond count are written, so a shared
+            // buffer doesn't need to be copied.
+            if (latin1 != null) {
+                for (; count < newLength; count++) {
+                    latin1[count] = 0;
+                }
+            } else {
+                for (; count < newLength; count++) {
+                    value[count] = '\0';
+                }
             }
         } else {
+            int oldCount = count;
             count = newLength;
             if (shared) {
                 if (newLength > 0) {
                     copy();
                 } else {
                     // If newLength is zero, assume the StringBuffer is being
-                    // stripped for reuse; Make new buffer of default size
-                    value = new char[16];
+                    // stripped for reuse; Make a new buffer that can hold
+                    // as much as the string just taken from it.
+                    latin1 = new byte[(oldCount > 16) ? oldCount : 16];
+                    value = null;
                     shared = false;
                 }
             }
@@ -298,6 +363,10 @@ public final class StringBuffer {
 /* #endif */
             );
         }
+        byte b[] = latin1;  /* avoid getfield opcode */
+        if (b != null) {
+            return (char)(b[index] & 0xff);
+        }
         return value[index];
     }
 
@@ -354,6 +423,14 @@ public final class StringBuffer {
 /* #endif */
             );
         }
+        if (latin1 != null) {
+            int n = srcEnd - srcBegin;
+            if ((dstBegin < 0) || (dstBegin > dst.length - n)) {
+                throw new ArrayIndexOutOfBoundsException();
+            }
+            String.inflate(latin1, srcBegin, dst, dstBegin, n);
+            return;
+        }
         // NOTE: dst not checked, cannot use unchecked arraycopy
         System.arraycopy(value, srcBegin, dst, dstBegin, srcEnd - srcBegin);
     }
@@ -382,8 +459,16 @@ public final class StringBuffer {
 /* #endif */
             );
         }
-        if (shared) copy();
-        value[index] = ch;
+        if (latin1 != null && ch > 0xff) {
+            inflate(count);
+        } else if (shared) {
+            copy();
+        }
+        if (latin1 != null) {
+            latin1[index] = (byte)ch;
+        } else {
+            value[index] = ch;
+        }
     }
 
     /**
@@ -430,9 +515,16 @@ public final class StringBuffer {
   
           int len = str.length();
           int newcount = count + len;
-          if (newcount > value.length)
+          if (latin1 != null && !str.isLatin1()) {
+              inflate(newcount);
+          } else if (newcount > capacity()) {
               expandCapacity(newcount);
-          str.getChars(0, len, value, count);
+          }
+          if (latin1 != null) {
+              str.copyLatin1(latin1, count);
+          } else {
+              str.getChars(0, len, value, count);
+          }
           count = newcount;
           return this;
       }
@@ -456,9 +548,20 @@ public final class StringBuffer {
     public synchronized StringBuffer append(char str[]) {
         int len = str.length;
         int newcount = count + len;
-        if (newcount > value.length)
+        byte narrow[] = null;
+        if (latin1 != null) {
+            narrow = String.compress(str, 0, len);
+            if (narrow == null) {
+                inflate(newcount);
+            }
+        }
+        if (newcount > capacity())
             expandCapacity(newcount);
-        JVM.unchecked_char_arraycopy(str, 0, value, count, len);
+        if (narrow != null) {
+            JVM.unchecked_byte_arraycopy(narrow, 0, latin1, count, len);
+        } else {
+            JVM.unchecked_char_arraycopy(str, 0, value, count, len);
+        }
         count = newcount;
         return this;
     }
@@ -484,6 +587,20 @@ public final class StringBuffer {
      */
     public synchronized StringBuffer append(char str[], int offset, int len) {
         int newcount = count + len;
+        if (latin1 != null) {
+            if ((offset < 0) || (len < 0) || (offset > str.length - len)) {
+                throw new ArrayIndexOutOfBoundsException();
+            }
+            byte narrow[] = String.compress(str, offset, len);
+            if (narrow != null) {
+                if (newcount > latin1.length)
+                    expandCapacity(newcount);
+                JVM.unchecked_byte_arraycopy(narrow, 0, latin1, count, len);
+                count = newcount;
+                return this;
+            }
+            inflate(newcount);
+        }
         if (newcount > value.length)
             expandCapacity(newcount);
         // NOTE: str and offset not checked, cannot use unchecked arraycopy
@@ -526,9 +643,16 @@ public final class StringBuffer {
      */
     public synchronized StringBuffer append(char c) {
         int newcount = count + 1;
-        if (newcount > value.length)
+        if (latin1 != null && c > 0xff) {
+            inflate(newcount);
+        } else if (newcount > capacity()) {
             expandCapacity(newcount);
-        value[count++] = c;
+        }
+        if (latin1 != null) {
+            latin1[count++] = (byte)c;
+        } else {
+            value[count++] = c;
+        }
         return this;
     }
 
@@ -633,8 +757,13 @@ public final class StringBuffer {
         if (len > 0) {
             if (shared)
                 copy();
-            JVM.unchecked_char_arraycopy(value, start+len, 
-                                         value, start, count-end);
+            if (latin1 != null) {
+                JVM.unchecked_byte_arraycopy(latin1, start+len,
+                                             latin1, start, count-end);
+            } else {
+                JVM.unchecked_char_arraycopy(value, start+len, 
+                                             value, start, count-end);
+            }
             count -= len;
         }
         return this;
@@ -657,8 +786,13 @@ public final class StringBuffer {
             throw new StringIndexOutOfBoundsException();
         if (shared)
             copy();
-        JVM.unchecked_char_arraycopy(value, index+1, 
-                                     value, index, count-index-1);
+        if (latin1 != null) {
+            JVM.unchecked_byte_arraycopy(latin1, index+1,
+                                         latin1, index, count-index-1);
+        } else {
+            JVM.unchecked_char_arraycopy(value, index+1, 
+                                         value, index, count-index-1);
+        }
         count--;
         return this;
     }
@@ -730,13 +864,21 @@ public final class StringBuffer {
         }
         int len = str.length();
         int newcount = count + len;
-        if (newcount > value.length)
+        if (latin1 != null && !str.isLatin1())
+            inflate(newcount);
+        else if (newcount > capacity())
             expandCapacity(newcount);
         else if (shared)
             copy();
-        JVM.unchecked_char_arraycopy(value, offset, 
-                                     value, offset + len, count - offset);
-        str.getChars(0, len, value, offset);
+        if (latin1 != null) {
+            JVM.unchecked_byte_arraycopy(latin1, offset,
+                                         latin1, offset + len, count - offset);
+            str.copyLatin1(latin1, offset);
+        } else {
+            JVM.unchecked_char_arraycopy(value, offset, 
+                                         value, offset + len, count - offset);
+            str.getChars(0, len, value, offset);
+        }
         count = newcount;
         return this;
     }
@@ -768,13 +910,25 @@ public final class StringBuffer {
         }
         int len = str.length;
         int newcount = count + len;
-        if (newcount > value.length)
+        byte narrow[] = null;
+        if (latin1 != null) {
+            narrow = String.compress(str, 0, len);
+        }
+        if (latin1 != null && narrow == null)
+            inflate(newcount);
+        else if (newcount > capacity())
             expandCapacity(newcount);
         else if (shared)
             copy();
-        JVM.unchecked_char_arraycopy(value, offset, 
-                                     value, offset + len, count - offset);
-        JVM.unchecked_char_arraycopy(str, 0, value, offset, len);
+        if (narrow != null) {
+            JVM.unchecked_byte_arraycopy(latin1, offset,
+                                         latin1, offset + len, count - offset);
+            JVM.unchecked_byte_arraycopy(narrow, 0, latin1, offset, len);
+        } else {
+            JVM.unchecked_char_arraycopy(value, offset, 
+                                         value, offset + len, count - offset);
+            JVM.unchecked_char_arraycopy(str, 0, value, offset, len);
+        }
         count = newcount;
         return this;
     }
@@ -830,13 +984,21 @@ public final class StringBuffer {
      */
     public synchronized StringBuffer insert(int offset, char c) {
         int newcount = count + 1;
-        if (newcount > value.length)
+        if (latin1 != null && c > 0xff)
+            inflate(newcount);
+        else if (newcount > capacity())
             expandCapacity(newcount);
         else if (shared)
             copy();
         // NOTE: offset not checked, cannot use unchecked arraycopy
-        System.arraycopy(value, offset, value, offset + 1, count - offset);
-        value[offset] = c;
+        if (latin1 != null) {
+            System.arraycopy(latin1, offset, latin1, offset + 1,
+                             count - offset);
+            latin1[offset] = (byte)c;
+        } else {
+            System.arraycopy(value, offset, value, offset + 1, count - offset);
+            value[offset] = c;
+        }
         count = newcount;
         return this;
     }
@@ -959,6 +1121,15 @@ public final class StringBuffer {
     public synchronized StringBuffer reverse() {
         if (shared) copy();
         int n = count - 1;
+        if (latin1 != null) {
+            byte b[] = latin1;
+            for (int j = (n-1) >> 1; j >= 0; --j) {
+                byte temp = b[j];
+                b[j] = b[n - j];
+                b[n - j] = temp;
+            }
+            return this;
+        }
         for (int j = (n-1) >> 1; j >= 0; --j) {
             char temp = value[j];
             value[j] = value[n - j];
@@ -990,10 +1161,11 @@ public final class StringBuffer {
         return new String(this);
     }
 
-    // The following two methods are needed by String to efficiently
+    // The following methods are needed by String to efficiently
     // convert a StringBuffer into a String.  They are not public.
     // They shouldn't be called by anyone but String.
     final void setShared() { shared = true; } 
     final char[] getValue() { return value; }
+    final byte[] getLatin1() { return latin1; }
 
 }
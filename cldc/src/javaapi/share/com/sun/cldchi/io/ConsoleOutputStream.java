@@ -29,4 +29,22 @@ package com.sun.cldchi.io;
 public class ConsoleOutputStream extends java.io.OutputStream {
   // makes the JVM print one character on the console
   native public void write(int b) throws java.io.IOException;
+
+  // makes the JVM print len bytes on the console with a single call. The
+  // VM buffers console output and prints it one line at a time, unless
+  // it has been started with -XX:-ConsoleLineBuffered.
+  public void write(byte b[], int off, int len) throws java.io.IOException {
+    if ((off | len | (off + len) | (b.length - (off + len))) < 0) {
+      throw new IndexOutOfBoundsException();
+    }
+    writeBytes(b, off, len);
+  }
+
+  // prints everything written so far
+  public void flush() throws java.io.IOException {
+    flush0();
+  }
+
+  private native void writeBytes(byte b[], int off, int len);
+  private native void flush0();
 }
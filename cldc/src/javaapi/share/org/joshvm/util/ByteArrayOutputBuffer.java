@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) Max Mu
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License version 2 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * Please visit www.joshvm.org if you need additional information or
+ * have any questions.
+ */
+package org.joshvm.util;
+
+import java.io.ByteArrayOutputStream;
+
+/**
+ * A <code>ByteArrayOutputStream</code> whose contents can be taken over
+ * without a copy. <code>toByteArray()</code> always returns a new array,
+ * as its contract requires; <code>detach()</code> hands out the buffer
+ * itself when it is exactly full, and the stream starts over with a new
+ * buffer, so the array is never modified by later writes.
+ */
+public class ByteArrayOutputBuffer extends ByteArrayOutputStream {
+
+    /**
+     * Creates a new buffer with an initial capacity of 32 bytes.
+     */
+    public ByteArrayOutputBuffer() {
+        super();
+    }
+
+    /**
+     * Creates a new buffer with an initial capacity of
+     * <code>size</code> bytes. Writing exactly that many bytes lets
+     * <code>detach()</code> return them without copying.
+     *
+     * @param   size   the initial size.
+     * @exception  IllegalArgumentException if size is negative.
+     */
+    public ByteArrayOutputBuffer(int size) {
+        super(size);
+    }
+
+    /**
+     * Returns the bytes written so far and empties this stream. The
+     * array returned is owned by the caller; it is the internal buffer
+     * itself if that is exactly full, and a trimmed copy otherwise.
+     *
+     * @return  the current contents of this stream.
+     */
+    public synchronized byte[] detach() {
+        byte result[] = buf;
+        if (result.length != count) {
+            result = new byte[count];
+            System.arraycopy(buf, 0, result, 0, count);
+        } else {
+            buf = new byte[32];
+        }
+        count = 0;
+        return result;
+    }
+}
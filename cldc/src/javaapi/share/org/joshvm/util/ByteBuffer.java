@@ -21,7 +21,9 @@
 package org.joshvm.util;
 
 /**
- * A byte-array backed ByteBuffer
+ * A ByteBuffer backed either by a byte array or, for buffers created by
+ * {@link #allocateDirect(int)}, by a block of native memory outside the
+ * Java heap that platform natives can access in place.
  *
  * @author Ferenc Hechler (ferenc@hechler.de)
  * @author Joerg Jahnke (joergjahnke@users.sourceforge.net)
@@ -32,6 +34,10 @@ public final class ByteBuffer {
      * the byte array backing this buffer
      */
     private final byte[] buf;
+    /**
+     * the native memory backing this buffer, null unless direct
+     */
+    private final DirectMemory mem;
     /**
      * offset to the first byte to use
      */
@@ -48,6 +54,10 @@ public final class ByteBuffer {
      * a marker inside the buffer
      */
     private int mrk = -1;
+    /**
+     * byte order of the multi-byte accessors
+     */
+    private boolean bigEndian = true;
 
     /**
      * Create a new ByteBuffer from an existing array
@@ -68,11 +78,111 @@ public final class ByteBuffer {
      */
     public ByteBuffer(final byte[] buf, final int ofs, final int pos, final int siz) {
         this.buf = buf;
+        this.mem = null;
+        this.ofs = ofs;
+        this.pos = pos;
+        this.siz = siz;
+    }
+
+    private ByteBuffer(final DirectMemory mem, final int ofs, final int pos, final int siz) {
+        this.buf = null;
+        this.mem = mem;
         this.ofs = ofs;
         this.pos = pos;
         this.siz = siz;
     }
 
+    /**
+     * Returns the native address of the byte at absolute index i of a
+     * direct buffer, after checking that the n bytes starting there lie
+     * inside its native memory.
+     */
+    private int direct(final int i, final int n) {
+        if (i < 0 || n < 0 || n > mem.capacity - i) {
+            throw new IndexOutOfBoundsException();
+        }
+        return mem.address() + i;
+    }
+
+    private static void checkArray(final byte[] a, final int off, final int len) {
+        if (off < 0 || len < 0 || len > a.length - off) {
+            throw new IndexOutOfBoundsException();
+        }
+    }
+
+    private short getShortAt(final int i) {
+        if (buf == null) {
+            return DirectMemory.getShort(direct(i, 2), bigEndian);
+        }
+        final byte[] buf_ = this.buf;
+        if (bigEndian) {
+            return (short) (((buf_[i] & 0xff) << 8) + (buf_[i + 1] & 0xff));
+        }
+        return (short) (((buf_[i + 1] & 0xff) << 8) + (buf_[i] & 0xff));
+    }
+
+    private int getIntAt(final int i) {
+        if (buf == null) {
+            return DirectMemory.getInt(direct(i, 4), bigEndian);
+        }
+        final byte[] buf_ = this.buf;
+        if (bigEndian) {
+            return ((buf_[i] & 0xff) << 24) + ((buf_[i + 1] & 0xff) << 16) + ((buf_[i + 2] & 0xff) << 8) + (buf_[i + 3] & 0xff);
+        }
+        return ((buf_[i + 3] & 0xff) << 24) + ((buf_[i + 2] & 0xff) << 16) + ((buf_[i + 1] & 0xff) << 8) + (buf_[i] & 0xff);
+    }
+
+    private long getLongAt(final int i) {
+        if (buf == null) {
+            return DirectMemory.getLong(direct(i, 8), bigEndian);
+        }
+        final long first = getIntAt(i);
+        final long second = getIntAt(i + 4);
+        if (bigEndian) {
+            return (first << 32) | (second & 0xffffffffL);
+        }
+        return (second << 32) | (first & 0xffffffffL);
+    }
+
+    private void putShortAt(final int i, final int value) {
+        if (buf == null) {
+            DirectMemory.putShort(direct(i, 2), (short) value, bigEndian);
+            return;
+        }
+        final int hi = bigEndian ? i : i + 1;
+        final int lo = bigEndian ? i + 1 : i;
+        buf[hi] = (byte) ((value >> 8) & 0xff);
+        buf[lo] = (byte) (value & 0xff);
+    }
+
+    private void putIntAt(final int i, final int value) {
+        if (buf == null) {
+            DirectMemory.putInt(direct(i, 4), value, bigEndian);
+            return;
+        }
+        if (bigEndian) {
+            putShortAt(i, value >> 16);
+            putShortAt(i + 2, value);
+        } else {
+            putShortAt(i, value);
+            putShortAt(i + 2, value >> 16);
+        }
+    }
+
+    private void putLongAt(final int i, final long value) {
+        if (buf == null) {
+            DirectMemory.putLong(direct(i, 8), value, bigEndian);
+            return;
+        }
+        if (bigEndian) {
+            putIntAt(i, (int) (value >> 32));
+            putIntAt(i + 4, (int) value);
+        } else {
+            putIntAt(i, (int) value);
+            putIntAt(i + 4, (int) (value >> 32));
+        }
+    }
+
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#position()
      */
@@ -93,6 +203,9 @@ public final class ByteBuffer {
      */
     public byte get() {
         // TODO: check range
+        if (buf == null) {
+            return DirectMemory.getByte(direct(pos++, 1));
+        }
         return buf[pos++];
     }
 
@@ -107,6 +220,9 @@ public final class ByteBuffer {
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#get(int)
      */
     public byte get(final int position) {
+        if (buf == null) {
+            return DirectMemory.getByte(direct(position + ofs, 1));
+        }
         return buf[position + ofs];
     }
 
@@ -114,15 +230,25 @@ public final class ByteBuffer {
         return new ByteBuffer(new byte[size]);
     }
 
-	public static ByteBuffer allocateDirect(final int size) {
-		// TODO: Use native allocate buffer 
-        return allocate(size);
+    /**
+     * Allocates a buffer whose content lives in native memory outside the
+     * Java heap. The memory is zeroed, and is freed once the buffer and
+     * every view created from it have been garbage collected.
+     */
+    public static ByteBuffer allocateDirect(final int size) {
+        if (size < 0) {
+            throw new IllegalArgumentException();
+        }
+        return new ByteBuffer(new DirectMemory(size), 0, 0, size);
     }
 
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#slice()
      */
     public ByteBuffer slice() {
+        if (buf == null) {
+            return new ByteBuffer(mem, pos, pos, siz);
+        }
         return new ByteBuffer(buf, pos, pos, siz);
     }
 
@@ -149,8 +275,7 @@ public final class ByteBuffer {
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#get(byte[])
      */
     public void get(final byte[] outBuf) {
-        System.arraycopy(buf, pos, outBuf, 0, outBuf.length);
-        pos += outBuf.length;
+        get(outBuf, 0, outBuf.length);
     }
 
     /* (non-Javadoc)
@@ -171,13 +296,16 @@ public final class ByteBuffer {
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#hasArray()
      */
     public boolean hasArray() {
-        return true;
+        return buf != null;
     }
 
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#arrayOffset()
      */
     public int arrayOffset() {
+        if (buf == null) {
+            throw new UnsupportedOperationException();
+        }
         return ofs;
     }
 
@@ -185,9 +313,64 @@ public final class ByteBuffer {
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#array()
      */
     public byte[] array() {
+        if (buf == null) {
+            throw new UnsupportedOperationException();
+        }
         return buf;
     }
 
+    /**
+     * Returns the native address of the first byte of this direct buffer
+     * (index 0, not the current position), for platform natives that
+     * access direct buffers in place. The address stays valid as long as
+     * this buffer is reachable.
+     *
+     * @throws UnsupportedOperationException if this buffer is not direct
+     */
+    public int address() {
+        if (mem == null) {
+            throw new UnsupportedOperationException();
+        }
+        return mem.address() + ofs;
+    }
+
+    /**
+     * Returns the native address of the byte at the current position of
+     * this direct buffer, after checking that the remaining() bytes from
+     * there lie inside its native memory. Natives that are handed this
+     * address and remaining() can't reach outside the buffer even if the
+     * position or limit have been set out of range.
+     *
+     * @throws UnsupportedOperationException if this buffer is not direct
+     * @throws IndexOutOfBoundsException if position or limit lie outside
+     *         the buffer
+     */
+    public int positionAddress() {
+        if (mem == null) {
+            throw new UnsupportedOperationException();
+        }
+        if (pos < ofs) {
+            throw new IndexOutOfBoundsException();
+        }
+        return direct(pos, siz - pos);
+    }
+
+    /**
+     * Returns the byte order used by the multi-byte accessors,
+     * BIG_ENDIAN unless changed with {@link #order(ByteOrder)}.
+     */
+    public ByteOrder order() {
+        return bigEndian ? ByteOrder.BIG_ENDIAN : ByteOrder.LITTLE_ENDIAN;
+    }
+
+    /**
+     * Sets the byte order used by the multi-byte accessors.
+     */
+    public ByteBuffer order(final ByteOrder order) {
+        bigEndian = (order != ByteOrder.LITTLE_ENDIAN);
+        return this;
+    }
+
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#flip()
      */
@@ -198,13 +381,16 @@ public final class ByteBuffer {
     }
 
 	public boolean isDirect() {
-		return false;
+		return mem != null;
 	}
 
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#duplicate()
      */
     public ByteBuffer duplicate() {
+        if (buf == null) {
+            return new ByteBuffer(mem, ofs, pos, siz);
+        }
         return new ByteBuffer(buf, ofs, pos, siz);
     }
 
@@ -216,20 +402,26 @@ public final class ByteBuffer {
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#getChar(int)
      */
     public char getChar(final int position) {
-        // TODO: check current byteorder, assume BIG_ENDIAN
-        int result = get(position) & 0xff;
-        result = (result << 8) + (get(position + 1) & 0xff);
-        return (char) result;
+        return (char) getShortAt(position + ofs);
+    }
+
+    public short getShort(final int position) {
+        return getShortAt(position + ofs);
+    }
+
+    public int getInt(final int position) {
+        return getIntAt(position + ofs);
+    }
+
+    public long getLong(final int position) {
+        return getLongAt(position + ofs);
     }
 
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#getInt()
      */
     public int getInt() {
-        // TODO: check current byteorder, assume BIG_ENDIAN
-        final int pos_ = this.pos;
-        final byte[] buf_ = this.buf;
-        final int result = ((buf_[pos_] & 0xff) << 24) + ((buf_[pos_ + 1] & 0xff) << 16) + ((buf_[pos_ + 2] & 0xff) << 8) + (buf_[pos_ + 3] & 0xff);
+        final int result = getIntAt(pos);
 
         this.pos += 4;
 
@@ -240,15 +432,10 @@ public final class ByteBuffer {
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#getLong()
      */
     public long getLong() {
-        // TODO: check current byteorder, assume BIG_ENDIAN
-        long result = get() & 0xff;
-        result = (result << 8) + (get() & 0xff);
-        result = (result << 8) + (get() & 0xff);
-        result = (result << 8) + (get() & 0xff);
-        result = (result << 8) + (get() & 0xff);
-        result = (result << 8) + (get() & 0xff);
-        result = (result << 8) + (get() & 0xff);
-        result = (result << 8) + (get() & 0xff);
+        final long result = getLongAt(pos);
+
+        pos += 8;
+
         return result;
     }
 
@@ -256,27 +443,28 @@ public final class ByteBuffer {
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#getChar()
      */
     public char getChar() {
-        // TODO: check current byteorder, assume BIG_ENDIAN
-        int result = get() & 0xff;
-        result = (result << 8) + (get() & 0xff);
-        return (char) result;
+        return (char) getShort();
     }
 
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#getShort()
      */
     public short getShort() {
-        final int result = ((buf[pos] & 0xff) << 8) + (buf[pos + 1] & 0xff);
+        final short result = getShortAt(pos);
 
         pos += 2;
 
-        return (short)result;
+        return result;
     }
 
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#put(int, byte)
      */
     public void put(final int index, final byte b) {
+        if (buf == null) {
+            DirectMemory.putByte(direct(index + ofs, 1), b);
+            return;
+        }
         buf[index + ofs] = b;
     }
 
@@ -284,6 +472,10 @@ public final class ByteBuffer {
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#put(byte)
      */
     public void put(final byte b) {
+        if (buf == null) {
+            DirectMemory.putByte(direct(pos++, 1), b);
+            return;
+        }
         buf[pos++] = b;
     }
 
@@ -291,18 +483,16 @@ public final class ByteBuffer {
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#putInt(int)
      */
     public void putInt(final int i) {
-        put((byte) ((i >> 24) & 0xff));
-        put((byte) ((i >> 16) & 0xff));
-        put((byte) ((i >> 8) & 0xff));
-        put((byte) (i & 0xff));
+        putIntAt(pos, i);
+        pos += 4;
     }
 
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#putShort(short)
      */
     public void putShort(final short s) {
-        put((byte) ((s >> 8) & 0xff));
-        put((byte) (s & 0xff));
+        putShortAt(pos, s);
+        pos += 2;
     }
 
     /* (non-Javadoc)
@@ -317,7 +507,17 @@ public final class ByteBuffer {
      */
     public void put(final ByteBuffer data) {
         int len = data.remaining();
-        System.arraycopy(data.array(), data.position() + data.arrayOffset(), buf, pos, len);
+        if (data.buf != null) {
+            put(data.buf, data.pos, len);
+            return;
+        }
+        final int from = data.direct(data.pos, len);
+        if (buf == null) {
+            DirectMemory.copy(from, direct(pos, len), len);
+        } else {
+            checkArray(buf, pos, len);
+            DirectMemory.copyToArray(from, buf, pos, len);
+        }
         pos += len;
     }
 
@@ -336,48 +536,64 @@ public final class ByteBuffer {
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#putInt(int, int)
      */
     public void putInt(final int index, final int value) {
-        put(index, (byte) ((value >> 24) & 0xff));
-        put(index + 1, (byte) ((value >> 16) & 0xff));
-        put(index + 2, (byte) ((value >> 8) & 0xff));
-        put(index + 3, (byte) (value & 0xff));
+        putIntAt(index + ofs, value);
+    }
+
+    public void putShort(final int index, final short value) {
+        putShortAt(index + ofs, value);
+    }
+
+    public void putChar(final int index, final char value) {
+        putShortAt(index + ofs, value);
+    }
+
+    public void putLong(final int index, final long value) {
+        putLongAt(index + ofs, value);
     }
 
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#putLong(long)
      */
     public void putLong(final long value) {
-        put((byte) ((value >> 56) & 0xff));
-        put((byte) ((value >> 48) & 0xff));
-        put((byte) ((value >> 40) & 0xff));
-        put((byte) ((value >> 32) & 0xff));
-        put((byte) ((value >> 24) & 0xff));
-        put((byte) ((value >> 16) & 0xff));
-        put((byte) ((value >> 8) & 0xff));
-        put((byte) (value & 0xff));
+        putLongAt(pos, value);
+        pos += 8;
     }
 
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#putChar(char)
      */
     public void putChar(final char value) {
-        put((byte) ((value >> 8) & 0xff));
-        put((byte) (value & 0xff));
+        putShortAt(pos, value);
+        pos += 2;
     }
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#put(byte[])
      */
 
     public void put(final byte[] data) {
-        int len = data.length;
-        System.arraycopy(data, 0, buf, pos, len);
-        pos += len;
+        put(data, 0, data.length);
+    }
+
+    public void put(final byte[] data, final int offset, final int length) {
+        if (buf == null) {
+            checkArray(data, offset, length);
+            DirectMemory.copyFromArray(data, offset, direct(pos, length), length);
+        } else {
+            System.arraycopy(data, offset, buf, pos, length);
+        }
+        pos += length;
     }
 
     /* (non-Javadoc)
      * @see net.sf.andpdf.pdfviewer.ByteBuffer#get(byte[], int, int)
      */
     public void get(final byte[] outBuf, final int outOffset, final int length) {
-        System.arraycopy(buf, pos, outBuf, outOffset, length);
+        if (buf == null) {
+            checkArray(outBuf, outOffset, length);
+            DirectMemory.copyToArray(direct(pos, length), outBuf, outOffset, length);
+        } else {
+            System.arraycopy(buf, pos, outBuf, outOffset, length);
+        }
         pos += length;
     }
 
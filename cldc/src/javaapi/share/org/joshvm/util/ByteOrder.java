@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) Max Mu
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License version 2 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * Please visit www.joshvm.org if you need additional information or
+ * have any questions.
+ */
+package org.joshvm.util;
+
+/**
+ * A typesafe enumeration for byte orders, as in java.nio.ByteOrder.
+ */
+public final class ByteOrder {
+
+    private final String name;
+
+    private ByteOrder(final String name) {
+        this.name = name;
+    }
+
+    /**
+     * Most-significant byte first.
+     */
+    public static final ByteOrder BIG_ENDIAN = new ByteOrder("BIG_ENDIAN");
+
+    /**
+     * Least-significant byte first.
+     */
+    public static final ByteOrder LITTLE_ENDIAN = new ByteOrder("LITTLE_ENDIAN");
+
+    /**
+     * Returns the native byte order of the underlying platform.
+     */
+    public static ByteOrder nativeOrder() {
+        return DirectMemory.isBigEndian0() ? BIG_ENDIAN : LITTLE_ENDIAN;
+    }
+
+    public String toString() {
+        return name;
+    }
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) Max Mu
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License version 2 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * Please visit www.joshvm.org if you need additional information or
+ * have any questions.
+ */
+package org.joshvm.util;
+
+import java.io.DataInput;
+import java.io.DataOutput;
+import java.io.IOException;
+
+/**
+ * Reads and writes arrays of primitive values in a chosen byte order,
+ * converting up to 512 bytes at a time and handing each chunk to the
+ * stream with a single call.
+ * <p>
+ * Doubles are not supported, because soft-float ports store them
+ * word-swapped.
+ */
+public final class DataArrays {
+
+    /**
+     * Maximum number of bytes converted at a time.
+     */
+    private static final int CHUNK = 512;
+
+    private DataArrays() {
+    }
+
+    /**
+     * Writes <code>len</code> elements of a <code>short</code> array, two
+     * bytes each, in the given byte order.
+     *
+     * @param      out     the stream to write to.
+     * @param      v       the data.
+     * @param      off     the start offset in the data.
+     * @param      len     the number of elements to write.
+     * @param      order   the byte order of each element.
+     * @exception  IOException  if an I/O error occurs.
+     */
+    public static void writeShorts(DataOutput out, short v[], int off,
+                                   int len, ByteOrder order)
+        throws IOException {
+        write(out, v, v.length, off, len, 2, order);
+    }
+
+    /**
+     * Writes <code>len</code> elements of an <code>int</code> array, four
+     * bytes each, in the given byte order.
+     *
+     * @param      out     the stream to write to.
+     * @param      v       the data.
+     * @param      off     the start offset in the data.
+     * @param      len     the number of elements to write.
+     * @param      order   the byte order of each element.
+     * @exception  IOException  if an I/O error occurs.
+     */
+    public static void writeInts(DataOutput out, int v[], int off, int len,
+                                 ByteOrder order) throws IOException {
+        write(out, v, v.length, off, len, 4, order);
+    }
+
+    /**
+     * Writes <code>len</code> elements of a <code>float</code> array, in
+     * the format of <code>DataOutput.writeFloat</code> but in the given
+     * byte order.
+     *
+     * @param      out     the stream to write to.
+     * @param      v       the data.
+     * @param      off     the start offset in the data.
+     * @param      len     the number of elements to write.
+     * @param      order   the byte order of each element.
+     * @exception  IOException  if an I/O error occurs.
+     */
+    public static void writeFloats(DataOutput out, float v[], int off,
+                                   int len, ByteOrder order)
+        throws IOException {
+        write(out, v, v.length, off, len, 4, order);
+    }
+
+    /**
+     * Reads <code>len</code> <code>short</code> values, two bytes each in
+     * the given byte order, into an array.
+     *
+     * @param      in      the stream to read from.
+     * @param      v       the buffer into which the data is read.
+     * @param      off     the start offset in the buffer.
+     * @param      len     the number of elements to read.
+     * @param      order   the byte order of each element.
+     * @exception  EOFException  if the stream reaches the end before
+     *               reading all the bytes.
+     * @exception  IOException   if an I/O error occurs.
+     */
+    public static void readShorts(DataInput in, short v[], int off, int len,
+                                  ByteOrder order) throws IOException {
+        read(in, v, v.length, off, len, 2, order);
+    }
+
+    /**
+     * Reads <code>len</code> <code>int</code> values, four bytes each in
+     * the given byte order, into an array.
+     *
+     * @param      in      the stream to read from.
+     * @param      v       the buffer into which the data is read.
+     * @param      off     the start offset in the buffer.
+     * @param      len     the number of elements to read.
+     * @param      order   the byte order of each element.
+     * @exception  EOFException  if the stream reaches the end before
+     *               reading all the bytes.
+     * @exception  IOException   if an I/O error occurs.
+     */
+    public static void readInts(DataInput in, int v[], int off, int len,
+                                ByteOrder order) throws IOException {
+        read(in, v, v.length, off, len, 4, order);
+    }
+
+    /**
+     * Reads <code>len</code> <code>float</code> values, in the format of
+     * <code>DataInput.readFloat</code> but in the given byte order, into
+     * an array.
+     *
+     * @param      in      the stream to read from.
+     * @param      v       the buffer into which the data is read.
+     * @param      off     the start offset in the buffer.
+     * @param      len     the number of elements to read.
+     * @param      order   the byte order of each element.
+     * @exception  EOFException  if the stream reaches the end before
+     *               reading all the bytes.
+     * @exception  IOException   if an I/O error occurs.
+     */
+    public static void readFloats(DataInput in, float v[], int off, int len,
+                                  ByteOrder order) throws IOException {
+        read(in, v, v.length, off, len, 4, order);
+    }
+
+    private static void write(DataOutput out, Object v, int length, int off,
+                              int len, int size, ByteOrder order)
+        throws IOException {
+        if (off < 0 || len < 0 || len > length - off) {
+            throw new IndexOutOfBoundsException();
+        }
+        boolean bigEndian = (order != ByteOrder.LITTLE_ENDIAN);
+        int perChunk = CHUNK / size;
+        byte chunk[] = new byte[Math.min(len, perChunk) * size];
+        while (len > 0) {
+            int n = Math.min(len, perChunk);
+            pack(v, off, size, chunk, n, bigEndian);
+            out.write(chunk, 0, n * size);
+            off += n;
+            len -= n;
+        }
+    }
+
+    private static void read(DataInput in, Object v, int length, int off,
+                             int len, int size, ByteOrder order)
+        throws IOException {
+        if (off < 0 || len < 0 || len > length - off) {
+            throw new IndexOutOfBoundsException();
+        }
+        boolean bigEndian = (order != ByteOrder.LITTLE_ENDIAN);
+        int perChunk = CHUNK / size;
+        byte chunk[] = new byte[Math.min(len, perChunk) * size];
+        while (len > 0) {
+            int n = Math.min(len, perChunk);
+            in.readFully(chunk, 0, n * size);
+            unpack(chunk, v, off, size, n, bigEndian);
+            off += n;
+            len -= n;
+        }
+    }
+
+    /**
+     * Stores <code>count</code> elements of <code>size</code> bytes of the
+     * primitive array <code>src</code>, starting at <code>srcOff</code>,
+     * into the start of <code>dst</code> in the given byte order.
+     */
+    private static native void pack(Object src, int srcOff, int size,
+                                    byte dst[], int count,
+                                    boolean bigEndian);
+
+    /**
+     * Loads <code>count</code> elements of <code>size</code> bytes, stored
+     * at the start of <code>src</code> in the given byte order, into the
+     * primitive array <code>dst</code> starting at <code>dstOff</code>.
+     */
+    private static native void unpack(byte src[], Object dst, int dstOff,
+                                      int size, int count,
+                                      boolean bigEndian);
+}
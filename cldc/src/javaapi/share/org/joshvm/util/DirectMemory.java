@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) Max Mu
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License version 2 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * Please visit www.joshvm.org if you need additional information or
+ * have any questions.
+ */
+package org.joshvm.util;
+
+/**
+ * A block of native memory outside the Java heap, used as the storage
+ * of direct ByteBuffers. The block is freed by the native finalizer
+ * once no buffer refers to this object any more.
+ *
+ * None of the accessors check their arguments; ByteBuffer does that.
+ */
+final class DirectMemory {
+    /**
+     * native address of the block, 0 once it has been freed.
+     * Accessed by name from the native finalizer.
+     */
+    private int address;
+    /**
+     * size of the block in bytes
+     */
+    final int capacity;
+
+    DirectMemory(final int capacity) {
+        this.address = allocate0(capacity);
+        this.capacity = capacity;
+    }
+
+    int address() {
+        return address;
+    }
+
+    private static native int allocate0(int size);
+    private native void finalize();
+
+    static native boolean isBigEndian0();
+
+    static native byte getByte(int address);
+    static native void putByte(int address, byte value);
+    static native short getShort(int address, boolean bigEndian);
+    static native void putShort(int address, short value, boolean bigEndian);
+    static native int getInt(int address, boolean bigEndian);
+    static native void putInt(int address, int value, boolean bigEndian);
+    static native long getLong(int address, boolean bigEndian);
+    static native void putLong(int address, long value, boolean bigEndian);
+
+    static native void copyToArray(int address, byte[] dst, int offset, int length);
+    static native void copyFromArray(byte[] src, int offset, int address, int length);
+    static native void copy(int src, int dst, int length);
+}
@@ -201,6 +201,25 @@ public class CLDC_HI_NativesWriter
         return (!formatError) && (! out.checkError());
     }
     
+    /**
+     * In a class that may store its characters in a Latin-1 byte[] body,
+     * the hand-written String entries handle only some cases themselves
+     * and bail out to the interpreter for the rest. That includes methods
+     * which are native in this class library, so those need their native
+     * implementation registered as well.
+     */
+    static boolean hasLatin1Body(EVMClass cc) {
+        FieldInfo fields[] = cc.ci.fields;
+        if (fields != null) {
+            for (int i=0; i<fields.length; i++) {
+                if (fields[i].name.string.equals("latin1")) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
     int checkEntry(EVMClass cc, MethodInfo mi) {
         for (int i=0; i<use_entries.length; i++) {
             if (cc.ci.className.equals(use_entries[i][0]) &&
@@ -216,10 +235,18 @@ public class CLDC_HI_NativesWriter
         return -1;
     }
 
+    boolean isAlsoNative(EVMClass cc, MethodInfo mi, int entry) {
+        if (use_entries[entry].length > 4) {
+            return true;
+        }
+        return (mi.access & Const.ACC_NATIVE) != 0 &&
+               cc.ci.className.equals(STRING) && hasLatin1Body(cc);
+    }
+
     boolean isNativeFunc(EVMClass cc, MethodInfo mi) {
         int entry;
         entry = checkEntry(cc, mi);
-        if (entry < 0 || use_entries[entry].length > 4) {
+        if (entry < 0 || isAlsoNative(cc, mi, entry)) {
             return true;
         } else {
             return false;
@@ -311,7 +338,7 @@ public class CLDC_HI_NativesWriter
                 }
                 int entry;
                 entry = checkEntry(cc, mi);
-                if (entry < 0 || use_entries[entry].length > 4) {
+                if (entry < 0 || isAlsoNative(cc, mi, entry)) {
                     // This is a "native"
                     out.println("extern \"C\" " + mi.getJNIReturnType() + " " +
                                 mi.getNativeName(true) + "();");
@@ -437,6 +464,9 @@ public class CLDC_HI_NativesWriter
         out.println("  JVM_TABLE((char*)0, (JvmNativeFunction*)0, " +
                     "(JvmNativeFunction*)0)");
         out.println("};");
+        out.println();
+
+        writeNativesHash(nativeClasses);
 
 
         // (4) Write the jvm_native_execution_top-level table
@@ -461,6 +491,157 @@ public class CLDC_HI_NativesWriter
         out.println("{(unsigned char*)0, (char*)0}};");
     }
 
+    /*
+     * The hash function used by the VM to look up jvm_natives_table[]
+     * (see Natives::find_natives_table()). This is FNV-1a, with the seed
+     * mixed into the initial value.
+     */
+    static int nativesHash(byte name[], int seed) {
+        int h = 0x811c9dc5 ^ seed;
+        for (int i = 0; i < name.length; i++) {
+            h = (h ^ (name[i] & 0xff)) * 16777619;
+        }
+        return h;
+    }
+
+    static int powerOfTwo(int n) {
+        int size = 1;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    /*
+     * Write jvm_natives_hash, a perfect hash of the class names in
+     * jvm_natives_table[], so that the VM finds the natives of a class
+     * without comparing its name against every entry of the table.
+     *
+     * The names are first distributed into buckets by nativesHash(name, 0).
+     * Each bucket then gets a seed, such that nativesHash(name, seed) maps
+     * the names of the bucket to distinct slots that are not yet used by
+     * other buckets. The largest buckets are placed first.
+     */
+    protected void writeNativesHash(Vector nativeClasses) {
+        int count = nativeClasses.size();
+        byte names[][] = new byte[count][];
+        for (int i = 0; i < count; i++) {
+            EVMClass cc = (EVMClass)nativeClasses.elementAt(i);
+            try {
+                names[i] = cc.ci.className.getBytes("UTF-8");
+            } catch (java.io.UnsupportedEncodingException e) {
+                throw new RuntimeException(e.toString());
+            }
+        }
+
+        int bucketCount = powerOfTwo(Math.max(1, count / 2));
+        int slotCount = powerOfTwo(Math.max(1, count * 2));
+        int seeds[];
+        int slots[];
+
+        while (true) {
+            seeds = new int[bucketCount];
+            slots = new int[slotCount];
+            if (placeNativesHash(names, seeds, slots)) {
+                break;
+            }
+            slotCount <<= 1;
+        }
+
+        out.println("static const unsigned short jvm_natives_hash_seeds[] = {");
+        for (int i = 0; i < bucketCount; i++) {
+            out.println("  " + seeds[i] + ",");
+        }
+        out.println("};");
+        out.println();
+
+        out.println("static const short jvm_natives_hash_slots[] = {");
+        for (int i = 0; i < slotCount; i++) {
+            out.println("  " + (slots[i] - 1) + ",");
+        }
+        out.println("};");
+        out.println();
+
+        out.println("const JvmNativesHash jvm_natives_hash = {");
+        out.println("  " + bucketCount + ", " + slotCount + ",");
+        out.println("  jvm_natives_hash_seeds, jvm_natives_hash_slots");
+        out.println("};");
+        out.println();
+    }
+
+    /*
+     * Try to place all names into <slots>. The slots hold the index of
+     * the name + 1, or 0 if unused. Returns false if some bucket doesn't
+     * fit with any seed.
+     */
+    boolean placeNativesHash(byte names[][], int seeds[], int slots[]) {
+        int bucketMask = seeds.length - 1;
+        int slotMask = slots.length - 1;
+        final int bucketSize[] = new int[seeds.length];
+        Vector buckets[] = new Vector[seeds.length];
+        for (int b = 0; b < buckets.length; b++) {
+            buckets[b] = new Vector();
+        }
+        for (int i = 0; i < names.length; i++) {
+            int b = nativesHash(names[i], 0) & bucketMask;
+            buckets[b].addElement(new Integer(i));
+            bucketSize[b] ++;
+        }
+
+        ArrayList order = new ArrayList();
+        for (int b = 0; b < buckets.length; b++) {
+            order.add(new Integer(b));
+        }
+        Collections.sort(order, new Comparator() {
+            public int compare(Object o1, Object o2) {
+                int b1 = ((Integer)o1).intValue();
+                int b2 = ((Integer)o2).intValue();
+                if (bucketSize[b1] != bucketSize[b2]) {
+                    return bucketSize[b2] - bucketSize[b1];
+                }
+                return b1 - b2;
+            }
+        });
+
+        int positions[] = new int[names.length];
+        for (int n = 0; n < order.size(); n++) {
+            int b = ((Integer)order.get(n)).intValue();
+            Vector bucket = buckets[b];
+            if (bucket.size() == 0) {
+                break;
+            }
+            int seed;
+            for (seed = 1; seed <= 0xffff; seed++) {
+                boolean fits = true;
+                for (int k = 0; k < bucket.size() && fits; k++) {
+                    int i = ((Integer)bucket.elementAt(k)).intValue();
+                    int pos = nativesHash(names[i], seed) & slotMask;
+                    if (slots[pos] != 0) {
+                        fits = false;
+                    }
+                    for (int j = 0; j < k && fits; j++) {
+                        if (positions[j] == pos) {
+                            fits = false;
+                        }
+                    }
+                    positions[k] = pos;
+                }
+                if (fits) {
+                    break;
+                }
+            }
+            if (seed > 0xffff) {
+                return false;
+            }
+            seeds[b] = seed;
+            for (int k = 0; k < bucket.size(); k++) {
+                int i = ((Integer)bucket.elementAt(k)).intValue();
+                slots[positions[k]] = i + 1;
+            }
+        }
+        return true;
+    }
+
     String pad(String str, int width) {
         int len = str.length();
         if (len < width) {
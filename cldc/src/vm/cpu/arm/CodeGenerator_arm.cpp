@@ -2130,6 +2130,45 @@ void CodeGenerator::double_unary_do(Value& result, Value& op1,
 #endif
 }
 
+bool CodeGenerator::double_math_do(Value& result, Value& op1,
+                                   BytecodeClosure::math_op op JVM_TRAPS) {
+  JVM_IGNORE_TRAPS;
+  typedef JVM_SOFTFP_LINKAGE double (*runtime_func_type)(double);
+
+  static const runtime_func_type funcs[] = {
+    /* math_sqrt  = 0 */ jvm_sqrt,
+    /* math_floor = 1 */ jvm_floor,
+    /* math_ceil  = 2 */ jvm_ceil,
+  };
+
+  GUARANTEE(int(op) >= int(BytecodeClosure::math_sqrt) &&
+            int(op) <= int(BytecodeClosure::math_ceil), "sanity");
+
+#if ENABLE_ARM_VFP
+  // fsqrtd is correctly rounded, but in RunFast mode it would flush
+  // denormals to zero, and unlike the arithmetic bytecodes there is no
+  // redo routine for it.
+  if (op == BytecodeClosure::math_sqrt
+#if ENABLE_SOFT_FLOAT
+      && !RunFastMode
+#endif
+      ) {
+    write_literals_if_desperate();
+    GUARANTEE(op1.in_register(), "op1 must be in a register");
+
+    ensure_in_float_register(op1);
+    assign_register(result, op1);
+    fsqrtd(result.lo_register(), op1.lo_register());
+    return true;
+  }
+#endif
+
+  // Calling the C function directly is still much cheaper than invoking
+  // the native method.
+  call_simple_c_runtime(result, (address)funcs[op], op1);
+  return true;
+}
+
 void CodeGenerator::double_cmp(Value& result, BytecodeClosure::cond_op cond,
                                Value& op1, Value& op2 JVM_TRAPS) {
   JVM_IGNORE_TRAPS;
@@ -197,14 +197,31 @@ void NativeGenerator::generate_native_string_entries() {
     comment("r%d = offset", offset);
     ldr(offset, imm_index(string, String::offset_offset()));
 
+#if ENABLE_CLDC_111
+    Register latin1     = tmp5;
+    comment("r%d = latin1", latin1);
+    ldr(latin1, imm_index(string, String::latin1_offset()));
+#endif
+
     comment("if ((unsigned int) index >= (unsigned int) count) goto bailout;");
     cmp(index, reg(count));
     b(bailout, hs);
 
-    comment("return: r%d = array[index + offset]", tos_val);
     add(index, index, reg(offset));
+#if ENABLE_CLDC_111
+    comment("return: r%d = (latin1 != null) ? latin1[index + offset]",
+            tos_val);
+    comment("                  : array[index + offset]");
+    cmp(latin1, zero);
+    add(latin1, latin1, reg(index), ne);
+    ldrb(tos_val, imm_index(latin1, Array::base_offset()), ne);
+    add(array, array, imm_shift(index, lsl, 1), eq);
+    ldrh(tos_val, imm_index3(array, Array::base_offset()), eq);
+#else
+    comment("return: r%d = array[index + offset]", tos_val);
     add(array, array, imm_shift(index, lsl, 1));
     ldrh(tos_val, imm_index3(array, Array::base_offset()));
+#endif
     set_return_type(T_INT);
 
     comment("remove arguments from the stack");
@@ -233,7 +250,14 @@ void NativeGenerator::generate_native_string_entries() {
 
     const int value_field_offset = Instance::header_size();
     const int count_field_offset = value_field_offset + sizeof(jobject);
+#if ENABLE_CLDC_111
+    // StringBuffer.latin1 is declared after shared, but word-sized fields
+    // are laid out first.
+    const int latin1_field_offset = count_field_offset + sizeof(jint);
+    const int shared_field_offset = latin1_field_offset + sizeof(jobject);
+#else
     const int shared_field_offset = count_field_offset + sizeof(jint);
+#endif
 
     Label bailout;
 
@@ -247,6 +271,16 @@ void NativeGenerator::generate_native_string_entries() {
     tst(string, reg(buffer));
     b(bailout, eq);
 
+#if ENABLE_CLDC_111
+    comment("Only a Latin-1 buffer is shared as it is, the Java code");
+    comment("compresses a UTF-16 one when it can");
+    Register buffer_latin1 = buffer_value;
+    ldr(buffer_near,   imm_index(buffer, Oop::klass_offset()));
+    ldr(buffer_latin1, imm_index(buffer, latin1_field_offset));
+    ldr(buffer_count,  imm_index(buffer, count_field_offset));
+    cmp(buffer_latin1, zero);
+    b(bailout, eq);
+#else
     if (Oop::klass_offset() == 0 && 
         Instance::header_size() == BytesPerWord) {
 
@@ -259,6 +293,7 @@ void NativeGenerator::generate_native_string_entries() {
       ldr(buffer_value, imm_index(buffer, value_field_offset));
       ldr(buffer_count, imm_index(buffer, count_field_offset));
     }
+#endif
 
     ldr(buffer_lock,  imm_index(buffer_near, JavaNear::raw_value_offset()));
     mov(buffer_shared, one); 
@@ -270,6 +305,13 @@ void NativeGenerator::generate_native_string_entries() {
     comment("Note: r%d is zero at this point", buffer_offset);
     strb(buffer_shared, imm_index(buffer, shared_field_offset));
 
+#if ENABLE_CLDC_111
+    eol_comment("value = null");
+    str(buffer_offset,  imm_index(string, String::value_offset()));
+    str(buffer_offset,  imm_index(string, String::offset_offset()));
+    str(buffer_count,   imm_index(string, String::count_offset()));
+    str(buffer_latin1,  imm_index(string, String::latin1_offset()));
+#else
     if (String::value_offset()  == BytesPerWord &&
         String::offset_offset() == String::value_offset() + BytesPerWord &&
         String::count_offset()  == String::offset_offset() + BytesPerWord) {
@@ -282,6 +324,7 @@ void NativeGenerator::generate_native_string_entries() {
       str(buffer_offset,  imm_index(string, String::offset_offset()));
       str(buffer_count,   imm_index(string, String::count_offset()));
     }
+#endif
 
     set_return_type(T_VOID);
     jmpx(lr);
@@ -300,6 +343,9 @@ void NativeGenerator::generate_native_string_entries() {
     Label aligned, unaligned;
     Label small_string, error;
     Label done_true, done_false;
+#if ENABLE_CLDC_111
+    Label latin1_body, latin1_loop;
+#endif
     // java.lang.String.equals
     // Method boolean equals(java.lang.String)
     bind_rom_linkable("native_string_equals_entry");
@@ -370,6 +416,17 @@ void NativeGenerator::generate_native_string_entries() {
 
     b(done_false, ne);
 
+#if ENABLE_CLDC_111
+    comment("Get str0.latin1[], str1.latin1[]");
+    ldr(str0_charp, imm_index(str0, String::latin1_offset()));
+    ldr(str1_charp, imm_index(str1, String::latin1_offset()));
+    cmp(str0_charp, zero);
+    b(latin1_body, ne);
+    comment("UTF-16 receiver, Latin-1 argument: leave it to the native");
+    cmp(str1_charp, zero);
+    b(error, ne);
+#endif
+
     comment("Get str0.value[], str1.value[]");
     ldr(str0_charp, imm_index(str0, String::value_offset()));
     ldr(str1_charp, imm_index(str1, String::value_offset()));
@@ -476,6 +533,36 @@ void NativeGenerator::generate_native_string_entries() {
     comment("continue in caller");
     jmpx(lr);
 
+#if ENABLE_CLDC_111
+  bind(latin1_body);
+    comment("Latin-1 receiver, UTF-16 argument: leave it to the native");
+    cmp(str1_charp, zero);
+    b(error, eq);
+
+    comment("Get str0.offset, str1.offset");
+    ldr(offset0, imm_index(str0, String::offset_offset()));
+    ldr(offset1, imm_index(str1, String::offset_offset()));
+
+    comment("Compute start of character data");
+    add(str0_charp, str0_charp, imm(Array::base_offset()));
+    add(str1_charp, str1_charp, imm(Array::base_offset()));
+    add(str0_charp, str0_charp, reg(offset0));
+    add(str1_charp, str1_charp, reg(offset1));
+
+    comment("Empty string?");
+    cmp(str0_count, zero);
+    b(done_true, eq);
+
+  bind(latin1_loop);
+    ldrb(value0, imm_index(str0_charp, 1, post_indexed));
+    ldrb(value1, imm_index(str1_charp, 1, post_indexed));
+    cmp(value0, reg(value1));
+    b(done_false, ne);
+    sub(str0_count, str0_count, one, set_CC);
+    b(latin1_loop, ne);
+    b(done_true);
+#endif
+
   bind(error);
     comment("We have some sort of error");
     push(tmp0);
@@ -532,7 +619,20 @@ void NativeGenerator::generate_native_string_entries() {
     
     comment("Neither receiver nor str are null?");
     tst(str0, reg(str1));
+#if ENABLE_CLDC_111
+    Label indexof0_bailout;
+    b(indexof0_bailout, eq);
+
+    comment("Neither receiver nor str has a Latin-1 body?");
+    ldr(str0_count, imm_index(str0, String::latin1_offset()));
+    ldr(str1_count, imm_index(str1, String::latin1_offset()));
+    orr(str0_count, str0_count, reg(str1_count), set_CC);
+    b(native_string_indexof0_string_continue, eq);
+
+  bind(indexof0_bailout);
+#else
     b(native_string_indexof0_string_continue, ne);
+#endif
 
     comment("Bailout to interpreter");
     push(indexof0_args);
@@ -553,6 +653,14 @@ void NativeGenerator::generate_native_string_entries() {
     comment("Receiver or str are null?");
     tst(str0, reg(str1));
     b(bailout, eq);
+
+#if ENABLE_CLDC_111
+    comment("Receiver or str has a Latin-1 body?");
+    ldr(str0_count, imm_index(str0, String::latin1_offset()));
+    ldr(str1_count, imm_index(str1, String::latin1_offset()));
+    orr(str0_count, str0_count, reg(str1_count), set_CC);
+    b(bailout, ne);
+#endif
     
   bind(native_string_indexof0_string_continue);
     
@@ -731,6 +839,9 @@ void NativeGenerator::generate_native_string_entries() {
     b(native_string_indexof_continue);
 
     Label loop, test, failure, success;
+#if ENABLE_CLDC_111
+    Label latin1_body, latin1_loop, latin1_success;
+#endif
     bind_rom_linkable("native_string_indexof0_entry");
 
     comment("[[[Hand coded method from java.lang.String]]]");
@@ -781,6 +892,12 @@ void NativeGenerator::generate_native_string_entries() {
     cmp(from_index, reg(tmp4));   // if (fromIndex >= count) goto Failure
     b(failure, ge);
 
+#if ENABLE_CLDC_111
+    ldr(tmp5,    imm_index(string, String::latin1_offset())); // latin1
+    cmp(tmp5, zero);
+    b(latin1_body, ne);
+#endif
+
     add_imm(array, array, Array::base_offset());
     add(array, array, imm_shift(tmp2, lsl, 1));   // array -> s.charAt(0);
     add(max,   array, imm_shift(tmp4, lsl, 1));   // max -> s.charAt(count)
@@ -819,6 +936,35 @@ void NativeGenerator::generate_native_string_entries() {
     set_return_type(T_INT);
     comment("continue in caller");
     jmpx(lr);
+
+#if ENABLE_CLDC_111
+  bind(latin1_body);
+    comment("Latin-1 body: one byte per char, so ch > 0xFF is not found");
+    cmp(ch, imm(0xFF));
+    b(failure, hi);
+
+    add_imm(tmp5, tmp5, Array::base_offset());
+    add(tmp5, tmp5, reg(tmp2));       // tmp5 -> s.charAt(0);
+    add(max,  tmp5, reg(tmp4));       // max -> s.charAt(count)
+    mov(tmp4, reg(tmp5));
+    add(array, tmp5, reg(from_index)); // array -> s.charAt(fromIndex);
+
+  bind(latin1_loop);
+    ldrb(from_index, imm_index(array, 1, post_indexed));
+    cmp(from_index, reg(ch));
+    b(latin1_success, eq);
+    cmp(array, reg(max));
+    b(latin1_loop, lt);
+    b(failure);
+
+  bind(latin1_success);
+    comment("return i - offset;");
+    sub(tos_val, array, reg(tmp4));
+    sub(tos_val, tos_val, imm(1)); // array has been post-indexed
+    set_return_type(T_INT);
+    comment("continue in caller");
+    jmpx(lr);
+#endif
   }
 
   //----------------------java.lang.String.compareTo--------------------------
@@ -855,6 +1001,14 @@ void NativeGenerator::generate_native_string_entries() {
     cmp(str1, zero);
     b(error, eq);
 
+#if ENABLE_CLDC_111
+    comment("Either string has a Latin-1 body?");
+    ldr(junk0, imm_index(str0, String::latin1_offset()));
+    ldr(junk1, imm_index(str1, String::latin1_offset()));
+    orr(junk0, junk0, reg(junk1), set_CC);
+    b(error, ne);
+#endif
+
     comment("Get str0.value[], str1.value[]");
     ldr(str0_charp, imm_index(str0, String::value_offset()));
     ldr(str1_charp, imm_index(str1, String::value_offset()));
@@ -942,6 +1096,14 @@ void NativeGenerator::generate_native_string_entries() {
     cmp(suffix, zero);
     b(endsWithBailout, eq);
 
+#if ENABLE_CLDC_111
+    comment("Either string has a Latin-1 body?");
+    ldr(this_count, imm_index(this_string, String::latin1_offset()));
+    ldr(suffix_count, imm_index(suffix, String::latin1_offset()));
+    orr(this_count, this_count, reg(suffix_count), set_CC);
+    b(endsWithBailout, ne);
+#endif
+
     comment("Get this.count[], suffix.count[]");
     ldr(this_count, imm_index(this_string, String::count_offset()));
     ldr(suffix_count, imm_index(suffix, String::count_offset()));
@@ -979,9 +1141,24 @@ void NativeGenerator::generate_native_string_entries() {
     pop(this_string);
 
     cmp(prefix, zero);
+#if ENABLE_CLDC_111
+    Label startsWith0Bailout;
+    b(startsWith0Bailout, eq);
+
+    comment("Neither string has a Latin-1 body?");
+    ldr(this_count, imm_index(this_string, String::latin1_offset()));
+    ldr(prefix_count, imm_index(prefix, String::latin1_offset()));
+    orr(this_count, this_count, reg(prefix_count), set_CC);
+    comment("zero for toffset");
+    mov(toffset, zero, eq);
+    b(native_string_startsWith0_continue, eq);
+
+  bind(startsWith0Bailout);
+#else
     comment("zero for toffset");
     mov(toffset, zero, ne);
     b(native_string_startsWith0_continue, ne);
+#endif
 
     comment("Bail out to the general startsWith implementation");
     push(this_string);
@@ -1019,6 +1196,14 @@ void NativeGenerator::generate_native_string_entries() {
     cmp(prefix, zero);
     b(bailout, eq);
 
+#if ENABLE_CLDC_111
+    comment("Either string has a Latin-1 body?");
+    ldr(this_count, imm_index(this_string, String::latin1_offset()));
+    ldr(prefix_count, imm_index(prefix, String::latin1_offset()));
+    orr(this_count, this_count, reg(prefix_count), set_CC);
+    b(bailout, ne);
+#endif
+
   bind(native_string_startsWith0_continue);
     comment("Get this.count[], prefix.count[]");
     ldr(this_count, imm_index(this_string, String::count_offset()));
@@ -1160,7 +1345,7 @@ void NativeGenerator::generate_native_string_entries() {
     cmp(endIndex, reg(count), eq);
     b(return_this, eq);
 
-    sub(heap_top, heap_top, imm(4 * BytesPerWord), set_CC);
+    sub(heap_top, heap_top, imm(String::generated_instance_size()), set_CC);
     b(bailout, mi);
     cmp(heap_top, reg(result));
 
@@ -1199,12 +1384,24 @@ void NativeGenerator::generate_native_string_entries() {
     eol_comment("result.value = string.value");
     str(value,  imm_index(result, String::value_offset()));
 
+#if ENABLE_CLDC_111
+    comment("offset applies to either body, so share latin1 the same way");
+    Register latin1 = count; // count no longer used
+    eol_comment("r%d = string.latin1", latin1);
+    ldr(latin1, imm_index(string, String::latin1_offset()));
+    eol_comment("result.latin1 = string.latin1");
+    str(latin1, imm_index(result, String::latin1_offset()));
+    mov(latin1, zero);
+    eol_comment("result.hash = 0");
+    str(latin1, imm_index(result, String::hash_offset()));
+#endif
+
     // No need for write barrier because the new string is in young gen
 
     eol_comment("return new string in r%d", tos_val);
     mov(tos_val, reg(result));
 
-    add(result, result, imm(4 * BytesPerWord));
+    add(result, result, imm(String::generated_instance_size()));
     set_inline_allocation_top(result);
 
     set_return_type(T_OBJECT);
@@ -1905,6 +2102,14 @@ void NativeGenerator::generate_native_misc_entries() {
     Register buf          = tmp3;
     Register bufsize      = tmp1;
     Register return_value = tos_val;
+#if ENABLE_CLDC_111
+    // StringBuffer.latin1 is laid out right after count.
+    const int latin1_field_offset =
+        Instance::header_size() + sizeof(jobject) + sizeof(jint);
+    Register latin1       = tmp4;
+    Register latin1size   = tmp5;
+    Label latin1_body;
+#endif
 
     comment("Get the object.");
     ldr(obj,      imm_index(jsp, JavaFrame::arg_offset_from_sp(1)));
@@ -1919,6 +2124,12 @@ void NativeGenerator::generate_native_misc_entries() {
     tst(lock, one);
     b("interpreter_method_entry", ne);
 
+#if ENABLE_CLDC_111
+    ldr(latin1,   imm_index(obj, latin1_field_offset));
+    cmp(latin1, zero);
+    b(latin1_body, ne);
+#endif
+
     comment("Check for insufficient capacity of the stringbuffer.");
     ldr(bufsize,  imm_index(buf, Array::length_offset()));
     add(buf, buf, imm_shift(count, lsl, 1));
@@ -1936,6 +2147,31 @@ void NativeGenerator::generate_native_misc_entries() {
     set_return_type(T_OBJECT);
     add_imm(jsp, jsp, -JavaStackDirection * 2 * BytesPerStackElement);
     jmpx(lr);
+
+#if ENABLE_CLDC_111
+  bind(latin1_body);
+    comment("Latin-1 body: a char above 0xFF needs the Java code to inflate");
+    ldr(thechar,  imm_index(jsp, JavaFrame::arg_offset_from_sp(0)));
+    cmp(thechar, imm(0xFF));
+    b("interpreter_method_entry", hi);
+
+    comment("Check for insufficient capacity of the stringbuffer.");
+    ldr(latin1size, imm_index(latin1, Array::length_offset()));
+    add(latin1, latin1, reg(count));
+    cmp(count, reg(latin1size));
+    b("interpreter_method_entry", ge);
+
+    comment("Increment the count, append the char.");
+    add(count, count, imm(1));
+    str(count, imm_index(obj, Instance::header_size()+sizeof(jobject)));
+    strb(thechar, imm_index(latin1, Array::base_offset()));
+
+    comment("Return the object.");
+    mov(return_value, reg(obj));
+    set_return_type(T_OBJECT);
+    add_imm(jsp, jsp, -JavaStackDirection * 2 * BytesPerStackElement);
+    jmpx(lr);
+#endif
   }
 
   //---------------------- java.lang.Integer.toString(int) --------------------
@@ -1946,6 +2182,8 @@ void NativeGenerator::generate_native_misc_entries() {
                 [String value          ] == obj
                 [String offset         ] == max_len - count
                 [String count          ] == (last_ptr - ptr) / sizeof(jchar)
+                [String latin1         ] == null  (ENABLE_CLDC_111 only)
+                [String hash           ] == 0     (ENABLE_CLDC_111 only)
          obj -> [char[] JavaNear       ]
                 [char[] length         ] == max_len
                 [char[] digit 0        ]
@@ -1971,7 +2209,7 @@ void NativeGenerator::generate_native_misc_entries() {
     Label div_loop, div10_magic_constant;
 
     const int max_len = 12; // the longest number (-2147483648) is of 11 chars
-    const int string_instance_size = String::header_size() + 12;
+    const int string_instance_size = String::generated_instance_size();
     const int charray_instance_size = TypeArray::base_offset() +
                                       sizeof(jchar) * max_len;
     const int needed_memory = string_instance_size + charray_instance_size;
@@ -2039,6 +2277,12 @@ void NativeGenerator::generate_native_misc_entries() {
     eol_comment("set String.offset");
     rsb(ptr, ptr, imm(max_len));
     str(ptr, imm_index(result, String::offset_offset()));
+#if ENABLE_CLDC_111
+    eol_comment("set String.latin1 and String.hash");
+    mov(ptr, zero);
+    str(ptr, imm_index(result, String::latin1_offset()));
+    str(ptr, imm_index(result, String::hash_offset()));
+#endif
     
     comment("Return to caller");
     set_return_type(T_OBJECT);
@@ -529,37 +529,37 @@ enum {
 #if ENABLE_FLOAT
   void native_math_sin_entry() {
     jdouble x = DOUBLE_POP();
-    DOUBLE_PUSH(jvm_fplib_sin(x));
+    DOUBLE_PUSH(jvm_sin(x));
     ADVANCE_FOR_RETURN();
   }
 
   void native_math_cos_entry() {
     jdouble x = DOUBLE_POP();
-    DOUBLE_PUSH(jvm_fplib_cos(x));
+    DOUBLE_PUSH(jvm_cos(x));
     ADVANCE_FOR_RETURN();
   }
 
   void native_math_tan_entry() {
     jdouble x = DOUBLE_POP();
-    DOUBLE_PUSH(jvm_fplib_tan(x));
+    DOUBLE_PUSH(jvm_tan(x));
     ADVANCE_FOR_RETURN();
   }
 
   void native_math_sqrt_entry() {
     jdouble x = DOUBLE_POP();
-    DOUBLE_PUSH(ieee754_sqrt(x));
+    DOUBLE_PUSH(jvm_sqrt(x));
     ADVANCE_FOR_RETURN();
   }
 
   void native_math_ceil_entry() {
     jdouble x = DOUBLE_POP();
-    DOUBLE_PUSH(jvm_fplib_ceil(x));
+    DOUBLE_PUSH(jvm_ceil(x));
     ADVANCE_FOR_RETURN();
   }
 
   void native_math_floor_entry() {
     jdouble x = DOUBLE_POP();
-    DOUBLE_PUSH(jvm_fplib_floor(x));
+    DOUBLE_PUSH(jvm_floor(x));
     ADVANCE_FOR_RETURN();
   }
 
@@ -567,26 +567,26 @@ enum {
 
   void native_math_asin_entry() {
     jdouble x = DOUBLE_POP();
-    DOUBLE_PUSH(jvm_fplib_asin(x));
+    DOUBLE_PUSH(jvm_asin(x));
     ADVANCE_FOR_RETURN();
   }
 
   void native_math_acos_entry() {
     jdouble x = DOUBLE_POP();
-    DOUBLE_PUSH(jvm_fplib_acos(x));
+    DOUBLE_PUSH(jvm_acos(x));
     ADVANCE_FOR_RETURN();
   }
 
   void native_math_atan_entry() {
     jdouble x = DOUBLE_POP();
-    DOUBLE_PUSH(jvm_fplib_atan(x));
+    DOUBLE_PUSH(jvm_atan(x));
     ADVANCE_FOR_RETURN();
   }
 
   void native_math_atan2_entry() {
     jdouble y = DOUBLE_POP();
     jdouble x = DOUBLE_POP();
-    DOUBLE_PUSH(jvm_fplib_atan2(x, y));
+    DOUBLE_PUSH(jvm_atan2(x, y));
     ADVANCE_FOR_RETURN();
   }
 
@@ -606,32 +606,9 @@ enum {
       return;
     }
 
-    if (fromIndex < 0) {
-      fromIndex = 0;
-    }
-
-    jint count = *(jint*)(obj + String::count_offset());
-
-    if (fromIndex >= count) {
-      PUSH(-1);
-      ADVANCE_FOR_RETURN();
-      return;
-    }
-
-    jint offset = *(jint*)(obj + String::offset_offset());
-    int max = offset + count;
-    jchar* v = (jchar*)
-      (*(address*)(obj + String::value_offset()) + Array::base_offset());
-
-    for (int i = offset + fromIndex ; i < max ; i++) {
-      if (v[i] == ch) {
-        PUSH(i - offset);
-        ADVANCE_FOR_RETURN();
-        return;
-      }
-    }
-
-    PUSH(-1);
+    // String::index_of() handles both the UTF-16 and the Latin-1 body.
+    String::Raw str = (OopDesc*)obj;
+    PUSH(str().index_of((jchar)ch, fromIndex));
     ADVANCE_FOR_RETURN();
   }
 
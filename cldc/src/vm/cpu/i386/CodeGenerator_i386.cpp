@@ -1834,6 +1834,13 @@ void CodeGenerator::double_unary_do(Value& result, Value& op1,
   // Amazingly enough. . .
   float_unary_do(result, op1, op JVM_NO_CHECK_AT_BOTTOM);
 }
+
+bool CodeGenerator::double_math_do(Value& result, Value& op1,
+                                   BytecodeClosure::math_op op JVM_TRAPS) {
+  // Double arithmetic goes to the interpreter on this platform, so the
+  // call to the method is left as it is.
+  return false;
+}
 #endif
 
 BinaryAssembler::generic_binary_op_1 CodeGenerator::convert_to_generic_binary_1(BytecodeClosure::binary_op op) {
@@ -226,6 +226,9 @@ void NativeGenerator::generate_native_string_entries() {
 
     rom_linkable_entry("native_string_indexof_entry");
     Label cont, loop, test, failure, success;
+#if ENABLE_CLDC_111
+    Label latin1_loop, latin1_test, latin1_body;
+#endif
 
     wtk_profile_quick_call(/* param_size*/ 3);
 
@@ -258,6 +261,11 @@ void NativeGenerator::generate_native_string_entries() {
     movl(edx, Address(ecx, Constant(String::offset_offset())));
     addl(eax, edx); // i = offset + fromIndex
     addl(edx, esi); // int max = offset + count;
+#if ENABLE_CLDC_111
+    movl(esi, Address(ecx, Constant(String::latin1_offset())));   // b = latin1.
+    testl(esi, esi);
+    jcc(not_zero, Constant(latin1_body));
+#endif
     movl(esi, Address(ecx, Constant(String::value_offset())));    // v = value.
     jmp(Constant(test));
 
@@ -270,6 +278,23 @@ void NativeGenerator::generate_native_string_entries() {
     cmpl(eax, edx);
     jcc(less, Constant(loop));
 
+#if ENABLE_CLDC_111
+    comment("Latin-1 body: one byte per char, so ch > 0xFF is not found");
+    bind(latin1_body);
+    cmpl(ebx, Constant(0xFF));
+    jcc(above, Constant(failure));
+    jmp(Constant(latin1_test));
+
+    bind(latin1_loop);
+    cmpb(Address(esi, eax, times_1, Constant(Array::base_offset())),  ebx);
+    jcc(equal, Constant(success));
+    incl(eax);
+
+    bind(latin1_test);
+    cmpl(eax, edx);
+    jcc(less, Constant(latin1_loop));
+#endif
+
     comment("Return -1 by pushing the value and jumping to the return address");
     bind(failure);
     push_int(-1);
@@ -374,6 +399,13 @@ void NativeGenerator::generate_native_string_entries() {
     testl(ecx, ecx);
     jcc(zero, Constant(bailout));
 
+#if ENABLE_CLDC_111
+    comment("Either string has a Latin-1 body?");
+    movl(esi, Address(eax, Constant(String::latin1_offset())));
+    orl(esi, Address(ecx, Constant(String::latin1_offset())));
+    jcc(not_zero, Constant(bailout));
+#endif
+
     comment("get str0.value[]");
     movl(esi, Address(eax, Constant(String::value_offset())));
     comment("get str0.offset");
@@ -474,6 +506,13 @@ void NativeGenerator::generate_native_string_entries() {
 
     movl(ecx, Address(esp, Constant(this_offset)));
 
+#if ENABLE_CLDC_111
+    comment("Either string has a Latin-1 body?");
+    movl(edx, Address(eax, Constant(String::latin1_offset())));
+    orl(edx, Address(ecx, Constant(String::latin1_offset())));
+    jcc(not_zero, Constant(bailout));
+#endif
+
     comment("Pop the return address");
     popl(edi);
 
@@ -515,6 +554,17 @@ void NativeGenerator::generate_native_string_entries() {
     cmpl(Address(esp, Constant(prefix_offset)), Constant(0));
     jcc(equal, Constant(bailout));
 
+#if ENABLE_CLDC_111
+    int this_offset = JavaFrame::arg_offset_from_sp(1) + 4;
+
+    comment("Either string has a Latin-1 body?");
+    movl(eax, Address(esp, Constant(prefix_offset)));
+    movl(ecx, Address(esp, Constant(this_offset)));
+    movl(edx, Address(eax, Constant(String::latin1_offset())));
+    orl(edx, Address(ecx, Constant(String::latin1_offset())));
+    jcc(not_zero, Constant(bailout));
+#endif
+
     comment("Pop the return address");
     popl(edi);
     comment("Push zero for toffset");
@@ -552,6 +602,18 @@ void NativeGenerator::generate_native_string_entries() {
     cmpl(Address(esp, Constant(prefix_offset)), Constant(0));
     jcc(equal, Constant(bailout));
 
+#if ENABLE_CLDC_111
+    // endsWith() and startsWith(String) check this before they get here.
+    int  this_offset =  JavaFrame::arg_offset_from_sp(2) + 4;
+
+    comment("Either string has a Latin-1 body?");
+    movl(eax, Address(esp, Constant(prefix_offset)));
+    movl(ecx, Address(esp, Constant(this_offset)));
+    movl(edx, Address(eax, Constant(String::latin1_offset())));
+    orl(edx, Address(ecx, Constant(String::latin1_offset())));
+    jcc(not_zero, Constant(bailout));
+#endif
+
     comment("Pop the return address");
     popl(edi);
 
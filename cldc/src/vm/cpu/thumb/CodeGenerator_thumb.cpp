@@ -1187,6 +1187,12 @@ void CodeGenerator::double_unary_do(Value& result, Value& op1,
   }
 }
 
+bool CodeGenerator::double_math_do(Value& result, Value& op1,
+                                   BytecodeClosure::math_op op JVM_TRAPS) {
+  // Not implemented on this platform: the method is called instead.
+  return false;
+}
+
 void CodeGenerator::double_cmp(Value& result, BytecodeClosure::cond_op cond,
                                Value& op1, Value& op2 JVM_TRAPS) {
   JVM_IGNORE_TRAPS;
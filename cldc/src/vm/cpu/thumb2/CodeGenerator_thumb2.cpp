@@ -1656,6 +1656,38 @@ void CodeGenerator::double_unary_do(Value& result, Value& op1,
 #endif
 }
 
+bool CodeGenerator::double_math_do(Value& result, Value& op1,
+                                   BytecodeClosure::math_op op JVM_TRAPS) {
+  JVM_IGNORE_TRAPS;
+  double (*runtime_func)(double);
+  switch (op) {
+    case BytecodeClosure::math_sqrt:  runtime_func = jvm_sqrt;  break;
+    case BytecodeClosure::math_floor: runtime_func = jvm_floor; break;
+    case BytecodeClosure::math_ceil:  runtime_func = jvm_ceil;  break;
+    default:                          runtime_func = 0; SHOULD_NOT_REACH_HERE();
+  }
+#if ENABLE_ARM_VFP
+  // fsqrtd is correctly rounded, but in RunFast mode it would flush
+  // denormals to zero, and unlike the arithmetic bytecodes there is no
+  // redo routine for it.
+  if (op == BytecodeClosure::math_sqrt
+#if ENABLE_SOFT_FLOAT
+      && !RunFastMode
+#endif
+      ) {
+    write_literals_if_desperate();
+    GUARANTEE(op1.in_register(), "op1 must be in a register");
+
+    ensure_in_float_register(op1);
+    assign_register(result, op1);
+    fsqrtd(result.lo_register(), op1.lo_register());
+    return true;
+  }
+#endif  // ENABLE_ARM_VFP
+  call_simple_c_runtime(result, (address)runtime_func, op1);
+  return true;
+}
+
 void CodeGenerator::double_cmp(Value& result, BytecodeClosure::cond_op cond,
                                Value& op1, Value& op2 JVM_TRAPS) {
   int (*runtime_func)(double, double);
@@ -225,13 +225,37 @@ void NativeGenerator::generate_native_string_entries() {
     comment("r%d = offset", offset);
     ldr(offset, imm_index(string, String::offset_offset()));
 
+#if ENABLE_CLDC_111
+    Register latin1     = tmp5;
+    comment("r%d = latin1", latin1);
+    ldr(latin1, imm_index(string, String::latin1_offset()));
+#endif
+
     comment("if ((unsigned int) index >= (unsigned int) count) goto bailout;");
     cmp(index, count);
     b(bailout, hs);
 
+    add(index, index, reg(offset));
+
+#if ENABLE_CLDC_111
+    Label utf16_body;
+    cmp(latin1, imm12(zero));
+    b(utf16_body, eq);
+
+    comment("return: r%d = latin1[index + offset]", tos_val);
+    add(latin1, latin1, reg(index));
+    ldrb_imm12_w(tos_val, latin1, Array::base_offset());
+    set_return_type(T_INT);
+
+    comment("remove arguments from the stack");
+    add_imm(jsp, jsp, -JavaStackDirection * 2 * BytesPerStackElement);
+
+    mov(pc, lr);
+
+  bind(utf16_body);
+#endif
 
     comment("return: r%d = array[index + offset]", tos_val);
-    add(index, index, reg(offset));
     add(array, array, imm_shift(index, lsl, 1));
     ldrh_imm12_w(tos_val, array, Array::base_offset());
     set_return_type(T_INT);
@@ -328,6 +352,9 @@ void NativeGenerator::generate_native_string_entries() {
     b(native_string_indexof_continue);
 
     Label loop, test, failure, success;
+#if ENABLE_CLDC_111
+    Label latin1_body, latin1_loop, latin1_success;
+#endif
     bind_rom_linkable("native_string_indexof0_entry");
 
     comment("[[[Hand coded method from java.lang.String]]]");
@@ -378,6 +405,12 @@ void NativeGenerator::generate_native_string_entries() {
     cmp(from_index, reg(tmp4));   // if (fromIndex >= count) goto Failure
     b(failure, ge);
 
+#if ENABLE_CLDC_111
+    ldr(tmp5,    imm_index(string, String::latin1_offset())); // latin1
+    cmp(tmp5, imm12(zero));
+    b(latin1_body, ne);
+#endif
+
     add_imm(array, array, Array::base_offset());
     add(array, array, imm_shift(tmp2, lsl, 1));   // array -> s.charAt(0);
     add(max,   array, imm_shift(tmp4, lsl, 1));   // max -> s.charAt(count)
@@ -416,6 +449,36 @@ void NativeGenerator::generate_native_string_entries() {
     set_return_type(T_INT);
     comment("continue in caller");
     mov(pc, lr);
+
+#if ENABLE_CLDC_111
+  bind(latin1_body);
+    comment("Latin-1 body: one byte per char, so ch > 0xFF is not found");
+    cmp(ch, imm12(0xFF));
+    b(failure, hi);
+
+    add_imm(tmp5, tmp5, Array::base_offset());
+    add(tmp5, tmp5, reg(tmp2));        // tmp5 -> s.charAt(0);
+    add(max,  tmp5, reg(tmp4));        // max -> s.charAt(count)
+    mov(tmp4, reg(tmp5));
+    add(array, tmp5, reg(from_index)); // array -> s.charAt(fromIndex);
+
+  bind(latin1_loop);
+    ldrb(from_index, array, 0);
+    add(array, array, imm(1));
+    cmp(from_index, reg(ch));
+    b(latin1_success, eq);
+    cmp(array, reg(max));
+    b(latin1_loop, lt);
+    b(failure);
+
+  bind(latin1_success);
+    comment("return i - offset;");
+    sub(tos_val, array, reg(tmp4));
+    sub(tos_val, tos_val, imm(1)); // array has been post-indexed
+    set_return_type(T_INT);
+    comment("continue in caller");
+    mov(pc, lr);
+#endif
   }
 #if 0 // BEGIN_CONVERT_TO_T2
   //----------------------java.lang.String.compareTo--------------------------
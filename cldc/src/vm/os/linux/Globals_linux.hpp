@@ -32,7 +32,14 @@
   product(int, TickInterval, 10,                                              \
           "Set the delay interval for servicing compiler generation")         \
   product(int, ExecutionLoops, 1,                                             \
-          "the number of times we run the VM (for measuring start-up time)")
+          "the number of times we run the VM (for measuring start-up time)")  \
+  product(bool, UseCompilerTimerThread, false,                                \
+          "Use a dedicated native thread to time the compilation slices "     \
+          "(only with ENABLE_TIMER_THREAD)")                                  \
+  product(bool, UseConsoleWriterThread, false,                                \
+          "Print System.out output on a dedicated native thread, so that "    \
+          "Java threads don't wait for the console "                          \
+          "(only with ENABLE_TIMER_THREAD)")
 
 #define PLATFORM_RUNTIME_FLAGS(develop, product)         \
         PLATFORM_RUNTIME_FLAGS_GENERIC(develop, product)
@@ -176,12 +176,17 @@ static bool   ticker_stopped = false;
 AZZERT_ONLY(static bool is_processing_timer_tick = false;)
 
 #if ENABLE_COMPILER
-static bool   _compiler_timer_has_ticked;
+// Also set by the ticker and compiler timer threads.
+static volatile bool _compiler_timer_has_ticked;
 static jlong  _compiler_timer_start;
 #endif
 
 static inline void rt_tick_event();
 
+#if ENABLE_COMPILER && ENABLE_TIMER_THREAD
+static void stop_compiler_timer_thread();
+#endif
+
 #if ENABLE_TIMER_THREAD
 
 static sem_t ticker_semaphore;
@@ -318,6 +323,150 @@ void Os::stop_ticks() {
 
 #endif // ENABLE_TIMER_THREAD
 
+#if ENABLE_TIMER_THREAD
+/*
+ * When UseConsoleWriterThread is set, what Java code writes to System.out
+ * is printed by a separate native thread, so that Java threads don't stall
+ * on a slow terminal or pipe. ConsoleOutput hands every line (or full
+ * buffer) to console_writer_put(), which only copies it into a ring
+ * buffer; the writer thread prints the ring buffer with JVMSPI_PrintRaw().
+ * A Java thread waits only when the ring buffer is full, and when the VM
+ * prints on tty itself: console_writer_drain() then waits until the ring
+ * buffer is printed, so that VM and Java output stay in order.
+ */
+enum {
+  CONSOLE_WRITER_BUFFER_SIZE = 4096,
+  CONSOLE_WRITER_CHUNK_SIZE  = 1024
+};
+
+static pthread_mutex_t console_writer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  console_writer_cond  = PTHREAD_COND_INITIALIZER;
+// console_writer_created is also read without the mutex.
+static volatile bool console_writer_created  = false;
+static bool console_writer_stopping = false;
+static bool console_writer_printing = false;  // a chunk is being printed
+static char console_writer_buffer[CONSOLE_WRITER_BUFFER_SIZE];
+static int  console_writer_head  = 0;  // first byte that is not printed yet
+static int  console_writer_count = 0;  // number of bytes not printed yet
+
+// Moves up to <max> bytes from the ring buffer to <chunk> and 0-terminates
+// it. Called with console_writer_mutex held.
+static int console_writer_take(char* chunk, int max) {
+  int length = 0;
+  while (length < max && console_writer_count > 0) {
+    chunk[length++] = console_writer_buffer[console_writer_head];
+    console_writer_head =
+      (console_writer_head + 1) % CONSOLE_WRITER_BUFFER_SIZE;
+    console_writer_count--;
+  }
+  chunk[length] = 0;
+  return length;
+}
+
+static int console_writer_thread_routine(void *parameter) {
+  char chunk[CONSOLE_WRITER_CHUNK_SIZE + 1];
+
+  ::pthread_mutex_lock(&console_writer_mutex);
+  while (console_writer_count > 0 || !console_writer_stopping) {
+    if (console_writer_count == 0) {
+      ::pthread_cond_wait(&console_writer_cond, &console_writer_mutex);
+      continue;
+    }
+    console_writer_take(chunk, CONSOLE_WRITER_CHUNK_SIZE);
+    console_writer_printing = true;
+    // Let Java threads fill the ring buffer while we print.
+    ::pthread_cond_broadcast(&console_writer_cond);
+    ::pthread_mutex_unlock(&console_writer_mutex);
+    JVMSPI_PrintRaw(chunk);
+    ::pthread_mutex_lock(&console_writer_mutex);
+    console_writer_printing = false;
+    ::pthread_cond_broadcast(&console_writer_cond);
+  }
+  console_writer_created = false;
+  ::pthread_cond_broadcast(&console_writer_cond);
+  ::pthread_mutex_unlock(&console_writer_mutex);
+  return 0;
+}
+
+static void console_writer_put(const char* s, int length) {
+  if (!console_writer_created) {
+    // The writer thread is gone (see flush_console_output_on_crash()).
+    JVMSPI_PrintRaw(s);
+    return;
+  }
+  ::pthread_mutex_lock(&console_writer_mutex);
+  for (int i = 0; i < length; i++) {
+    while (console_writer_count == CONSOLE_WRITER_BUFFER_SIZE) {
+      ::pthread_cond_wait(&console_writer_cond, &console_writer_mutex);
+    }
+    const int tail =
+      (console_writer_head + console_writer_count) % CONSOLE_WRITER_BUFFER_SIZE;
+    console_writer_buffer[tail] = s[i];
+    console_writer_count++;
+  }
+  ::pthread_cond_broadcast(&console_writer_cond);
+  ::pthread_mutex_unlock(&console_writer_mutex);
+}
+
+static void console_writer_drain() {
+  if (!console_writer_created) {
+    return;
+  }
+  ::pthread_mutex_lock(&console_writer_mutex);
+  while (console_writer_created &&
+         (console_writer_count > 0 || console_writer_printing)) {
+    ::pthread_cond_wait(&console_writer_cond, &console_writer_mutex);
+  }
+  ::pthread_mutex_unlock(&console_writer_mutex);
+}
+
+static void start_console_writer_thread() {
+  console_writer_stopping = false;
+  console_writer_head  = 0;
+  console_writer_count = 0;
+  console_writer_printing = false;
+  console_writer_created =
+    (thread_create(console_writer_thread_routine, 0) != 0);
+  if (console_writer_created) {
+    ConsoleOutput::set_sink(console_writer_put, console_writer_drain);
+  }
+}
+
+static void stop_console_writer_thread() {
+  if (console_writer_created) {
+    // Hands over what is still buffered, then prints on tty again.
+    ConsoleOutput::set_sink(NULL);
+    ::pthread_mutex_lock(&console_writer_mutex);
+    console_writer_stopping = true;
+    ::pthread_cond_broadcast(&console_writer_cond);
+    while (console_writer_created) {
+      ::pthread_cond_wait(&console_writer_cond, &console_writer_mutex);
+    }
+    ::pthread_mutex_unlock(&console_writer_mutex);
+  }
+}
+#endif // ENABLE_TIMER_THREAD
+
+// Prints what is left of the console output before the process dies on a
+// fatal signal. The writer thread may be stuck, or the signal may have hit
+// while the ring buffer was locked, so the ring buffer is printed only if
+// it can be locked right away.
+static void flush_console_output_on_crash() {
+#if ENABLE_TIMER_THREAD
+  if (console_writer_created) {
+    if (::pthread_mutex_trylock(&console_writer_mutex) == 0) {
+      char chunk[CONSOLE_WRITER_CHUNK_SIZE + 1];
+      while (console_writer_take(chunk, CONSOLE_WRITER_CHUNK_SIZE) > 0) {
+        JVMSPI_PrintRaw(chunk);
+      }
+      ::pthread_mutex_unlock(&console_writer_mutex);
+    }
+    console_writer_created = false;
+  }
+#endif
+  ConsoleOutput::set_sink(NULL);
+}
+
 #if !ENABLE_TIMER_THREAD
 extern "C" void handle_vtalrm_signal(int signo, siginfo_t* sigi, void* uc) {
   GUARANTEE(!is_processing_timer_tick, "Sanity");
@@ -396,6 +545,7 @@ static void handle_other_signals(int sig) {
     return;
   }
 
+  flush_console_output_on_crash();
   ::jvm_signal(SIGABRT, NULL);
   ::jvm_abort();
 }
@@ -505,6 +655,7 @@ static void handle_segv_siginfo(int signo, siginfo_t *info, void *context) {
     return;
   }
 
+  flush_console_output_on_crash();
   print_siginfo(info);
   print_ucontext(context);
 #ifndef PRODUCT
@@ -967,6 +1118,9 @@ void Os::initialize() {
 
 #if ENABLE_TIMER_THREAD
   main_thread_handle = pthread_self();
+  if (UseConsoleWriterThread) {
+    start_console_writer_thread();
+  }
 #else
   // setup vtalarm signal handler to provide a source of
   // timer-based interrupts for Java thread switching and dynamical
@@ -1021,6 +1175,12 @@ void Os::initialize() {
  * all the work that initialize does.
  */
 void Os::dispose() {
+#if ENABLE_TIMER_THREAD
+  stop_console_writer_thread();
+#endif
+#if ENABLE_COMPILER && ENABLE_TIMER_THREAD
+  stop_compiler_timer_thread();
+#endif
 #if NEED_XSCALE_PMU_CYCLE_COUNTER
   ixs_close_ins_counter();
 #endif
@@ -1071,8 +1231,110 @@ void OsMisc_flush_icache(address start, int size) {
  * resource to serve both real_time_tick and the compiler timer.
  */
 
+#if ENABLE_COMPILER && ENABLE_TIMER_THREAD
+/*
+ * When UseCompilerTimerThread is set, the compilation slice is timed by
+ * a separate native thread instead of being sampled with
+ * Os::java_time_millis() after every compilation queue element. The
+ * compiler thread then only polls _compiler_timer_has_ticked, and the
+ * slice length is exactly MaxCompilationTime, independent of the
+ * granularity of TickInterval. The timer thread sleeps on a condition
+ * variable while no compilation is in progress.
+ *
+ * Only the timing moves to the helper thread: the compiler itself still
+ * runs in the time slice of the Java thread, since neither the object
+ * heap nor the compiler area can be used by two threads at once.
+ *
+ * The flags are changed with compiler_timer_mutex held, but
+ * compiler_timer_created is also polled without it by rt_tick_event().
+ * The thread and stop_compiler_timer_thread() share compiler_timer_cond,
+ * so it is always broadcast.
+ */
+static pthread_mutex_t compiler_timer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  compiler_timer_cond  = PTHREAD_COND_INITIALIZER;
+static volatile bool   compiler_timer_created  = false;
+static volatile bool   compiler_timer_armed    = false;
+static volatile bool   compiler_timer_stopping = false;
+static struct timespec compiler_timer_deadline;
+
+static int compiler_timer_thread_routine(void *parameter) {
+  ::pthread_mutex_lock(&compiler_timer_mutex);
+  while (!compiler_timer_stopping) {
+    if (!compiler_timer_armed) {
+      ::pthread_cond_wait(&compiler_timer_cond, &compiler_timer_mutex);
+      continue;
+    }
+    const int rc = ::pthread_cond_timedwait(&compiler_timer_cond,
+                                            &compiler_timer_mutex,
+                                            &compiler_timer_deadline);
+    // The deadline may have been moved by a new start_compiler_timer()
+    // while we were waiting, so check it again before firing.
+    if (rc == ETIMEDOUT && compiler_timer_armed) {
+      struct timeval now;
+      ::gettimeofday(&now, NULL);
+      if (now.tv_sec > compiler_timer_deadline.tv_sec ||
+          (now.tv_sec == compiler_timer_deadline.tv_sec &&
+           now.tv_usec * 1000 >= compiler_timer_deadline.tv_nsec)) {
+        compiler_timer_armed = false;
+        _compiler_timer_has_ticked = true;
+      }
+    }
+  }
+  compiler_timer_created = false;
+  ::pthread_cond_broadcast(&compiler_timer_cond);
+  ::pthread_mutex_unlock(&compiler_timer_mutex);
+  return 0;
+}
+
+static bool start_compiler_timer_thread() {
+  if (!compiler_timer_created) {
+    compiler_timer_stopping = false;
+    compiler_timer_created =
+      (thread_create(compiler_timer_thread_routine, 0) != 0);
+  }
+  if (compiler_timer_created) {
+    struct timeval now;
+    ::gettimeofday(&now, NULL);
+    jlong nsec = (jlong)now.tv_usec * 1000 +
+                 (jlong)MaxCompilationTime * 1000000;
+
+    ::pthread_mutex_lock(&compiler_timer_mutex);
+    compiler_timer_deadline.tv_sec  = now.tv_sec + (time_t)(nsec / 1000000000);
+    compiler_timer_deadline.tv_nsec = (long)(nsec % 1000000000);
+    compiler_timer_armed = true;
+    ::pthread_cond_broadcast(&compiler_timer_cond);
+    ::pthread_mutex_unlock(&compiler_timer_mutex);
+  }
+  return compiler_timer_created;
+}
+
+static void stop_compiler_timer_thread() {
+  if (compiler_timer_created) {
+    ::pthread_mutex_lock(&compiler_timer_mutex);
+    compiler_timer_stopping = true;
+    compiler_timer_armed = false;
+    ::pthread_cond_broadcast(&compiler_timer_cond);
+    // The thread may be between two waits, but it always checks
+    // compiler_timer_stopping before it waits again.
+    while (compiler_timer_created) {
+      ::pthread_cond_wait(&compiler_timer_cond, &compiler_timer_mutex);
+    }
+    ::pthread_mutex_unlock(&compiler_timer_mutex);
+  }
+}
+#endif // ENABLE_COMPILER && ENABLE_TIMER_THREAD
+
 void Os::start_compiler_timer() {
 #if ENABLE_COMPILER
+#if ENABLE_TIMER_THREAD
+  if (UseCompilerTimerThread) {
+    _compiler_timer_start = (jlong)0;
+    _compiler_timer_has_ticked = false;
+    if (start_compiler_timer_thread()) {
+      return;
+    }
+  }
+#endif
   if (MaxCompilationTime == TickInterval) {
     // Note: this tend to make the average compilation period to be
     // 0.5 * MaxCompilationTime.
@@ -1104,6 +1366,12 @@ bool Os::check_compiler_timer() {
 static inline void rt_tick_event() {
   real_time_tick(TickInterval);
 #if ENABLE_COMPILER
+#if ENABLE_TIMER_THREAD
+  if (UseCompilerTimerThread && compiler_timer_created) {
+    // The compilation slice is timed by the compiler timer thread.
+    return;
+  }
+#endif
   _compiler_timer_has_ticked = true;
 #endif
 }
@@ -40,7 +40,77 @@ OsFile_Handle OsFile_open(const char *filename, const char *mode) {
   return (OsFile_Handle)jvm_fopen(filename, mode);
 }
 
+#if USE_JAR_FILE_MAPPING
+// Only a few JAR files are open at any time (MaxCachedJarParsers, 4 by
+// default), so a small fixed table is enough to keep track of the
+// mappings. The size is twice that default to leave room for JAR files
+// that are opened with a larger MaxCachedJarParsers. When the table is
+// full, OsFile_map() fails and the file is read with OsFile_read().
+//
+// The mapping is made once, with the length of the file at that time.
+// If the file is truncated later, reading a page past its new end raises
+// SIGBUS, which is not handled; this is why UseMappedJarFiles is off by
+// default.
+#define MAX_MAPPED_FILES 8
+
+static struct {
+  OsFile_Handle handle;
+  address       mapped_address;
+  long          length;
+} _mapped_files[MAX_MAPPED_FILES];
+
+bool OsFile_map(OsFile_Handle handle) {
+  long length;
+  if (OsFile_mapped_address(handle, &length) != NULL) {
+    return true;
+  }
+  for (int i=0; i<MAX_MAPPED_FILES; i++) {
+    if (_mapped_files[i].handle == NULL) {
+      length = OsFile_length(handle);
+      if (length <= 0) {
+        return false;
+      }
+      address addr = (address)jvm_mmap(NULL, length, PROT_READ, MAP_PRIVATE,
+                                        fileno((FILE*)handle), 0);
+      if (addr == (address)MAP_FAILED) {
+        return false;
+      }
+      _mapped_files[i].handle         = handle;
+      _mapped_files[i].mapped_address = addr;
+      _mapped_files[i].length         = length;
+      return true;
+    }
+  }
+  return false;
+}
+
+address OsFile_mapped_address(OsFile_Handle handle, long *length) {
+  for (int i=0; i<MAX_MAPPED_FILES; i++) {
+    if (_mapped_files[i].handle == handle) {
+      *length = _mapped_files[i].length;
+      return _mapped_files[i].mapped_address;
+    }
+  }
+  return NULL;
+}
+
+static void unmap_file(OsFile_Handle handle) {
+  for (int i=0; i<MAX_MAPPED_FILES; i++) {
+    if (_mapped_files[i].handle == handle) {
+      jvm_munmap(_mapped_files[i].mapped_address, _mapped_files[i].length);
+      _mapped_files[i].handle = NULL;
+      _mapped_files[i].mapped_address = NULL;
+      _mapped_files[i].length = 0;
+      return;
+    }
+  }
+}
+#endif // USE_JAR_FILE_MAPPING
+
 int OsFile_close(OsFile_Handle handle) {
+#if USE_JAR_FILE_MAPPING
+  unmap_file(handle);
+#endif
   return jvm_fclose(handle);
 }
 
@@ -31,6 +31,12 @@
 #include "incls/_precompiled.incl"
 #include "incls/_OsMisc_linux.cpp.incl"
 
+#if USE_VERIFIER_CACHE
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -82,6 +88,79 @@ void OsMisc_page_unprotect() {
 void OsMisc_hardware_power_reset() {
 }
 
+#if ENABLE_PERF_MAP
+int OsMisc_get_process_id() {
+  return (int)getpid();
+}
+#endif
+
+#if USE_VERIFIER_CACHE
+static bool read_fully(int fd, unsigned char* buffer, int length) {
+  while (length > 0) {
+    ssize_t n = read(fd, buffer, length);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buffer += n;
+    length -= (int)n;
+  }
+  return true;
+}
+
+// The key is kept next to the cache file in <cache_file>.key. It is
+// created with mode 0600, and an existing key file is only accepted if
+// it is a regular file owned by the effective user and not accessible
+// by anyone else.
+bool OsMisc_get_verifier_cache_key(const JvmPathChar* cache_file,
+                                   unsigned char* key, int key_length) {
+  static const char suffix[] = ".key";
+  char path[PATH_MAX];
+  int len = 0;
+  for (; cache_file[len] != 0; len++) {
+    if (len >= (int)(sizeof(path) - sizeof(suffix)) ||
+        (unsigned)cache_file[len] > 0x7f) {
+      return false;
+    }
+    path[len] = (char)cache_file[len];
+  }
+  jvm_memcpy(path + len, suffix, sizeof(suffix));
+
+  int fd = open(path, O_RDONLY | O_NOFOLLOW);
+  if (fd < 0) {
+    if (errno != ENOENT) {
+      return false;
+    }
+    fd = open(path, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+    if (fd < 0) {
+      return false;
+    }
+    int random = open("/dev/urandom", O_RDONLY);
+    bool ok = random >= 0 && read_fully(random, key, key_length) &&
+              write(fd, key, key_length) == key_length;
+    if (random >= 0) {
+      close(random);
+    }
+    if (close(fd) != 0) {
+      ok = false;
+    }
+    if (!ok) {
+      unlink(path);
+    }
+    return ok;
+  }
+
+  struct stat st;
+  bool ok = fstat(fd, &st) == 0 && S_ISREG(st.st_mode) &&
+            st.st_uid == geteuid() && (st.st_mode & 077) == 0 &&
+            st.st_size == key_length && read_fully(fd, key, key_length);
+  close(fd);
+  return ok;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -97,6 +97,23 @@ void OsMisc_hardware_power_reset() {
 
 }
 
+#if ENABLE_PERF_MAP
+int OsMisc_get_process_id() {
+  // No process id to name the perf map after, so it is not written.
+  return -1;
+}
+#endif
+
+#if USE_VERIFIER_CACHE
+bool OsMisc_get_verifier_cache_key(const JvmPathChar* /*cache_file*/,
+                                   unsigned char* /*key*/,
+                                   int /*key_length*/) {
+  // No place to keep a per-device secret, so the verifier cache
+  // is not used.
+  return false;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
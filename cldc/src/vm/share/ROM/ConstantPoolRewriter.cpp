@@ -811,6 +811,17 @@ void ConstantPoolRewriter::replace_method_references(JVM_SINGLE_ARG_TRAPS) {
     vector->element_at_put(i, &new_method);
   }
 #endif
+
+#if USE_SOURCE_IMAGE_GENERATOR
+  // Likewise for the methods to be clustered by the profile-guided layout
+  ROMVector *hot_methods = _optimizer->hot_method_list();
+  int hot_size = hot_methods->size();
+  for (int j=0; j < hot_size; j++) {
+    Method::Raw old_method = hot_methods->element_at(j);
+    Method::Raw new_method = find_method_replacement(&old_method);
+    hot_methods->element_at_put(j, &new_method);
+  }
+#endif
 }
 
 class MethodReplacer : public OopROMVisitor {
@@ -91,6 +91,9 @@ void ROMOptimizer::optimize(Stream *log_stream JVM_TRAPS) {
       break;
 
     case STATE_MERGE_STRING_BODIES:
+      // ROM strings may live in read-only memory, so their hash codes
+      // must be cached before they are written out.
+      precompute_string_hashes();
 #if USE_SOURCE_IMAGE_GENERATOR
       // Merge all string bodies into a single char array.
       merge_string_bodies(JVM_SINGLE_ARG_CHECK);
@@ -387,6 +390,7 @@ void ROMOptimizer::initialize(Stream *log_stream JVM_TRAPS) {
   hidden_packages()->initialize(JVM_SINGLE_ARG_CHECK);
   restricted_packages()->initialize(JVM_SINGLE_ARG_CHECK);
   reserved_words()->initialize(JVM_SINGLE_ARG_CHECK);
+  hot_method_list()->initialize(JVM_SINGLE_ARG_CHECK);
 
   *romizer_original_class_name_list() = Universe::new_obj_array(cnt JVM_CHECK);
   *romizer_original_method_info()     = Universe::new_obj_array(cnt JVM_CHECK);
@@ -405,6 +409,10 @@ void ROMOptimizer::initialize(Stream *log_stream JVM_TRAPS) {
 
 #endif // USE_SOURCE_IMAGE_GENERATOR
 
+#if USE_BINARY_IMAGE_GENERATOR
+  read_init_at_build_config(JVM_SINGLE_ARG_CHECK);
+#endif
+
   allocate_empty_arrays(JVM_SINGLE_ARG_CHECK);
   initialize_subclasses_cache(JVM_SINGLE_ARG_CHECK);
 }
@@ -435,6 +443,24 @@ void ROMOptimizer::allocate_empty_arrays(JVM_SINGLE_ARG_TRAPS) {
             "Universe::empty_obj_array may not be placed in TEXT");
 }
 
+class StringHashPrecomputer : public ObjectHeapVisitor {
+public:
+  virtual void do_obj(Oop* obj) {
+    if (obj->is_string()) {
+      ((String*)obj)->hash();
+    }
+  }
+};
+
+// String::hash() caches the hash code of every String that has a
+// non-zero hash, so the ROM image never needs to be updated at run time.
+void ROMOptimizer::precompute_string_hashes() {
+  if (String::has_hash_field()) {
+    StringHashPrecomputer precomputer;
+    ObjectHeap::iterate(&precomputer);
+  }
+}
+
 // If a non-public class is in a restricted package, and it has no
 // subclasses, make this class 'final'. This makes it possible to
 // switch some invokevirtual bytecodes to the faster
@@ -672,6 +698,13 @@ void ROMOptimizer::initialize_classes(JVM_SINGLE_ARG_TRAPS) {
       if (is_init_at_build(&klass)) {
               Universe::record_inited_at_build(&klass JVM_CHECK);
       }
+#endif
+#if USE_BINARY_IMAGE_GENERATOR && USE_ROM_LOGGING && !USE_PRODUCT_BINARY_IMAGE_GENERATOR
+      if (is_init_at_build(&klass)) {
+        _log_stream->print("init at build: ");
+        klass.print_name_on(_log_stream);
+        _log_stream->cr();
+      }
 #endif
     }
   }
@@ -802,14 +835,8 @@ bool ROMOptimizer::may_be_initialized(InstanceClass *klass) {
 
   Method::Raw init = klass->find_local_method(Symbols::class_initializer_name(),
                                          Symbols::void_signature());
-  if (!init.is_null()) {
-#if USE_SOURCE_IMAGE_GENERATOR
-    if (!is_init_at_build(klass)) {
-      return false;
-    }
-#else
+  if (!init.is_null() && !is_init_at_build(klass)) {
     return false;
-#endif
   }
 
   // All super classes and super interfaces must be initialized
@@ -837,6 +864,152 @@ bool ROMOptimizer::may_be_initialized(InstanceClass *klass) {
   return true;
 }
 
+bool ROMOptimizer::is_init_at_build(InstanceClass *klass) {
+  if (init_at_build_classes()->is_null()) {
+    // The binary image generator was started without a configuration file.
+    return false;
+  }
+
+  int len = init_at_build_classes()->length();
+  bool in_list = false;
+
+  for (int i=0; i<len; i++) {
+    InstanceClass::Raw init_at_build = init_at_build_classes()->obj_at(i);
+    if (init_at_build.is_null()) {
+        break;
+    } else if (init_at_build.equals(klass)) {
+      in_list = true;
+      break;
+    }
+  }
+  
+  return in_list;
+}
+
+#if USE_BINARY_IMAGE_GENERATOR
+// The binary image generator honors only the InitAtBuild entries of the
+// -romconfig file; all other entries are ignored. The <clinit> methods of
+// these application classes are executed during conversion, and their
+// static fields, together with all objects reachable from them, are written
+// into the HEAP block of the binary image. When the image is loaded, the
+// classes (or, in MVM mode, their task mirrors) are already marked as
+// initialized, so <clinit> is not executed again.
+//
+// Just like with the source romizer, it's the responsibility of the
+// configuration author to list only classes whose <clinit> builds
+// self-contained state (no open files or sockets, no threads, no
+// references to objects created by the running system).
+void ROMOptimizer::read_init_at_build_config(JVM_SINGLE_ARG_TRAPS) {
+  const JvmPathChar *config_file = Arguments::rom_config_file();
+  if (config_file == NULL) {
+    return;
+  }
+#if ENABLE_LIB_IMAGES
+  if (GenerateSharedROMImage) {
+    // The task mirrors of a shared image are cloned for every isolate, but
+    // the objects they refer to are not, so the isolates would share the
+    // pre-initialized state.
+    return;
+  }
+#endif
+
+  OsFile_Handle f = OsFile_open(config_file, "r");
+  if (f == NULL) {
+    Throw::error(rom_config_file_error JVM_THROW);
+  }
+
+  *init_at_build_classes() =
+      Universe::new_obj_array(Universe::number_of_java_classes() JVM_NO_CHECK);
+  if (CURRENT_HAS_PENDING_EXCEPTION) {
+    OsFile_close(f);
+    return;
+  }
+
+  // Lines have the form "InitAtBuild = com.foo.Bar". We don't have fgets()
+  // in the OsFile API, see ROMOptimizer::read_config_file().
+  char buff[1024];
+  for (;;) {
+    char c;
+    char *s = buff;
+    const int max = (sizeof(buff) / sizeof(char)) - 1;
+    int n = 0;
+    while (((s - buff) < max) && (n = OsFile_read(f, &c, 1, 1)) == 1) {
+      if (c == '\r') {
+        continue;
+      } else if (c == '\n') {
+        break;
+      }
+      *s++ = c;
+    }
+    if (s == buff && n < 1) {
+      // All input has exhausted
+      break;
+    }
+    *s = 0;
+
+    for (s = buff; *s && isspace(*s);) {
+      s++;
+    }
+    static const char key[] = "InitAtBuild";
+    const int key_len = sizeof(key) - 1;
+    if (jvm_strncmp(s, key, key_len) != 0 ||
+        (s[key_len] != '=' && !isspace(s[key_len]))) {
+      continue;
+    }
+    for (s += key_len; *s && ((*s == '=') || isspace(*s));) {
+      s++;
+    }
+    char *classname = s;
+    for (; *s && !isspace(*s);) {
+      s++;
+    }
+    *s = 0;
+    if (*classname != 0) {
+      add_init_at_build_class(classname JVM_NO_CHECK);
+      if (CURRENT_HAS_PENDING_EXCEPTION) {
+        break;
+      }
+    }
+  }
+
+  OsFile_close(f);
+}
+
+void ROMOptimizer::add_init_at_build_class(const char *classname JVM_TRAPS) {
+  UsingFastOops level1;
+  Symbol::Fast symbol =
+      SymbolTable::slashified_symbol_for((utf8)classname JVM_CHECK);
+
+  // All classes in the JAR file have already been loaded by
+  // BinaryROMWriter::load_all_classes().
+  LoaderContext top_ctx(&symbol, ErrorOnFailure);
+  InstanceClass::Fast klass = SystemDictionary::find(&top_ctx,
+                                                     /*lookup_only=*/ true,
+                                                     /*check_only= */ true
+                                                     JVM_NO_CHECK);
+  if (klass.is_null() || klass().is_romized()) {
+    // Only the classes being converted can be initialized at build time.
+#if USE_ROM_LOGGING
+    _log_stream->print_cr("WARNING: InitAtBuild class not in JAR file: %s",
+                          classname);
+#endif
+    Thread::clear_current_pending_exception();
+    return;
+  }
+
+  ObjArray *list = init_at_build_classes();
+  for (int i=0; i<list->length(); i++) {
+    if (list->obj_at(i) == NULL) {
+      list->obj_at_put(i, &klass);
+      return;
+    } else if (list->obj_at(i) == klass.obj()) {
+      return;
+    }
+  }
+  SHOULD_NOT_REACH_HERE();
+}
+#endif // USE_BINARY_IMAGE_GENERATOR
+
 // Turn on the JVM_ACC_PRELOADED flags of all romized system classes 
 // and the JVM_ACC_CONVERTED flags of all romized application classes 
 // (for some optimizations in the compiler)
@@ -3567,6 +3740,12 @@ void ROMOptimizer::precompile_methods(JVM_SINGLE_ARG_TRAPS) {
   _log_stream->cr();
 #endif
 
+#if USE_SOURCE_IMAGE_GENERATOR
+  // Methods are compiled into the compiler area in the order of this list,
+  // so the compiled code of hot methods ends up next to each other.
+  move_hot_methods_first(precompile_method_list() JVM_CHECK);
+#endif
+
   UsingFastOops level1;
   Method::Fast method;
   InstanceClass::Fast holder;
@@ -141,6 +141,8 @@ private:
   template(ObjArray, jni_native_methods_table, "Methods that use JNI-style " \
                                             "native interface") \
   template(ROMVector,precompile_method_list, "") \
+  template(ROMVector,hot_method_list, "Methods that should be placed " \
+                                            "together at the start of TEXT") \
   template(ObjArray,     string_table, "") \
   template(ObjArray,     symbol_table, "") \
   template(ConstantPool, embedded_table_holder, "") \
@@ -392,6 +394,9 @@ private:
 #if USE_AOT_COMPILATION
   void enable_precompile(const char pattern[] JVM_TRAPS);
 #endif
+  void enable_hot_methods(const char* pattern JVM_TRAPS);
+  void write_hot_methods_log();
+  void move_hot_methods_first(ROMVector* methods JVM_TRAPS);
 
   bool dont_rename_class(InstanceClass *klass) {
     return class_list_contains(dont_rename_classes(), klass);
@@ -403,14 +408,18 @@ private:
     return class_list_contains(dont_rename_methods_classes(), klass);
   }  
 
-  bool is_init_at_build(InstanceClass *klass);
-
 #else
   bool dont_rename_class(InstanceClass* /*klass*/)            {return false;}
   bool dont_rename_fields_in_class(InstanceClass* /*klass*/)  {return false;}
   bool dont_rename_methods_in_class(InstanceClass* /*klass*/) {return false;}
 #endif
 
+#if USE_BINARY_IMAGE_GENERATOR
+  void read_init_at_build_config(JVM_SINGLE_ARG_TRAPS);
+  void add_init_at_build_class(const char *classname JVM_TRAPS);
+#endif
+  bool is_init_at_build(InstanceClass *klass);
+
   void disable_compilation(const char* pattern JVM_TRAPS);
   void write_disable_compilation_log();
   void allocate_empty_arrays(JVM_SINGLE_ARG_TRAPS);
@@ -430,12 +439,15 @@ private:
   void quicken_methods(JVM_SINGLE_ARG_TRAPS);
   bool quicken_one_method(Method *method JVM_TRAPS);
   void optimize_fast_accessors(JVM_SINGLE_ARG_TRAPS);
+  void precompute_string_hashes();
   void merge_string_bodies(JVM_SINGLE_ARG_TRAPS);
-  int  compress_and_merge_strings(ROMVector *all_strings, TypeArray* body);
-  void replace_string_bodies(ROMVector *all_strings, TypeArray* body);
+  int  compress_and_merge_strings(ROMVector *all_strings, TypeArray* body,
+                                  TypeArray* latin1_body, int& latin1_count);
+  void replace_string_bodies(ROMVector *all_strings, TypeArray* body,
+                             TypeArray* latin1_body);
 #if !USE_PRODUCT_BINARY_IMAGE_GENERATOR
-  jint find_duplicate_chars(jchar *pool, jint pool_size,
-                            jchar *match, jint num_chars);
+  jint find_duplicate_chars(address pool, jint pool_size,
+                            address match, jint num_chars, jint char_size);
 #endif
   void resize_class_list(JVM_SINGLE_ARG_TRAPS);
   void rename_non_public_symbols(JVM_SINGLE_ARG_TRAPS);
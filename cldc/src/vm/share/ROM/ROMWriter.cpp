@@ -2021,10 +2021,18 @@ void BlockTypeFinder::begin_object(Oop *object JVM_TRAPS) {
   if (object->is_string()) {
     String::Raw string = object->obj();
     TypeArray chars = string().value();
-    GUARANTEE(writer()->string_chars()->is_null() || 
-              writer()->string_chars()->equals(&chars), 
-              "all romized strings must share the same chars array");
-    *writer()->string_chars() = chars.obj();
+    if (chars.not_null()) {
+      GUARANTEE(writer()->string_chars()->is_null() || 
+                writer()->string_chars()->equals(&chars), 
+                "all romized strings must share the same chars array");
+      *writer()->string_chars() = chars.obj();
+    } else {
+      TypeArray latin1 = string().latin1();
+      GUARANTEE(writer()->string_latin1()->is_null() || 
+                writer()->string_latin1()->equals(&latin1), 
+                "all romized strings must share the same latin1 array");
+      *writer()->string_latin1() = latin1.obj();
+    }
   }
 #endif
 
@@ -2194,6 +2202,11 @@ void BlockTypeFinder::find_array_type(Oop *owner, Oop *object JVM_TRAPS) {
     else if (object->is_byte_array()) {
       if (owner->equals(Universe::resource_data())) {
         type = ROMWriter::TEXT_BLOCK;
+      } else if (owner->is_string()) {
+        // Latin-1 String body -- see the char[] case above.
+        type = ROMWriter::TEXT_BLOCK;
+        my_skip_words = 0;
+        my_pass = PASS_FOR_STRING_BODY;
       }
     }
   }
@@ -51,6 +51,7 @@
  template(Oop,          info_table_last_obj, "") \
  template(ROMizerHashEntry, info_table_last_entry, "") \
  template(TypeArray,    string_chars, "") \
+ template(TypeArray,    string_latin1, "") \
  template(TypeArray,    current_fieldmap, "") \
  template(Oop,          visiting_object, "The object that's currently being" \
                                          "visited by visit_object()") \
@@ -63,6 +63,8 @@ class StringGatherer : public ObjectHeapVisitor {
 private:
   ROMVector* _strings;
   int _num_chars;
+  int _num_latin1_chars;
+  int _num_body_bytes;
 public:
   /**
    * Overrides ObjectHeapVisitor::do_obj(Oop* obj). This method is called
@@ -74,22 +76,46 @@ public:
       if (obj->obj() > ROM::romized_heap_marker()) 
 #endif
       {
+        String* str = (String*)obj;
+        const int count = str->count();
         _strings->add_no_expand(obj);
-        _num_chars += ((String*)obj)->count();
+        if (str->fits_latin1()) {
+          _num_latin1_chars += count;
+        } else {
+          _num_chars += count;
+        }
+        _num_body_bytes += str->is_latin1() ? count : count * sizeof(jchar);
       }
     }
   }
 
   /**
    * Gather all String objects in the ObjectHeap into the given
-   * vector.
+   * vector. Returns the number of chars in Strings that need a UTF-16
+   * body.
    */
   int gather(ROMVector* strings) {
     _strings = strings;
     _num_chars = 0;
+    _num_latin1_chars = 0;
+    _num_body_bytes = 0;
     ObjectHeap::iterate(this);
     return _num_chars;
   }
+
+  /**
+   * Number of chars in Strings that can use a Latin-1 body.
+   */
+  int num_latin1_chars() {
+    return _num_latin1_chars;
+  }
+
+  /**
+   * Size of the String bodies before merging.
+   */
+  int num_body_bytes() {
+    return _num_body_bytes;
+  }
 };
 
 
@@ -202,6 +228,7 @@ void ROMOptimizer::read_config_file(JVM_SINGLE_ARG_TRAPS) {
 
 #if USE_ROM_LOGGING
   write_disable_compilation_log();
+  write_hot_methods_log();
   write_quick_natives_log();
   write_kvm_natives_log();
   write_jni_natives_log();
@@ -479,6 +506,9 @@ void ROMOptimizer::process_config_line(char * s JVM_TRAPS) {
     else if (jvm_strcmp(name, "JniNative") == 0) {
       enable_jni_natives(value JVM_CHECK);
     }
+    else if (jvm_strcmp(name, "HotMethod") == 0) {
+      enable_hot_methods(value JVM_CHECK);
+    }
 
     else {
       tty->print_cr("Unknown command \"%s\" on line %d of %s", name, 
@@ -684,24 +714,6 @@ ROMOptimizer::name_matches_patterns_list(Symbol* checking_name, ROMVector *patte
   return false;
 }
 
-
-bool ROMOptimizer::is_init_at_build(InstanceClass *klass) {
-  int len = init_at_build_classes()->length();
-  bool in_list = false;
-
-  for (int i=0; i<len; i++) {
-    InstanceClass::Raw init_at_build = init_at_build_classes()->obj_at(i);
-    if (init_at_build.is_null()) {
-        break;
-    } else if (init_at_build.equals(klass)) {
-      in_list = true;
-      break;
-    }
-  }
-  
-  return in_list;
-}
-
 // This optimization is too expensive for binary rom image.
 //
 // IMPL_NOTE: we may have some dead strings in ConstantPools!
@@ -720,44 +732,100 @@ void ROMOptimizer::merge_string_bodies(JVM_SINGLE_ARG_TRAPS) {
   ROMVector all_strings;
   all_strings.initialize(num_strings JVM_CHECK);
   int num_chars = sg.gather(&all_strings);
+  int num_latin1_chars = sg.num_latin1_chars();
 
   /*
-   * (2) Merge the body of all Strings into a single array.
+   * (2) Merge the body of all Strings into a single array. Strings
+   *     whose characters all fit in Latin-1 share a byte[] body instead
+   *     (and are converted to the compact form if necessary), the rest
+   *     share a char[] body.
    */
   UsingFastOops level1;
   TypeArray::Fast body = Universe::new_char_array(num_chars JVM_CHECK);
-  TypeArray::Fast new_body;
-  int new_num_chars = compress_and_merge_strings(&all_strings, &body);
+  TypeArray::Fast latin1_body =
+      Universe::new_byte_array(num_latin1_chars JVM_CHECK);
+  TypeArray::Fast new_body = body.obj();
+  TypeArray::Fast new_latin1_body = latin1_body.obj();
+  int new_num_latin1_chars = 0;
+  int new_num_chars = compress_and_merge_strings(&all_strings, &body,
+                                                 &latin1_body,
+                                                 new_num_latin1_chars);
 
   if (new_num_chars < num_chars) {
     new_body = Universe::new_char_array(new_num_chars JVM_CHECK);
     TypeArray::array_copy(&body, 0, &new_body, 0, new_num_chars);
-    replace_string_bodies(&all_strings, &new_body);
+  }
+  if (new_num_latin1_chars < num_latin1_chars) {
+    new_latin1_body = Universe::new_byte_array(new_num_latin1_chars
+                                               JVM_CHECK);
+    TypeArray::array_copy(&latin1_body, 0, &new_latin1_body, 0,
+                          new_num_latin1_chars);
+  }
+  if (new_num_chars < num_chars ||
+      new_num_latin1_chars < num_latin1_chars) {
+    replace_string_bodies(&all_strings, &new_body, &new_latin1_body);
   }
 
 #if USE_ROM_LOGGING
-  _log_stream->print_cr("Merged the body of %d Strings (%d chars, saved "
-                        "%d bytes)",
-                all_strings.size(), num_chars, (num_chars-new_num_chars)*2);
+  const int new_num_bytes = new_num_chars * sizeof(jchar) +
+                            new_num_latin1_chars;
+  _log_stream->print_cr("Merged the body of %d Strings (%d chars, %d "
+                        "Latin-1 chars, saved %d bytes)",
+                        all_strings.size(), num_chars, num_latin1_chars,
+                        sg.num_body_bytes() - new_num_bytes);
 #endif
 }
 
 int ROMOptimizer::compress_and_merge_strings(ROMVector *all_strings,
-                                             TypeArray* body) {
+                                             TypeArray* body,
+                                             TypeArray* latin1_body,
+                                             int& latin1_count) {
   int offset = 0;
+  int latin1_offset = 0;
 
   all_strings->set_sort_strings_by_descending_size(true);
   all_strings->sort();
   for (int i=0; i<all_strings->size(); i++) {
     String::Raw str = all_strings->element_at(i);
-    TypeArray::Raw old_body = str().value();
     int old_offset = str().offset();
     int num_chars = str().count();
-    
+
+    if (str().fits_latin1()) {
+      // Put the characters at the end of the merged body first, then
+      // see if they are already in there.
+      jubyte * pool = (jubyte*)latin1_body->base_address();
+      jubyte * tail = pool + latin1_offset;
+      TypeArray::Raw old_latin1 = str().latin1();
+      if (old_latin1.not_null()) {
+        jvm_memcpy(tail, old_latin1().base_address() + old_offset, num_chars);
+      } else {
+        TypeArray::Raw old_body = str().value();
+        jchar * old_ptr = ((jchar*)old_body().base_address()) + old_offset;
+        for (int j=0; j<num_chars; j++) {
+          tail[j] = (jubyte)old_ptr[j];
+        }
+      }
+      int dup_offset = find_duplicate_chars((address)pool, latin1_offset,
+                                            (address)tail, num_chars,
+                                            sizeof(jubyte));
+      if (dup_offset >= 0) {
+        str().set_offset(dup_offset);
+      } else {
+        str().set_offset(latin1_offset);
+        latin1_offset += num_chars;
+      }
+      str().set_latin1(latin1_body);
+      str().clear_value();
+      continue;
+    }
+
+    TypeArray::Raw old_body = str().value();
     jchar * old_ptr = ((jchar*)old_body().base_address()) + old_offset;
     jchar * new_ptr = (jchar*)body->base_address();
     int dup_offset = -1;
-    dup_offset = find_duplicate_chars(new_ptr, offset, old_ptr, num_chars);
+    dup_offset = find_duplicate_chars((address)new_ptr, offset,
+                                      (address)old_ptr, num_chars,
+                                      sizeof(jchar));
 
     if (dup_offset >= 0) {
       // Found a duplicate in the merged body
@@ -771,34 +839,41 @@ int ROMOptimizer::compress_and_merge_strings(ROMVector *all_strings,
     str().set_value(body);
   }
 
+  latin1_count = latin1_offset;
   return offset;
 }
 
-jint ROMOptimizer::find_duplicate_chars(jchar *pool, jint pool_size, 
-                                        jchar *match, jint num_chars) {
+jint ROMOptimizer::find_duplicate_chars(address pool, jint pool_size, 
+                                        address match, jint num_chars,
+                                        jint char_size) {
   int limit = pool_size - num_chars;
   if (limit < 0) {
     return -1;
   }
 
-  jchar m1 = *match;
-  jint num_bytes = num_chars*sizeof(jchar);
+  jubyte m1 = *match;
+  jint num_bytes = num_chars*char_size;
 
   for (int i=0; i<=limit; i++) {
     if (*pool == m1 && jvm_memcmp(pool, match, num_bytes) == 0) {
       return i;
     }
-    pool ++;
+    pool += char_size;
   }
 
   return -1;
 }
 
 void ROMOptimizer::replace_string_bodies(ROMVector *all_strings,
-                                         TypeArray* body) {
+                                         TypeArray* body,
+                                         TypeArray* latin1_body) {
   for (int i=0; i<all_strings->size(); i++) {
     String::Raw str = all_strings->element_at(i);
-    str().set_value(body);
+    if (str().is_latin1()) {
+      str().set_latin1(latin1_body);
+    } else {
+      str().set_value(body);
+    }
   }
 }
 
@@ -990,6 +1065,81 @@ void ROMOptimizer::enable_precompile(const char pattern[] JVM_TRAPS) {
 
 #endif
 
+class HotMethodsMatcher : public JavaClassPatternMatcher {
+  ROMVector *_hot_methods;
+public:
+  HotMethodsMatcher(ROMVector *hot_methods) {
+    _hot_methods = hot_methods;
+  }
+  virtual void handle_matching_method(Method *m JVM_TRAPS) {
+    if (m->is_abstract() || _hot_methods->contains(m)) {
+      return;
+    }
+    _hot_methods->add_element(m JVM_NO_CHECK_AT_BOTTOM);
+  }
+};
+
+// HotMethod entries are usually generated by the Profiler (see
+// +ProfilerPrintHotMethods). The listed methods, their ClassInfo and
+// constant pools are clustered at the start of their TEXT passes by
+// SourceROMWriter::cluster_hot_objects(), so that the code executed at
+// run-time touches as few cache lines, pages and flash blocks as possible.
+void ROMOptimizer::enable_hot_methods(const char* pattern JVM_TRAPS) {
+  HotMethodsMatcher matcher(hot_method_list());
+  matcher.run(pattern JVM_NO_CHECK_AT_BOTTOM);
+}
+
+void ROMOptimizer::write_hot_methods_log() {
+#if USE_ROM_LOGGING
+  int size = hot_method_list()->size();
+
+  _log_stream->cr();
+  _log_stream->print_cr("[Hot methods (%d)]", size);
+  _log_stream->cr();
+
+  // Don't sort hot_method_list() -- it's in profile order.
+  for (int i=0; i<size; i++) {
+    Method::Raw method = hot_method_list()->element_at(i);
+    _log_stream->print("hot method: ");
+    method().print_name_on(_log_stream);
+    _log_stream->cr();
+  }
+#endif
+}
+
+// Stable partition of <methods>: the methods listed in hot_method_list()
+// are moved to the front, keeping the relative order of both groups.
+void ROMOptimizer::move_hot_methods_first(ROMVector* methods JVM_TRAPS) {
+  const int size = methods->size();
+  if (size == 0 || hot_method_list()->size() == 0) {
+    return;
+  }
+
+  UsingFastOops fast_oops;
+  ObjArray::Fast sorted = Universe::new_obj_array(size JVM_CHECK);
+  Method::Fast method;
+  int n = 0;
+  int i;
+  for (i=0; i<size; i++) {
+    method = methods->element_at(i);
+    if (hot_method_list()->contains(&method)) {
+      sorted().obj_at_put(n++, &method);
+    }
+  }
+  for (i=0; i<size; i++) {
+    method = methods->element_at(i);
+    if (!hot_method_list()->contains(&method)) {
+      sorted().obj_at_put(n++, &method);
+    }
+  }
+  GUARANTEE(n == size, "sanity");
+
+  for (i=0; i<size; i++) {
+    method = sorted().obj_at(i);
+    methods->element_at_put(i, &method);
+  }
+}
+
 class KvmNativesMatcher : public JavaClassPatternMatcher {
   ROMVector *_log_vector;
 public:
@@ -184,6 +184,7 @@ void SourceROMWriter::write_image(JVM_SINGLE_ARG_TRAPS) {
   // Find out where all the objects should live (TEXT, DATA or HEAP,
   // and at what offset). Then write them to the output files.
   find_types(JVM_SINGLE_ARG_CHECK);
+  cluster_hot_objects(JVM_SINGLE_ARG_CHECK);
   find_offsets(JVM_SINGLE_ARG_CHECK);
   _optimizer.set_classes_as_romized();
   write_objects(JVM_SINGLE_ARG_CHECK);
@@ -197,6 +198,108 @@ void SourceROMWriter::write_image(JVM_SINGLE_ARG_TRAPS) {
   _ending_free_heap = ObjectHeap::free_memory();
 }
 
+// All passes over the objects after find_types() visit them in the order
+// of visited_objects(), so the order of this list decides where each
+// object is placed within its block and pass. By default this is the
+// order of discovery. If the ROM configuration file lists HotMethod's,
+// re-order the list (stably) so that within each pass the hot objects
+// come first and the objects of classes never seen in the profile come
+// last. This keeps the code and metadata executed at run-time in as few
+// cache lines, TLB entries and flash blocks as possible.
+void SourceROMWriter::cluster_hot_objects(JVM_SINGLE_ARG_TRAPS) {
+  ROMVector* hot_methods = _optimizer.hot_method_list();
+  if (hot_methods->is_null() || hot_methods->size() == 0) {
+    return;
+  }
+
+  UsingFastOops fast_oops;
+  TypeArray::Fast hot_classes =
+      Universe::new_byte_array(Universe::number_of_java_classes() JVM_CHECK);
+  ROMVector hot_constant_pools;
+  hot_constant_pools.initialize(JVM_SINGLE_ARG_CHECK);
+
+  Method::Fast method;
+  InstanceClass::Fast klass;
+  ConstantPool::Fast cp;
+  int i;
+  for (i=0; i<hot_methods->size(); i++) {
+    method = hot_methods->element_at(i);
+    klass = method().holder();
+    if (hot_classes().byte_at(klass().class_id()) == 0) {
+      hot_classes().byte_at_put(klass().class_id(), 1);
+      cp = method().constants();
+      if (!hot_constant_pools.contains(&cp)) {
+        hot_constant_pools.add_element(&cp JVM_CHECK);
+      }
+    }
+  }
+
+  const int size = visited_objects()->size();
+  ObjArray::Fast raw_objects = visited_objects()->raw_array();
+  ObjArray::Fast raw_infos   = visited_object_infos()->raw_array();
+  TypeArray::Fast temperatures = Universe::new_byte_array(size JVM_CHECK);
+  ObjArray::Fast sorted_objects = Universe::new_obj_array(size JVM_CHECK);
+  ObjArray::Fast sorted_infos   = Universe::new_obj_array(size JVM_CHECK);
+
+  Oop::Fast object;
+  int counts[COLD_OBJECT + 1] = {0, 0, 0};
+  for (i=0; i<size; i++) {
+    object = raw_objects().obj_at(i);
+    int t = temperature_of(&object, &hot_classes, &hot_constant_pools);
+    temperatures().byte_at_put(i, (jbyte)t);
+    counts[t] ++;
+  }
+
+  int n = 0;
+  for (int t = HOT_OBJECT; t <= COLD_OBJECT; t++) {
+    for (i=0; i<size; i++) {
+      if (temperatures().byte_at(i) == t) {
+        sorted_objects().obj_at_put(n, raw_objects().obj_at(i));
+        sorted_infos().obj_at_put(n, raw_infos().obj_at(i));
+        n++;
+      }
+    }
+  }
+  GUARANTEE(n == size, "sanity");
+
+  ObjArray::array_copy(&sorted_objects, 0, &raw_objects, 0, size
+                       JVM_MUST_SUCCEED);
+  ObjArray::array_copy(&sorted_infos, 0, &raw_infos, 0, size
+                       JVM_MUST_SUCCEED);
+
+  if (TraceRomizer) {
+    tty->print_cr("Profile-guided layout: %d hot, %d warm, %d cold objects",
+                  counts[HOT_OBJECT], counts[WARM_OBJECT],
+                  counts[COLD_OBJECT]);
+  }
+}
+
+int SourceROMWriter::temperature_of(Oop* object, TypeArray* hot_classes,
+                                    ROMVector* hot_constant_pools) {
+  if (write_by_reference(object)) {
+    // Not written into this image, so its position doesn't matter
+    return WARM_OBJECT;
+  }
+  if (object->is_method()) {
+    Method::Raw method = object->obj();
+    if (_optimizer.hot_method_list()->contains(&method)) {
+      return HOT_OBJECT;
+    }
+    InstanceClass::Raw klass = method().holder();
+    return hot_classes->byte_at(klass().class_id()) ? WARM_OBJECT
+                                                     : COLD_OBJECT;
+  }
+  if (object->is_class_info()) {
+    ClassInfo::Raw info = object->obj();
+    return hot_classes->byte_at(info().class_id()) ? HOT_OBJECT
+                                                    : COLD_OBJECT;
+  }
+  if (object->is_constant_pool() && hot_constant_pools->contains(object)) {
+    return HOT_OBJECT;
+  }
+  return WARM_OBJECT;
+}
+
 void SourceROMWriter::write_text_defines(FileStream* stream) {
   stream->print_cr("#define TEXT(x)  (int)&_rom_text_block[x]");
   stream->print_cr("#define TEXTb(x) (int)&(((char*)_rom_text_block)[x])");
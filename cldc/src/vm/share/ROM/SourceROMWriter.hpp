@@ -59,10 +59,20 @@ private:
                                      // will go to STATE_SUCCEEDED immediately.
   };
 
+  // Temperature of an object for the profile-guided layout of TEXT.
+  enum {
+    HOT_OBJECT  = 0, // a HotMethod, or the ClassInfo/ConstantPool of its class
+    WARM_OBJECT = 1, // anything else used by a class that has hot methods
+    COLD_OBJECT = 2  // methods and ClassInfo of all other classes
+  };
+
   virtual void write_image(JVM_SINGLE_ARG_TRAPS);
   virtual void visit_persistent_handles(JVM_SINGLE_ARG_TRAPS);
   virtual void load_all_classes(JVM_SINGLE_ARG_TRAPS);
   bool execute0(JVM_SINGLE_ARG_TRAPS);
+  void cluster_hot_objects(JVM_SINGLE_ARG_TRAPS);
+  int  temperature_of(Oop* object, TypeArray* hot_classes,
+                      ROMVector* hot_constant_pools);
 
 #if ENABLE_COMPILER && ENABLE_APPENDED_CALLINFO
   void write_compiled_method_table(JVM_SINGLE_ARG_TRAPS);
@@ -105,6 +105,13 @@ class BytecodeClosure : public StackObj {
       una_abs  // Used for inlining Math.abs
   };
 
+  // Math functions of a double that the compiler may compute in line.
+  enum math_op {
+      math_sqrt,
+      math_floor,
+      math_ceil
+  };
+
   virtual void binary(BasicType /*kind*/, binary_op /*op*/ JVM_TRAPS) 
                                                         {JVM_IGNORE_TRAPS;}
 
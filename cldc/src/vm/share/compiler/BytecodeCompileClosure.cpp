@@ -382,6 +382,32 @@ void BytecodeCompileClosure::unary(BasicType kind, unary_op op JVM_TRAPS) {
   }
 }
 
+#if ENABLE_FLOAT
+bool BytecodeCompileClosure::double_math(Symbol* name JVM_TRAPS) {
+  math_op op;
+  if (name->equals(Symbols::sqrt_name())) {
+    op = math_sqrt;
+  } else if (name->equals(Symbols::floor_name())) {
+    op = math_floor;
+  } else if (name->equals(Symbols::ceil_name())) {
+    op = math_ceil;
+  } else {
+    return false;
+  }
+
+  PoppedValue op1(T_DOUBLE);
+  Value result(T_DOUBLE);
+  const bool done = __ double_math(result, op1, op JVM_CHECK_0);
+  if (done) {
+    frame_push(result);
+  } else {
+    // Leave the argument for the call
+    frame_push(op1);
+  }
+  return done;
+}
+#endif
+
 // Conversion operations.
 void BytecodeCompileClosure::convert(BasicType from, BasicType to JVM_TRAPS) {
   COMPILER_PERFORMANCE_COUNTER_IN_BLOCK(convert);
@@ -1030,6 +1056,11 @@ void BytecodeCompileClosure::fast_put_field(BasicType field_type,
   PoppedValue value(field_type);
   PoppedValue obj(T_OBJECT);
 
+  if (compiler()->is_store_to_eliminated(bci())) {
+    // Storing into a scalar-replaced object, the value is simply dropped.
+    return;
+  }
+
   if (obj.must_be_null()) {
     throw_null_pointer_exception(JVM_SINGLE_ARG_NO_CHECK_AT_BOTTOM);
   } else {
@@ -1398,6 +1429,14 @@ void BytecodeCompileClosure::new_object(int index JVM_TRAPS) {
   }
 #endif // ENABLE_ISOLATES
 
+  if (compiler()->is_allocation_eliminated(bci())) {
+    // The object never escapes and its fields are never read, see
+    // EscapeAnalysis.hpp. A NULL placeholder stands in for it.
+    Oop::Raw null_obj;
+    push_obj(&null_obj JVM_NO_CHECK_AT_BOTTOM);
+    return;
+  }
+
   // Allocate
   Value result(T_OBJECT);
   __ new_object(result, &klass JVM_CHECK);
@@ -1749,6 +1788,26 @@ void BytecodeCompileClosure::direct_invoke(int index, bool must_do_null_check
   }
 #endif
 
+  if (PresizeStringConcat &&
+      callee().match(Symbols::object_initializer_name(),
+                     Symbols::void_signature())) {
+    Symbol::Raw holder_name = holder().name();
+    if (holder_name().equals(Symbols::java_lang_StringBuffer())) {
+      // new StringBuffer().append(..)...toString(): call
+      // StringBuffer(int) with the estimated length of the result.
+      const int capacity = StringConcat::presized_capacity(method(), bci());
+      Method::Fast sized_init =
+        holder().lookup_method(Symbols::object_initializer_name(),
+                               Symbols::int_void_signature());
+      if (capacity > 0 && sized_init.not_null()) {
+        push_int(capacity JVM_CHECK);
+        do_direct_invoke(&sized_init, must_do_null_check
+                         JVM_NO_CHECK_AT_BOTTOM);
+        return;
+      }
+    }
+  }
+
   if (callee().match(Symbols::object_initializer_name(),
                      Symbols::void_signature())) {
     InstanceClass::Raw c = callee().holder();
@@ -1782,6 +1841,14 @@ void BytecodeCompileClosure::direct_invoke(int index, bool must_do_null_check
           return;
       }
     }
+#if ENABLE_FLOAT
+    if (type == T_DOUBLE) {
+      const bool done = double_math(&name JVM_CHECK);
+      if (done) {
+        return;
+      }
+    }
+#endif
   }
 
 #if ENABLE_INLINED_ARRAYCOPY
@@ -118,6 +118,10 @@ class BytecodeCompileClosure: public BytecodeClosure {
   // Binary operations.
   virtual void binary(BasicType kind, binary_op op JVM_TRAPS);
   void unary(BasicType kind, unary_op op JVM_TRAPS);
+#if ENABLE_FLOAT
+  // Inline Math.sqrt(), Math.floor() or Math.ceil(), if this platform can.
+  bool double_math(Symbol* name JVM_TRAPS);
+#endif
 
   // Basic type conversions
   virtual void convert(BasicType from, BasicType to JVM_TRAPS);
@@ -355,6 +355,30 @@ void CodeGenerator::double_binary(Value& result, Value& op1, Value& op2,
   // We don't do constant folding for binary floating operations
   double_binary_do(result, op1, op2, op JVM_NO_CHECK_AT_BOTTOM);
 }
+
+bool CodeGenerator::double_math(Value& result, Value& op1,
+                                BytecodeClosure::math_op op JVM_TRAPS) {
+  if (op1.is_immediate()) {
+    // The results of these functions are exactly defined by IEEE 754,
+    // so they may be computed at compile time.
+    const jdouble value = op1.as_double();
+    switch (op) {
+    case BytecodeClosure::math_sqrt:
+      result.set_double(jvm_sqrt(value));
+      break;
+    case BytecodeClosure::math_floor:
+      result.set_double(jvm_floor(value));
+      break;
+    case BytecodeClosure::math_ceil:
+      result.set_double(jvm_ceil(value));
+      break;
+    default:
+      SHOULD_NOT_REACH_HERE();
+    }
+    return true;
+  }
+  return double_math_do(result, op1, op JVM_NO_CHECK_AT_BOTTOM);
+}
 #endif
 
 void CodeGenerator::int_constant_fold(Value& result, Value& op1, Value& op2,
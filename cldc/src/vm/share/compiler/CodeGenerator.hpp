@@ -280,6 +280,12 @@ public:
                    BytecodeClosure::binary_op op JVM_TRAPS);
   void double_unary(Value& result, Value& op1,
                    BytecodeClosure::unary_op op JVM_TRAPS);
+
+  // Computes Math.sqrt(), Math.floor() or Math.ceil() of op1 in line.
+  // Returns false, leaving op1 untouched, if this platform calls the
+  // method instead.
+  bool double_math(Value& result, Value& op1,
+                   BytecodeClosure::math_op op JVM_TRAPS);
 #endif
 
   // Generate an osr entry.
@@ -393,6 +399,8 @@ public:
                       BytecodeClosure::unary_op op JVM_TRAPS);
   void double_unary_do(Value& result, Value& op1,
                        BytecodeClosure::unary_op op JVM_TRAPS);
+  bool double_math_do(Value& result, Value& op1,
+                      BytecodeClosure::math_op op JVM_TRAPS);
 
   // Alas, these must also handle constant folding, since that is more
   // machine-dependent than one would hope.   Maybe I can fix that later
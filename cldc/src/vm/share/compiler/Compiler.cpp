@@ -496,6 +496,9 @@ inline void Compiler::setup_for_compile( const Method::Attributes& attributes
   Compiler::set_entry_counts_table( attributes.entry_counts );
   Compiler::set_bci_flags_table( attributes.bci_flags );
 
+  EscapeAnalysis::analyze( method(), attributes.entry_counts->base(),
+                           attributes.bci_flags->base() JVM_CHECK );
+
   Compiler::set_num_stack_lock_words(
     attributes.num_locks * 
     ((BytesPerWord + StackLock::size()) / sizeof(jobject)));
@@ -789,6 +792,12 @@ void Compiler::process_compilation_queue( JVM_SINGLE_ARG_TRAPS ) {
 
 #endif
 
+#if ENABLE_PERF_MAP
+  if (result.not_null()) {
+    PerfMap::write_compiled_method((CompiledMethodDesc*)result().obj());
+  }
+#endif
+
   if (InstallCompiledCode) {   
     result().flush_icache();
     method()->set_compiled_execution_entry(result().entry());
@@ -413,6 +413,15 @@ class Compiler: public BytecodeCompileClosure {
     bci_flags_table()->at(bci) |= Method::bci_exception_has_osr_entry;
   }
 
+  bool is_allocation_eliminated(const jint bci) const {
+    return (bci_flags_table()->at(bci) &
+            Method::bci_allocation_eliminated) != 0;
+  }
+  bool is_store_to_eliminated(const jint bci) const {
+    return (bci_flags_table()->at(bci) &
+            Method::bci_store_to_eliminated) != 0;
+  }
+
   bool is_branch_taken(const jint bci) const {
     return (bci_flags_table()->at(bci) & Method::bci_branch_taken) != 0;
   }
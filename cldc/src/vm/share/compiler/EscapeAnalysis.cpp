@@ -0,0 +1,446 @@
+/*
+ *
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+#include "incls/_precompiled.incl"
+#include "incls/_EscapeAnalysis.cpp.incl"
+
+#if ENABLE_COMPILER
+
+void EscapeAnalysis::analyze(const Method* method, const jubyte entry_counts[],
+                             jubyte bci_flags[] JVM_TRAPS) {
+  if (!UseEscapeAnalysis || _debugger_active) {
+    // The debugger may inspect the locals of a compiled frame at any time.
+    return;
+  }
+
+  EscapeAnalysis analysis(method, entry_counts);
+  const int codesize = method->code_size();
+
+  for (int bci = 0; bci < codesize; bci += method->bytecode_length_for(bci)) {
+    switch (method->bytecode_at(bci)) {
+    case Bytecodes::_new:
+    case Bytecodes::_fast_new:
+    case Bytecodes::_fast_init_new:
+      break;
+    default:
+      continue;
+    }
+
+    PERFORMANCE_COUNTER_INCREMENT(escape_analysis_sites, 1);
+
+    int stores[max_eliminated_stores];
+    int num_stores = 0;
+    const bool eliminable =
+      analysis.is_eliminable(bci, stores, num_stores JVM_CHECK);
+    if (!eliminable) {
+      continue;
+    }
+
+    bci_flags[bci] |= Method::bci_allocation_eliminated;
+    for (int i = 0; i < num_stores; i++) {
+      bci_flags[stores[i]] |= Method::bci_store_to_eliminated;
+    }
+    PERFORMANCE_COUNTER_INCREMENT(escape_analysis_eliminated, 1);
+
+    if (TraceEscapeAnalysis) {
+      tty->print("Allocation at bci %d (%d stores) eliminated in ",
+                 bci, num_stores);
+      method->print_name_on_tty();
+      tty->cr();
+    }
+  }
+}
+
+inline bool EscapeAnalysis::push(const bool is_object) {
+  if (_depth < 0 || _depth >= max_tracked_slots) {
+    return false;
+  }
+  if (is_object) {
+    _stack |= (1 << _depth);
+  }
+  _depth++;
+  return true;
+}
+
+inline bool EscapeAnalysis::pop(bool& is_object) {
+  if (_depth <= 0) {
+    return false;
+  }
+  _depth--;
+  is_object = (_stack & (1 << _depth)) != 0;
+  _stack &= ~(1 << _depth);
+  return true;
+}
+
+bool EscapeAnalysis::pop_words(const int words, bool& has_object) {
+  has_object = false;
+  for (int i = 0; i < words; i++) {
+    bool is_object;
+    if (!pop(is_object)) {
+      return false;
+    }
+    has_object |= is_object;
+  }
+  return true;
+}
+
+bool EscapeAnalysis::is_eliminable(const int new_bci, int stores[],
+                                   int& num_stores JVM_TRAPS) {
+  if (!is_eliminable_class(new_bci JVM_CHECK_0)) {
+    return false;
+  }
+
+  const Method* const method = _method;
+  const int codesize = method->code_size();
+
+  _stack  = 1 << stack_bias;
+  _depth  = stack_bias + 1;
+  _locals = 0;
+
+  int bci = method->next_bci(new_bci);
+  for (;;) {
+    if (_stack == 0 && _locals == 0) {
+      // The object is dead.
+      return true;
+    }
+    if (bci >= codesize || _entry_counts[bci] > 1) {
+      // End of the straight-line region.
+      break;
+    }
+
+    bool is_object;
+    bool ok = true;
+    const Bytecodes::Code code = method->bytecode_at(bci);
+    switch (code) {
+    case Bytecodes::_aconst_null:
+    case Bytecodes::_iconst_m1:
+    case Bytecodes::_iconst_0:
+    case Bytecodes::_iconst_1:
+    case Bytecodes::_iconst_2:
+    case Bytecodes::_iconst_3:
+    case Bytecodes::_iconst_4:
+    case Bytecodes::_iconst_5:
+    case Bytecodes::_fconst_0:
+    case Bytecodes::_fconst_1:
+    case Bytecodes::_fconst_2:
+    case Bytecodes::_bipush:
+    case Bytecodes::_sipush:
+    case Bytecodes::_iload:
+    case Bytecodes::_fload:
+    case Bytecodes::_iload_0:
+    case Bytecodes::_iload_1:
+    case Bytecodes::_iload_2:
+    case Bytecodes::_iload_3:
+    case Bytecodes::_fload_0:
+    case Bytecodes::_fload_1:
+    case Bytecodes::_fload_2:
+    case Bytecodes::_fload_3:
+      ok = push(false);
+      break;
+
+    case Bytecodes::_lconst_0:
+    case Bytecodes::_lconst_1:
+    case Bytecodes::_dconst_0:
+    case Bytecodes::_dconst_1:
+    case Bytecodes::_lload:
+    case Bytecodes::_dload:
+    case Bytecodes::_lload_0:
+    case Bytecodes::_lload_1:
+    case Bytecodes::_lload_2:
+    case Bytecodes::_lload_3:
+    case Bytecodes::_dload_0:
+    case Bytecodes::_dload_1:
+    case Bytecodes::_dload_2:
+    case Bytecodes::_dload_3:
+      ok = push(false) && push(false);
+      break;
+
+    case Bytecodes::_aload:
+    case Bytecodes::_aload_0:
+    case Bytecodes::_aload_1:
+    case Bytecodes::_aload_2:
+    case Bytecodes::_aload_3: {
+      const int index = (code == Bytecodes::_aload) ?
+          method->get_ubyte(bci + 1) : (code - Bytecodes::_aload_0);
+      ok = push(index < max_tracked_slots && (_locals & (1 << index)) != 0);
+      break;
+    }
+
+    case Bytecodes::_istore:
+    case Bytecodes::_fstore:
+    case Bytecodes::_istore_0:
+    case Bytecodes::_istore_1:
+    case Bytecodes::_istore_2:
+    case Bytecodes::_istore_3:
+    case Bytecodes::_fstore_0:
+    case Bytecodes::_fstore_1:
+    case Bytecodes::_fstore_2:
+    case Bytecodes::_fstore_3:
+      ok = pop(is_object) && !is_object;
+      break;
+
+    case Bytecodes::_pop:
+      ok = pop(is_object);
+      break;
+
+    case Bytecodes::_lstore:
+    case Bytecodes::_dstore:
+    case Bytecodes::_lstore_0:
+    case Bytecodes::_lstore_1:
+    case Bytecodes::_lstore_2:
+    case Bytecodes::_lstore_3:
+    case Bytecodes::_dstore_0:
+    case Bytecodes::_dstore_1:
+    case Bytecodes::_dstore_2:
+    case Bytecodes::_dstore_3:
+      ok = pop_words(2, is_object) && !is_object;
+      break;
+
+    case Bytecodes::_astore:
+    case Bytecodes::_astore_0:
+    case Bytecodes::_astore_1:
+    case Bytecodes::_astore_2:
+    case Bytecodes::_astore_3: {
+      const int index = (code == Bytecodes::_astore) ?
+          method->get_ubyte(bci + 1) : (code - Bytecodes::_astore_0);
+      if (index >= max_tracked_slots || !pop(is_object)) {
+        ok = false;
+      } else if (is_object) {
+        _locals |= (1 << index);
+      } else {
+        _locals &= ~(1 << index);
+      }
+      break;
+    }
+
+    case Bytecodes::_dup:
+      ok = pop(is_object) && push(is_object) && push(is_object);
+      break;
+
+    case Bytecodes::_iadd:
+    case Bytecodes::_isub:
+    case Bytecodes::_imul:
+    case Bytecodes::_iand:
+    case Bytecodes::_ior:
+    case Bytecodes::_ixor:
+    case Bytecodes::_ishl:
+    case Bytecodes::_ishr:
+    case Bytecodes::_iushr:
+      ok = pop_words(2, is_object) && !is_object && push(false);
+      break;
+
+    case Bytecodes::_ineg:
+    case Bytecodes::_i2b:
+    case Bytecodes::_i2c:
+    case Bytecodes::_i2s:
+      ok = pop(is_object) && !is_object && push(false);
+      break;
+
+    case Bytecodes::_iinc:
+      break;
+
+    case Bytecodes::_invokespecial:
+    case Bytecodes::_fast_invokevirtual_final:
+      // Only the (empty) constructor of the object itself is allowed.
+      ok = is_vanilla_constructor_call(bci) && pop(is_object) && is_object;
+      break;
+
+    case Bytecodes::_putfield:
+    case Bytecodes::_fast_bputfield:
+    case Bytecodes::_fast_sputfield:
+    case Bytecodes::_fast_iputfield:
+    case Bytecodes::_fast_lputfield:
+    case Bytecodes::_fast_fputfield:
+    case Bytecodes::_fast_dputfield:
+    case Bytecodes::_fast_aputfield: {
+      int words;
+      bool value_is_object;
+      ok = putfield_value_words(bci, words JVM_CHECK_0) &&
+           pop_words(words, value_is_object) && !value_is_object &&
+           pop(is_object) && is_object && num_stores < max_eliminated_stores;
+      if (ok) {
+        stores[num_stores++] = bci;
+      }
+      break;
+    }
+
+    default:
+      // Any other bytecode may call out of the method, throw an
+      // exception or fall back to the interpreter.
+      ok = false;
+      break;
+    }
+
+    if (!ok) {
+      break;
+    }
+    bci = method->next_bci(bci);
+  }
+
+  // The region ended before the object died. It can still be eliminated
+  // if it is only referenced by local variables that are never read again.
+  if (_stack != 0) {
+    return false;
+  }
+  for (int index = 0; index < max_tracked_slots; index++) {
+    if ((_locals & (1 << index)) != 0 &&
+        is_local_read_outside(index, new_bci, bci)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool EscapeAnalysis::is_eliminable_class(const int new_bci JVM_TRAPS) const {
+  UsingFastOops fast_oops;
+  ConstantPool::Fast cp = _method->constants();
+  const int index = _method->get_java_ushort(new_bci + 1);
+
+  // Same checks as in BytecodeCompileClosure::new_object(). If the compiler
+  // still decides to emit an uncommon trap for the allocation, the trap is
+  // taken before the object exists, so this is merely an optimization.
+  if (!cp().tag_at(index).is_resolved_klass()) {
+    return false;
+  }
+  JavaClass::Fast klass = cp().klass_at(index JVM_CHECK_0);
+  if (!klass().is_instance_class() || klass().is_abstract() ||
+      klass().is_interface()) {
+    return false;
+  }
+  InstanceClass::Fast instance_class = klass.obj();
+#if !ENABLE_ISOLATES
+  if (!instance_class().is_initialized()) {
+    return false;
+  }
+#endif
+#if !CROSS_GENERATOR
+  InstanceClass::Fast sender_class = _method->holder();
+  instance_class().check_access_by(&sender_class, ErrorOnFailure JVM_NO_CHECK);
+  if (CURRENT_HAS_PENDING_EXCEPTION) {
+    Thread::clear_current_pending_exception();
+    return false;
+  }
+#endif
+  return true;
+}
+
+bool EscapeAnalysis::is_vanilla_constructor_call(const int bci) const {
+  ConstantPool::Raw cp = _method->constants();
+  const int index = _method->get_java_ushort(bci + 1);
+
+  // Must take the BytecodeCompileClosure::direct_invoke() path, which
+  // simply pops the receiver of a vanilla constructor.
+  if (!cp().tag_at(index).is_resolved_static_method()) {
+    return false;
+  }
+  Method::Raw callee = cp().resolved_static_method_at(index);
+  if (callee().is_static() ||
+      !callee().match(Symbols::object_initializer_name(),
+                      Symbols::void_signature())) {
+    return false;
+  }
+  InstanceClass::Raw holder = callee().holder();
+#if !ENABLE_ISOLATES
+  if (!holder().is_initialized()) {
+    return false;
+  }
+#endif
+  return holder().has_vanilla_constructor();
+}
+
+bool EscapeAnalysis::putfield_value_words(const int bci, int& words
+                                          JVM_TRAPS) const {
+  BasicType type;
+  const Bytecodes::Code code = _method->bytecode_at(bci);
+  switch (code) {
+  case Bytecodes::_putfield: {
+    // The compiler must be able to resolve the field, otherwise it would
+    // generate an uncommon trap that executes the putfield on the NULL
+    // placeholder in the interpreter.
+    if (!ResolveConstantPoolInCompiler) {
+      return false;
+    }
+    int offset;
+    const bool resolved =
+      ((Method*)_method)->try_resolve_field_access(
+          _method->get_java_ushort(bci + 1), type, offset,
+          /*static=*/false, /*is_get=*/false JVM_CHECK_0);
+    if (!resolved) {
+      return false;
+    }
+    break;
+  }
+  case Bytecodes::_fast_lputfield:
+  case Bytecodes::_fast_dputfield:
+    type = T_LONG;
+    break;
+  default:
+    type = T_INT;
+    break;
+  }
+  words = is_two_word(type) ? 2 : 1;
+  return true;
+}
+
+bool EscapeAnalysis::is_local_read_outside(const int index,
+                                           const int region_start,
+                                           const int region_end) const {
+  const Method* const method = _method;
+  const int codesize = method->code_size();
+
+  for (int bci = 0; bci < codesize; bci += method->bytecode_length_for(bci)) {
+    if (bci >= region_start && bci < region_end) {
+      continue;
+    }
+    int loaded;
+    const Bytecodes::Code code = method->bytecode_at(bci);
+    switch (code) {
+    case Bytecodes::_aload:
+      loaded = method->get_ubyte(bci + 1);
+      break;
+    case Bytecodes::_aload_0:
+    case Bytecodes::_aload_1:
+    case Bytecodes::_aload_2:
+    case Bytecodes::_aload_3:
+      loaded = code - Bytecodes::_aload_0;
+      break;
+    case Bytecodes::_wide:
+      if (method->bytecode_at(bci + 1) != Bytecodes::_aload) {
+        continue;
+      }
+      loaded = method->get_java_ushort(bci + 2);
+      break;
+    default:
+      continue;
+    }
+    if (loaded == index) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ *
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+#if ENABLE_COMPILER
+
+// EscapeAnalysis is a conservative, intraprocedural pre-pass over the
+// bytecodes of a method that is about to be compiled (or inlined). For
+// every allocation site ("new") it tries to prove that the allocated
+// object never escapes the compiled method and that none of its fields
+// is ever read back.
+//
+// Such an object is only ever the receiver of a vanilla constructor and
+// of putfield bytecodes inside a single straight-line region that
+// contains no call, trap or exception point. The compiler then does not
+// allocate the object at all: its field values live (and die) in the
+// VirtualStackFrame, and a NULL placeholder takes the place of the
+// reference. Because the region has no deoptimization point, the
+// interpreter can never observe the placeholder, so no rematerialization
+// is required.
+//
+// The result is recorded in the bci_flags table of Method::Attributes:
+//
+//   Method::bci_allocation_eliminated   on the "new" bytecode
+//   Method::bci_store_to_eliminated     on every putfield into the object
+//
+// This is not scalar replacement: an object whose fields are read back
+// (getfield) is always allocated. The pass is off by default and is only
+// enabled with +UseEscapeAnalysis.
+
+class EscapeAnalysis : public StackObj {
+ public:
+  // Analyze all allocation sites in <method>. <entry_counts> and
+  // <bci_flags> are the tables produced by Method::compute_attributes().
+  static void analyze(const Method* method, const jubyte entry_counts[],
+                      jubyte bci_flags[] JVM_TRAPS);
+
+ private:
+  enum {
+    // The abstract operand stack and the tracked local variables are
+    // represented as bit masks, so only this many slots can be tracked.
+    max_tracked_slots = 32,
+    // Values that were on the stack before the allocation are not tracked,
+    // but may be consumed by bytecodes inside the region.
+    stack_bias = max_tracked_slots / 2,
+    // Maximum number of putfield bytecodes that can be removed for a
+    // single allocation site.
+    max_eliminated_stores = 16
+  };
+
+  EscapeAnalysis(const Method* method, const jubyte entry_counts[]) :
+    _method(method), _entry_counts(entry_counts) {}
+
+  // Returns true if the object allocated at <new_bci> can be eliminated.
+  // The bcis of the putfield bytecodes that store into the object are
+  // returned in <stores>.
+  bool is_eliminable(const int new_bci, int stores[], int& num_stores
+                     JVM_TRAPS);
+
+  // Helpers for checking the bytecodes that may consume the object.
+  bool is_eliminable_class(const int new_bci JVM_TRAPS) const;
+  bool is_vanilla_constructor_call(const int bci) const;
+  bool putfield_value_words(const int bci, int& words JVM_TRAPS) const;
+
+  // Returns true if the local <index> is loaded by any bytecode outside
+  // of the [region_start, region_end) range.
+  bool is_local_read_outside(const int index, const int region_start,
+                             const int region_end) const;
+
+  // Operations on the abstract operand stack.
+  bool push(const bool is_object);
+  bool pop(bool& is_object);
+  bool pop_words(const int words, bool& has_object);
+
+  const Method*  _method;
+  const jubyte*  _entry_counts;
+  juint          _stack;
+  int            _depth;
+  juint          _locals;
+};
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ *
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+#include "incls/_precompiled.incl"
+#include "incls/_PerfMap.cpp.incl"
+
+#if ENABLE_PERF_MAP && ENABLE_COMPILER
+
+FILE* PerfMap::_file = NULL;
+
+void PerfMap::initialize() {
+  if (!UsePerfMap || _file != NULL) {
+    return;
+  }
+  open();
+  if (_file == NULL) {
+    return;
+  }
+  write_all();
+}
+
+void PerfMap::dispose() {
+  if (_file != NULL) {
+    jvm_fflush(_file);
+    jvm_fclose(_file);
+    _file = NULL;
+  }
+}
+
+void PerfMap::open() {
+  const int pid = OsMisc_get_process_id();
+  if (pid < 0) {
+    return;
+  }
+  char file_name[64];
+  jvm_sprintf(file_name, "/tmp/perf-%d.map", pid);
+  _file = (FILE*)jvm_fopen(file_name, "w");
+  if (_file == NULL) {
+    tty->print_cr("Cannot open %s", file_name);
+  }
+}
+
+void PerfMap::write_all() {
+#if USE_COMPILER_GLUE_CODE
+  if (ObjectHeap::glue_code_size() > 0) {
+    write_entry(ObjectHeap::glue_code_start(), ObjectHeap::glue_code_size(),
+                "[compiler glue code]");
+  }
+#endif
+
+#if ENABLE_APPENDED_CALLINFO
+  for (unsigned int i = 0; i < _rom_compiled_methods_count; i++) {
+    write_compiled_method_entry(
+      (const CompiledMethodDesc*)_rom_compiled_methods[i], "[rom] ");
+  }
+#endif
+
+  const CompiledMethodDesc* p = (const CompiledMethodDesc*)_compiler_area_start;
+  const CompiledMethodDesc* const end =
+    (const CompiledMethodDesc*)_compiler_area_top;
+  for (; p < end; p = DERIVED(const CompiledMethodDesc*, p, p->object_size())) {
+    write_compiled_method_entry(p, "");
+  }
+}
+
+void PerfMap::write_compiled_method_entry(const CompiledMethodDesc* cm,
+                                          const char* prefix) {
+  // Build "<prefix><class>.<method>" from the original (non-renamed)
+  // names. Class names are kept in internal form ('/' separated).
+  enum { max_name_length = 256 };
+  char name[max_name_length];
+
+  Method::Raw method = cm->method();
+  InstanceClass::Raw holder = method().holder();
+  Symbol::Raw class_name = holder().original_name();
+  Symbol::Raw method_name = method().get_original_name();
+
+  jvm_snprintf(name, max_name_length, "%s%.*s.%.*s", prefix,
+               (int)class_name().length(), class_name().base_address(),
+               (int)method_name().length(), method_name().base_address());
+
+  write_entry((address)cm->entry(), cm->code_size(), name);
+}
+
+void PerfMap::write_entry(const address start, const size_t size,
+                          const char* name) {
+  jvm_fprintf(_file, "%lx %lx %s\n",
+              (unsigned long)start, (unsigned long)size, name);
+}
+
+#endif // ENABLE_PERF_MAP && ENABLE_COMPILER
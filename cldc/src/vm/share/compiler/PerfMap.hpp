@@ -0,0 +1,78 @@
+/*
+ *
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+#if ENABLE_PERF_MAP && ENABLE_COMPILER
+
+// PerfMap writes the location of dynamically generated code to
+// /tmp/perf-<pid>.map, in the format understood by the Linux "perf"
+// tool, so that samples in the compiler area are attributed to Java
+// methods instead of anonymous addresses:
+//
+//   <start address> <size> <symbol name>
+//
+// An entry is appended when a CompiledMethod is installed. Compiled
+// methods are only evicted or moved when the compiler area is compacted
+// or shifted, and after each such operation the entries of the whole
+// compiler area are appended again. The map is never rewritten, so it
+// also keeps the entries of code that has since moved, and a sample in
+// code that was moved may be attributed to an earlier occupant of the
+// same address. The map also describes the ROM compiled methods and the
+// compiler glue code copied into the heap.
+//
+// The file is buffered and only flushed by dispose(). The map is only
+// written when the VM is started with +UsePerfMap, on an OS port that
+// provides OsMisc_get_process_id().
+
+class PerfMap : public AllStatic {
+ public:
+  static void initialize();
+  static void dispose();
+
+  static void write_compiled_method(const CompiledMethodDesc* cm) {
+    if (_file != NULL) {
+      write_compiled_method_entry(cm, "");
+    }
+  }
+
+  // Called after compiled methods have been evicted or moved.
+  static void compiler_area_changed() {
+    if (_file != NULL) {
+      write_all();
+    }
+  }
+
+ private:
+  static void open();
+  static void write_all();
+  static void write_compiled_method_entry(const CompiledMethodDesc* cm,
+                                          const char* prefix);
+  static void write_entry(const address start, const size_t size,
+                          const char* name);
+
+  static FILE* _file;
+};
+
+#endif // ENABLE_PERF_MAP && ENABLE_COMPILER
@@ -0,0 +1,398 @@
+/*
+ *
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+
+#include "incls/_precompiled.incl"
+#include "incls/_StringConcat.cpp.incl"
+
+#if ENABLE_COMPILER
+
+int StringConcat::presized_capacity(const Method* method,
+                                    const int init_bci) {
+  if (!is_new_dup_init(method, init_bci)) {
+    return 0;
+  }
+
+  const int codesize = method->code_size();
+  // Length of the string constant loaded by the previous bytecode, or -1.
+  int constant_length = -1;
+  int capacity = 0;
+  // The only reference to the buffer is on the operand stack, below this
+  // many words. Every bytecode must leave it there, except for the
+  // append() calls on it, which return it again.
+  int above = 0;
+
+  int bci = method->next_bci(init_bci);
+  for (int n = 0; n < max_scanned_bytecodes && bci < codesize; n++) {
+    const Bytecodes::Code code = method->bytecode_at(bci);
+    int ldc_index = -1;
+    int popped = 0;
+    int pushed = 0;
+
+    switch (code) {
+    case Bytecodes::_ldc:
+#if ENABLE_JAVA_STACK_TAGS
+    case Bytecodes::_fast_ildc:
+    case Bytecodes::_fast_fldc:
+    case Bytecodes::_fast_aldc:
+#else
+    case Bytecodes::_fast_1_ldc:
+#endif
+      ldc_index = method->get_ubyte(bci + 1);
+      pushed = 1;
+      break;
+
+    case Bytecodes::_ldc_w:
+#if ENABLE_JAVA_STACK_TAGS
+    case Bytecodes::_fast_ildc_w:
+    case Bytecodes::_fast_fldc_w:
+    case Bytecodes::_fast_aldc_w:
+#else
+    case Bytecodes::_fast_1_ldc_w:
+#endif
+      ldc_index = method->get_java_ushort(bci + 1);
+      pushed = 1;
+      break;
+
+    case Bytecodes::_aconst_null:
+    case Bytecodes::_iconst_m1:
+    case Bytecodes::_iconst_0:
+    case Bytecodes::_iconst_1:
+    case Bytecodes::_iconst_2:
+    case Bytecodes::_iconst_3:
+    case Bytecodes::_iconst_4:
+    case Bytecodes::_iconst_5:
+    case Bytecodes::_fconst_0:
+    case Bytecodes::_fconst_1:
+    case Bytecodes::_fconst_2:
+    case Bytecodes::_bipush:
+    case Bytecodes::_sipush:
+    case Bytecodes::_iload:
+    case Bytecodes::_fload:
+    case Bytecodes::_aload:
+    case Bytecodes::_iload_0:
+    case Bytecodes::_iload_1:
+    case Bytecodes::_iload_2:
+    case Bytecodes::_iload_3:
+    case Bytecodes::_fload_0:
+    case Bytecodes::_fload_1:
+    case Bytecodes::_fload_2:
+    case Bytecodes::_fload_3:
+    case Bytecodes::_aload_0:
+    case Bytecodes::_aload_1:
+    case Bytecodes::_aload_2:
+    case Bytecodes::_aload_3:
+    case Bytecodes::_aload_0_fast_agetfield_1:
+    case Bytecodes::_aload_0_fast_igetfield_1:
+#if !ENABLE_CPU_VARIANT
+    case Bytecodes::_aload_0_fast_agetfield_4:
+    case Bytecodes::_aload_0_fast_igetfield_4:
+    case Bytecodes::_aload_0_fast_agetfield_8:
+    case Bytecodes::_aload_0_fast_igetfield_8:
+#endif
+      pushed = 1;
+      break;
+
+    case Bytecodes::_lconst_0:
+    case Bytecodes::_lconst_1:
+    case Bytecodes::_dconst_0:
+    case Bytecodes::_dconst_1:
+    case Bytecodes::_ldc2_w:
+#if ENABLE_JAVA_STACK_TAGS
+    case Bytecodes::_fast_lldc_w:
+    case Bytecodes::_fast_dldc_w:
+#else
+    case Bytecodes::_fast_2_ldc_w:
+#endif
+    case Bytecodes::_lload:
+    case Bytecodes::_dload:
+    case Bytecodes::_lload_0:
+    case Bytecodes::_lload_1:
+    case Bytecodes::_lload_2:
+    case Bytecodes::_lload_3:
+    case Bytecodes::_dload_0:
+    case Bytecodes::_dload_1:
+    case Bytecodes::_dload_2:
+    case Bytecodes::_dload_3:
+      pushed = 2;
+      break;
+
+    case Bytecodes::_iadd:
+    case Bytecodes::_isub:
+    case Bytecodes::_imul:
+    case Bytecodes::_idiv:
+    case Bytecodes::_irem:
+    case Bytecodes::_iand:
+    case Bytecodes::_ior:
+    case Bytecodes::_ixor:
+    case Bytecodes::_ishl:
+    case Bytecodes::_ishr:
+    case Bytecodes::_iushr:
+    case Bytecodes::_fadd:
+    case Bytecodes::_fsub:
+    case Bytecodes::_fmul:
+    case Bytecodes::_fdiv:
+    case Bytecodes::_frem:
+    case Bytecodes::_iaload:
+    case Bytecodes::_faload:
+    case Bytecodes::_aaload:
+    case Bytecodes::_baload:
+    case Bytecodes::_caload:
+    case Bytecodes::_saload:
+      popped = 2;
+      pushed = 1;
+      break;
+
+    case Bytecodes::_ladd:
+    case Bytecodes::_lsub:
+    case Bytecodes::_lmul:
+    case Bytecodes::_ldiv:
+    case Bytecodes::_lrem:
+    case Bytecodes::_land:
+    case Bytecodes::_lor:
+    case Bytecodes::_lxor:
+    case Bytecodes::_dadd:
+    case Bytecodes::_dsub:
+    case Bytecodes::_dmul:
+    case Bytecodes::_ddiv:
+    case Bytecodes::_drem:
+      popped = 4;
+      pushed = 2;
+      break;
+
+    case Bytecodes::_lshl:
+    case Bytecodes::_lshr:
+    case Bytecodes::_lushr:
+      popped = 3;
+      pushed = 2;
+      break;
+
+    case Bytecodes::_ineg:
+    case Bytecodes::_fneg:
+    case Bytecodes::_i2f:
+    case Bytecodes::_f2i:
+    case Bytecodes::_i2b:
+    case Bytecodes::_i2c:
+    case Bytecodes::_i2s:
+    case Bytecodes::_arraylength:
+    case Bytecodes::_fast_bgetfield:
+    case Bytecodes::_fast_sgetfield:
+    case Bytecodes::_fast_igetfield:
+    case Bytecodes::_fast_fgetfield:
+    case Bytecodes::_fast_agetfield:
+    case Bytecodes::_fast_cgetfield:
+    case Bytecodes::_fast_igetfield_1:
+    case Bytecodes::_fast_agetfield_1:
+      popped = 1;
+      pushed = 1;
+      break;
+
+    case Bytecodes::_i2l:
+    case Bytecodes::_i2d:
+    case Bytecodes::_f2l:
+    case Bytecodes::_f2d:
+    case Bytecodes::_fast_lgetfield:
+    case Bytecodes::_fast_dgetfield:
+      popped = 1;
+      pushed = 2;
+      break;
+
+    case Bytecodes::_lneg:
+    case Bytecodes::_dneg:
+    case Bytecodes::_l2d:
+    case Bytecodes::_d2l:
+    case Bytecodes::_laload:
+    case Bytecodes::_daload:
+      popped = 2;
+      pushed = 2;
+      break;
+
+    case Bytecodes::_l2i:
+    case Bytecodes::_l2f:
+    case Bytecodes::_d2i:
+    case Bytecodes::_d2f:
+      popped = 2;
+      pushed = 1;
+      break;
+
+    case Bytecodes::_dup:
+      popped = 1;
+      pushed = 2;
+      break;
+
+    case Bytecodes::_getfield:
+    case Bytecodes::_getstatic: {
+      ConstantPool::Raw cp = method->constants();
+      const int index = method->get_java_ushort(bci + 1);
+      const ConstantTag tag = cp().tag_at(index);
+      const bool is_static = (code == Bytecodes::_getstatic);
+      if (!tag.is_resolved_field() ||
+          tag.is_resolved_static_field() != is_static) {
+        return 0;
+      }
+      popped = is_static ? 0 : 1;
+      pushed = word_size_for(tag.resolved_field_type());
+      break;
+    }
+
+    case Bytecodes::_invokevirtual:
+    case Bytecodes::_fast_invokevirtual:
+    case Bytecodes::_fast_invokevirtual_final:
+    case Bytecodes::_invokestatic:
+    case Bytecodes::_fast_invokestatic:
+    case Bytecodes::_fast_init_invokestatic: {
+      Method::Raw callee = resolved_callee(method, bci);
+      if (callee.is_null()) {
+        return 0;
+      }
+      popped = callee().size_of_parameters();
+      Signature::Raw signature = callee().signature();
+      pushed = word_size_for(signature().return_type());
+
+      InstanceClass::Raw holder = callee().holder();
+      Symbol::Raw holder_name = holder().name();
+      if (callee().is_static() ||
+          !holder_name().equals(Symbols::java_lang_StringBuffer())) {
+        // Computes an argument of the next append(). It must not take
+        // the buffer as an argument (checked below).
+        break;
+      }
+      if (popped != above + 1) {
+        // Called on a different StringBuffer.
+        return 0;
+      }
+      Symbol::Raw name = callee().name();
+      if (name().equals(Symbols::to_string_name())) {
+        if (capacity <= default_capacity) {
+          return 0;
+        }
+        return capacity < max_capacity ? capacity : max_capacity;
+      }
+      if (!name().equals(Symbols::append_name())) {
+        // insert(), setLength(), etc.
+        return 0;
+      }
+      SignatureStream ss(&signature, true /*is_static*/, true /*fast*/);
+      const BasicType type = ss.type();
+      if ((type == T_OBJECT || type == T_ARRAY) && constant_length >= 0) {
+        capacity += constant_length;
+      } else {
+        capacity += appended_length(type);
+      }
+      // append() returns the buffer itself.
+      above = 0;
+      popped = pushed = 0;
+      break;
+    }
+
+    default:
+      // Anything else may store, pass or drop the buffer, or the chain
+      // does not end in this basic block. Keep it simple.
+      return 0;
+    }
+
+    if (popped > above) {
+      return 0;
+    }
+    above += pushed - popped;
+
+    constant_length = -1;
+    if (ldc_index >= 0) {
+      ConstantPool::Raw cp = method->constants();
+      if (cp().tag_at(ldc_index).is_string()) {
+        String::Raw str = cp().resolved_string_at(ldc_index);
+        constant_length = str().length();
+      }
+    }
+    bci = method->next_bci(bci);
+  }
+
+  return 0;
+}
+
+bool StringConcat::is_new_dup_init(const Method* method, const int init_bci) {
+  int new_bci = -1;
+  int dup_bci = -1;
+  for (int bci = 0; bci < init_bci; bci = method->next_bci(bci)) {
+    new_bci = dup_bci;
+    dup_bci = bci;
+  }
+  if (new_bci < 0 || method->bytecode_at(dup_bci) != Bytecodes::_dup) {
+    return false;
+  }
+  switch (method->bytecode_at(new_bci)) {
+  case Bytecodes::_new:
+  case Bytecodes::_fast_new:
+  case Bytecodes::_fast_init_new:
+    return true;
+  default:
+    return false;
+  }
+}
+
+ReturnOop StringConcat::resolved_callee(const Method* method,
+                                        const int bci) {
+  ConstantPool::Raw cp = method->constants();
+  const int index = method->get_java_ushort(bci + 1);
+  const ConstantTag tag = cp().tag_at(index);
+
+  // StringBuffer is final, so its methods are usually resolved as
+  // static (final) methods.
+  if (tag.is_resolved_static_method()) {
+    return cp().resolved_static_method_at(index);
+  }
+  if (tag.is_resolved_virtual_method()) {
+    int vtable_index;
+    int class_id;
+    cp().resolved_virtual_method_at(index, vtable_index, class_id);
+    JavaClass::Raw klass = Universe::class_from_id(class_id);
+    ClassInfo::Raw info = klass().class_info();
+    return info().vtable_method_at(vtable_index);
+  }
+  return NULL;
+}
+
+int StringConcat::appended_length(const BasicType type) {
+  switch (type) {
+  case T_CHAR:
+    return 1;
+  case T_BOOLEAN:
+    return 5;           // "false"
+  case T_BYTE:
+  case T_SHORT:
+  case T_INT:
+    return 11;          // "-2147483648"
+  case T_LONG:
+    return 20;          // "-9223372036854775808"
+  case T_FLOAT:
+  case T_DOUBLE:
+    return 16;
+  default:
+    return unknown_length;
+  }
+}
+
+#endif
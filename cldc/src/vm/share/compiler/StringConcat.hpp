@@ -0,0 +1,88 @@
+/*
+ *
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+
+#if ENABLE_COMPILER
+
+// StringConcat recognizes the code that javac generates for string
+// concatenation,
+//
+//   new StringBuffer; dup; invokespecial StringBuffer.<init>()V
+//   ... invokevirtual StringBuffer.append(..) ...
+//   invokevirtual StringBuffer.toString()
+//
+// and estimates the length of the result from the types of the appended
+// values and the lengths of constant strings. The compiler then calls
+// StringBuffer.<init>(I)V with that capacity instead of the default
+// constructor, so the buffer does not have to grow (and copy its
+// contents) while the chain runs. toString() shares the final buffer
+// with the String, so a correctly sized chain allocates exactly one
+// character array.
+//
+// The scan follows the operand stack word by word and gives up as soon
+// as the buffer might be stored, duplicated, passed to a method other
+// than its own append(), or left behind by a branch. It also checks that
+// the constructor was invoked right after "new; dup", so the stack holds
+// the only reference to the buffer. toString() is then known to be
+// called on the presized buffer, which never escapes the expression.
+//
+// The bytecodes are not changed and the interpreter is not involved, so
+// no deoptimization support is needed. The estimate can still be too
+// high (every Object counts as unknown_length), and since toString()
+// shares the buffer, the String keeps the unused capacity. max_capacity
+// limits that waste.
+
+class StringConcat : public AllStatic {
+ public:
+  // Returns the capacity to use for the StringBuffer whose default
+  // constructor is invoked at <init_bci> of <method>, or 0 if the
+  // default capacity should be used.
+  static int presized_capacity(const Method* method, const int init_bci);
+
+ private:
+  enum {
+    // Concatenations are short; don't look further than this.
+    max_scanned_bytecodes = 64,
+    default_capacity = 16,
+    max_capacity = 256,
+    // Estimated length of an Object, array or non-constant String.
+    unknown_length = 16
+  };
+
+  // Returns true if the constructor invoked at <init_bci> follows
+  // "new; dup", as in the code that javac generates.
+  static bool is_new_dup_init(const Method* method, const int init_bci);
+
+  // Returns the method invoked at <bci>, or NULL if the invoke is not
+  // resolved yet.
+  static ReturnOop resolved_callee(const Method* method, const int bci);
+
+  // Returns the estimated number of characters appended by
+  // StringBuffer.append(<type>).
+  static int appended_length(const BasicType type);
+};
+
+#endif
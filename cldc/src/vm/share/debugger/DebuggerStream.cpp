@@ -273,6 +273,10 @@ PacketOutputStream::write_string(String *s)
     t = Universe::new_char_array(0 JVM_NO_CHECK);
     unilen = 0;
     offset = 0;
+  } else if (s->is_latin1()) {
+    t = s->to_char_array(JVM_SINGLE_ARG_NO_CHECK);
+    unilen = s->length();
+    offset = 0;
   } else {
     t = s->value();
     unilen = s->length();
@@ -728,9 +728,8 @@ void StringReferenceImpl::string_reference_value(PacketInputStream *in,
   if (TraceDebugger) {
     tty->print("String: stringID=%ld, string=0x%lx, value = ", 
                   JavaDebugger::get_object_id_by_ref_nocreate(&s), s.obj());
-    TypeArray::Raw t = s().value();
     for (int i = 0; i < s().count(); i++) {
-      tty->print("%c", (char)t().char_at(i + s().offset()));
+      tty->print("%c", (char)s().char_at(i));
     }
     tty->print_cr("");
   }
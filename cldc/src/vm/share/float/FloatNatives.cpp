@@ -29,47 +29,104 @@
 
 #if ENABLE_FLOAT
 
+// With ENABLE_HOSTED_LIBM, sqrt, ceil, floor and fabs always come from the
+// C library: IEEE 754 defines their results exactly, so they are the same
+// as those of the software routines, only faster. The C library's
+// transcendental functions are not required to be within the 1 ulp that
+// java.lang.Math allows, and nothing checks that they are, so by default
+// the transcendentals use fdlibm and give the results of StrictMath. They
+// can be switched to the C library with +UseHostedLibmTranscendentals on
+// a target whose C library is known to be accurate enough.
+
 extern "C" {
 
 JVM_SOFTFP_LINKAGE jdouble jvm_sin(jdouble x) {
+#if ENABLE_HOSTED_LIBM
+  if (UseHostedLibmTranscendentals) {
+    return ::sin(x);
+  }
+#endif
   return jvm_fplib_sin(x);
 }
 
 JVM_SOFTFP_LINKAGE jdouble jvm_cos(jdouble x) {
+#if ENABLE_HOSTED_LIBM
+  if (UseHostedLibmTranscendentals) {
+    return ::cos(x);
+  }
+#endif
   return jvm_fplib_cos(x);
 }
 
 JVM_SOFTFP_LINKAGE jdouble jvm_tan(jdouble x) {
+#if ENABLE_HOSTED_LIBM
+  if (UseHostedLibmTranscendentals) {
+    return ::tan(x);
+  }
+#endif
   return jvm_fplib_tan(x);
 }
 
 JVM_SOFTFP_LINKAGE jdouble jvm_sqrt(jdouble x) {
+#if ENABLE_HOSTED_LIBM
+  return ::sqrt(x);
+#else
   return ieee754_sqrt(x);
+#endif
 }
 
 JVM_SOFTFP_LINKAGE jdouble jvm_ceil(jdouble x) {
+#if ENABLE_HOSTED_LIBM
+  return ::ceil(x);
+#else
   return jvm_fplib_ceil(x);
+#endif
 }
 
 JVM_SOFTFP_LINKAGE jdouble jvm_floor(jdouble x) {
+#if ENABLE_HOSTED_LIBM
+  return ::floor(x);
+#else
   return jvm_fplib_floor(x);
+#endif
 }
 
 #if ENABLE_CLDC_111 || ENABLE_EXTENDED_API
 
 JVM_SOFTFP_LINKAGE jdouble jvm_asin(jdouble x) {
+#if ENABLE_HOSTED_LIBM
+  if (UseHostedLibmTranscendentals) {
+    return ::asin(x);
+  }
+#endif
   return jvm_fplib_asin(x);
 }
 
 JVM_SOFTFP_LINKAGE jdouble jvm_acos(jdouble x) {
+#if ENABLE_HOSTED_LIBM
+  if (UseHostedLibmTranscendentals) {
+    return ::acos(x);
+  }
+#endif
   return jvm_fplib_acos(x);
 }
 
 JVM_SOFTFP_LINKAGE jdouble jvm_atan(jdouble x) {
+#if ENABLE_HOSTED_LIBM
+  if (UseHostedLibmTranscendentals) {
+    return ::atan(x);
+  }
+#endif
   return jvm_fplib_atan(x);
 }
 
 JVM_SOFTFP_LINKAGE jdouble jvm_atan2(jdouble x, jdouble y) {
+#if ENABLE_HOSTED_LIBM
+  if (UseHostedLibmTranscendentals) {
+    // Note the order: the C library takes the y coordinate first.
+    return ::atan2(y, x);
+  }
+#endif
   return jvm_fplib_atan2(x, y);
 }
 
@@ -79,7 +136,11 @@ JVM_SOFTFP_LINKAGE jdouble jvm_atan2(jdouble x, jdouble y) {
 // takes a *double*. Incidentally, the version that takes in a *float* is named
 // fabsf().
 JVM_SOFTFP_LINKAGE jdouble jvm_fabs(jdouble x) {
+#if ENABLE_HOSTED_LIBM
+  return ::fabs(x);
+#else
   return jvm_fplib_fabs(x);
+#endif
 }
 
 JVM_SOFTFP_LINKAGE jint jvm_floatToIntBits(jfloat x) {
@@ -131,6 +192,59 @@ KNI_RETURNTYPE_DOUBLE Java_java_lang_Double_longBitsToDouble() {
 jlong Java_java_lang_Double_doubleToLongBits() {
   return jvm_doubleToLongBits(KNI_GetParameterAsDouble(1));
 }
+
+ReturnOop Java_java_lang_FloatingDecimal_doubleToString(JVM_SINGLE_ARG_TRAPS) {
+  char buffer[FloatingDecimal::max_chars];
+  const int length =
+      FloatingDecimal::double_to_chars(KNI_GetParameterAsDouble(1), buffer);
+  return Universe::new_string(buffer, length JVM_NO_CHECK_AT_BOTTOM);
+}
+
+ReturnOop Java_java_lang_FloatingDecimal_floatToString(JVM_SINGLE_ARG_TRAPS) {
+  char buffer[FloatingDecimal::max_chars];
+  const int length =
+      FloatingDecimal::float_to_chars(KNI_GetParameterAsFloat(1), buffer);
+  return Universe::new_string(buffer, length JVM_NO_CHECK_AT_BOTTOM);
+}
+
+// Copies the String parameter into <buffer>. Returns -1 if the parameter
+// is null or too long for the native parser.
+static int parse_parameter(jchar buffer[]) {
+  String::Raw str = GET_PARAMETER_AS_OOP(1);
+  if (str.is_null()) {
+    return -1;
+  }
+  const int length = str().length();
+  if (length > FloatingDecimal::max_parse_length) {
+    return -1;
+  }
+  str().get_chars(buffer, 0, length);
+  return length;
+}
+
+// The parse natives return the bits of the result, or a NaN with a
+// non-canonical payload (which no parsed value can have) to tell
+// FloatingDecimal.java to take its slow path.
+jlong Java_java_lang_FloatingDecimal_parseDoubleBits() {
+  jchar buffer[FloatingDecimal::max_parse_length];
+  jdouble result;
+  const int length = parse_parameter(buffer);
+  if (length < 0 ||
+      !FloatingDecimal::parse_double(buffer, length, result)) {
+    return JVM_LL(0x7ff8000000000001);
+  }
+  return double_bits(result);
+}
+
+jint Java_java_lang_FloatingDecimal_parseFloatBits() {
+  jchar buffer[FloatingDecimal::max_parse_length];
+  jfloat result;
+  const int length = parse_parameter(buffer);
+  if (length < 0 || !FloatingDecimal::parse_float(buffer, length, result)) {
+    return 0x7fc00001;
+  }
+  return float_bits(result);
+}
 } // extern C
 
 #endif // ENABLE_FLOAT
@@ -0,0 +1,1200 @@
+/*
+ *   
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ * 
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ * 
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+
+#include "incls/_precompiled.incl"
+#include "incls/_FloatingDecimal.cpp.incl"
+
+#if ENABLE_FLOAT
+
+// IEEE 754 constants, named as in java.lang.FloatingDecimal.
+static const jlong sign_mask   = JVM_ULL(0x8000000000000000);
+static const jlong exp_mask    = JVM_LL(0x7ff0000000000000);
+static const jlong fract_mask  = JVM_LL(0x000fffffffffffff);
+static const int   exp_shift   = 52;
+static const int   exp_bias    = 1023;
+static const jlong fract_hob   = JVM_LL(1) << exp_shift;
+static const jlong exp_one     = ((jlong)exp_bias) << exp_shift;
+static const int   max_small_bin_exp = 62;
+static const int   min_small_bin_exp = -(63 / 3);
+
+static const jint  single_sign_mask  = (jint)0x80000000;
+static const jint  single_exp_mask   = 0x7f800000;
+static const jint  single_fract_mask = 0x007fffff;
+static const int   single_exp_shift  = 23;
+static const jint  single_fract_hob  = 1 << single_exp_shift;
+static const int   single_exp_bias   = 127;
+
+static const jint small5pow[] = {
+  1,
+  5,
+  5*5,
+  5*5*5,
+  5*5*5*5,
+  5*5*5*5*5,
+  5*5*5*5*5*5,
+  5*5*5*5*5*5*5,
+  5*5*5*5*5*5*5*5,
+  5*5*5*5*5*5*5*5*5,
+  5*5*5*5*5*5*5*5*5*5,
+  5*5*5*5*5*5*5*5*5*5*5,
+  5*5*5*5*5*5*5*5*5*5*5*5,
+  5*5*5*5*5*5*5*5*5*5*5*5*5
+};
+
+static const jlong long5pow[] = {
+  JVM_LL(1),
+  JVM_LL(5),
+  JVM_LL(25),
+  JVM_LL(125),
+  JVM_LL(625),
+  JVM_LL(3125),
+  JVM_LL(15625),
+  JVM_LL(78125),
+  JVM_LL(390625),
+  JVM_LL(1953125),
+  JVM_LL(9765625),
+  JVM_LL(48828125),
+  JVM_LL(244140625),
+  JVM_LL(1220703125),
+  JVM_LL(6103515625),
+  JVM_LL(30517578125),
+  JVM_LL(152587890625),
+  JVM_LL(762939453125),
+  JVM_LL(3814697265625),
+  JVM_LL(19073486328125),
+  JVM_LL(95367431640625),
+  JVM_LL(476837158203125),
+  JVM_LL(2384185791015625),
+  JVM_LL(11920928955078125),
+  JVM_LL(59604644775390625),
+  JVM_LL(298023223876953125),
+  JVM_LL(1490116119384765625)
+};
+
+// Number of bits needed to represent 5^i.
+static const int n5bits[] = {
+   0,  3,  5,  7, 10, 12, 14, 17, 19, 21, 24, 26, 28, 31,
+  33, 35, 38, 40, 42, 45, 47, 49, 52, 54, 56, 59, 61
+};
+
+static const int long5pow_length = sizeof(long5pow) / sizeof(long5pow[0]);
+static const int n5bits_length = sizeof(n5bits) / sizeof(n5bits[0]);
+
+// Java arithmetic wraps around on overflow, and the digit loops of
+// dtoa() depend on that exactly like the Java code does. The operations
+// that may overflow are therefore done on unsigned values.
+inline static jint java_imul(jint a, jint b) {
+  return (jint)((juint)a * (juint)b);
+}
+inline static jint java_iadd(jint a, jint b) {
+  return (jint)((juint)a + (juint)b);
+}
+inline static jint java_isub(jint a, jint b) {
+  return (jint)((juint)a - (juint)b);
+}
+inline static jint java_ishl(jint a, int n) {
+  return (jint)((juint)a << (n & 31));
+}
+inline static jlong java_lmul(jlong a, jlong b) {
+  return (jlong)((julong)a * (julong)b);
+}
+inline static jlong java_ladd(jlong a, jlong b) {
+  return (jlong)((julong)a + (julong)b);
+}
+inline static jlong java_lsub(jlong a, jlong b) {
+  return (jlong)((julong)a - (julong)b);
+}
+inline static jlong java_lshl(jlong a, int n) {
+  return (jlong)((julong)a << (n & 63));
+}
+inline static jlong java_lushr(jlong a, int n) {
+  return (jlong)((julong)a >> (n & 63));
+}
+
+// The decimal digits developed by dtoa(), i.e. the fields of a
+// java.lang.FloatingDecimal object.
+class FloatingDecimal::Digits {
+ public:
+  bool is_negative;
+  bool is_exceptional;
+  int  dec_exponent;
+  int  n_digits;
+  char digits[20];
+
+  // Add one to the least significant digit and propagate the carry.
+  void roundup() {
+    int i = n_digits - 1;
+    char q = digits[i];
+    if (q == '9') {
+      while (q == '9' && i > 0) {
+        digits[i] = '0';
+        q = digits[--i];
+      }
+      if (q == '9') {
+        // Carry out: high-order 1, rest 0s, larger exponent.
+        dec_exponent += 1;
+        digits[0] = '1';
+        return;
+      }
+    }
+    digits[i] = (char)(q + 1);
+  }
+};
+
+// A non-negative integer large enough for the B, S and M values of
+// dtoa(). The largest of them (for Double.MAX_VALUE and the smallest
+// denormals) need about 760 bits.
+class FloatingDecimal::BigInt {
+ public:
+  enum { max_words = 32 };
+
+  void set(julong value) {
+    _data[0] = (juint)value;
+    _data[1] = (juint)(value >> 32);
+    _n_words = (_data[1] != 0) ? 2 : 1;
+  }
+
+  void mult(juint factor) {
+    julong carry = 0;
+    for (int i = 0; i < _n_words; i++) {
+      carry += (julong)_data[i] * factor;
+      _data[i] = (juint)carry;
+      carry >>= 32;
+    }
+    if (carry != 0) {
+      GUARANTEE(_n_words < max_words, "BigInt overflow");
+      _data[_n_words++] = (juint)carry;
+    }
+  }
+
+  // this *= 5^p5 * 2^p2
+  void mult_pow52(int p5, int p2) {
+    const int max_small_power = sizeof(small5pow) / sizeof(small5pow[0]) - 1;
+    for (; p5 > max_small_power; p5 -= max_small_power) {
+      mult(small5pow[max_small_power]);
+    }
+    if (p5 > 0) {
+      mult(small5pow[p5]);
+    }
+    lshift(p2);
+  }
+
+  void lshift(int shift) {
+    if (shift <= 0) {
+      return;
+    }
+    const int word_shift = shift >> 5;
+    const int bit_shift = shift & 31;
+    int n = _n_words + word_shift;
+    GUARANTEE(n < max_words, "BigInt overflow");
+    _data[n] = 0;
+    for (int i = _n_words - 1; i >= 0; i--) {
+      if (bit_shift != 0) {
+        _data[i + word_shift + 1] |= _data[i] >> (32 - bit_shift);
+        _data[i + word_shift] = _data[i] << bit_shift;
+      } else {
+        _data[i + word_shift] = _data[i];
+      }
+    }
+    for (int j = 0; j < word_shift; j++) {
+      _data[j] = 0;
+    }
+    _n_words = (_data[n] != 0) ? n + 1 : n;
+  }
+
+  // q = this / s, this = 10 * (this % s), return q. q must be < 10.
+  int quo_rem_iteration(const BigInt& s) {
+    int q = 0;
+    while (compare(*this, s) >= 0) {
+      subtract(s);
+      q++;
+    }
+    GUARANTEE(q < 10, "excessively large digit");
+    mult(10);
+    return q;
+  }
+
+  static int compare(const BigInt& a, const BigInt& b) {
+    if (a._n_words != b._n_words) {
+      return (a._n_words > b._n_words) ? 1 : -1;
+    }
+    for (int i = a._n_words - 1; i >= 0; i--) {
+      if (a._data[i] != b._data[i]) {
+        return (a._data[i] > b._data[i]) ? 1 : -1;
+      }
+    }
+    return 0;
+  }
+
+  // Compare a + b with c.
+  static int compare_sum(const BigInt& a, const BigInt& b, const BigInt& c) {
+    BigInt sum;
+    const int n = max(a._n_words, b._n_words);
+    julong carry = 0;
+    for (int i = 0; i < n; i++) {
+      carry += (julong)a.word(i) + b.word(i);
+      sum._data[i] = (juint)carry;
+      carry >>= 32;
+    }
+    sum._n_words = n;
+    if (carry != 0) {
+      GUARANTEE(n < max_words, "BigInt overflow");
+      sum._data[sum._n_words++] = (juint)carry;
+    }
+    return compare(sum, c);
+  }
+
+ private:
+  juint word(int i) const {
+    return (i < _n_words) ? _data[i] : 0;
+  }
+
+  // this -= s, where s <= this.
+  void subtract(const BigInt& s) {
+    jlong borrow = 0;
+    for (int i = 0; i < _n_words; i++) {
+      borrow += (jlong)_data[i] - s.word(i);
+      _data[i] = (juint)borrow;
+      borrow >>= 32;
+    }
+    while (_n_words > 1 && _data[_n_words - 1] == 0) {
+      _n_words--;
+    }
+  }
+
+  int   _n_words;
+  juint _data[max_words];
+};
+
+// Number of bits from the high-order 1 bit to the low-order 1 bit,
+// inclusive.
+int FloatingDecimal::count_bits(jlong v) {
+  julong bits = (julong)v;
+  if (bits == 0) {
+    return 0;
+  }
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+  }
+  int n = 0;
+  while (bits != 0) {
+    bits >>= 1;
+    n++;
+  }
+  return n;
+}
+
+// The easy subcase of dtoa(): all the significant bits, after scaling,
+// are held in <lvalue>.
+void FloatingDecimal::develop_long_digits(Digits& d, int dec_exponent,
+                                          jlong lvalue,
+                                          jlong insignificant) {
+  // Discard non-significant low-order bits, while rounding, up to the
+  // insignificant value.
+  int i;
+  for (i = 0; insignificant >= 10; i++) {
+    insignificant /= 10;
+  }
+  if (i != 0) {
+    const jlong pow10 = long5pow[i] << i; // 10^i == 5^i * 2^i
+    const jlong residue = lvalue % pow10;
+    lvalue /= pow10;
+    dec_exponent += i;
+    if (residue >= (pow10 >> 1)) {
+      // Round up based on the low-order bits we're discarding.
+      lvalue++;
+    }
+  }
+  GUARANTEE(lvalue > 0, "value <= 0");
+
+  // The digits are developed from the end of the buffer, and trailing
+  // zeros are dropped.
+  char* const buffer = d.digits;
+  const int buffer_size = sizeof(d.digits);
+  int digitno = buffer_size - 1;
+  int c = (int)(lvalue % 10);
+  lvalue /= 10;
+  while (c == 0) {
+    dec_exponent++;
+    c = (int)(lvalue % 10);
+    lvalue /= 10;
+  }
+  while (lvalue != 0) {
+    buffer[digitno--] = (char)(c + '0');
+    dec_exponent++;
+    c = (int)(lvalue % 10);
+    lvalue /= 10;
+  }
+  buffer[digitno] = (char)(c + '0');
+
+  const int ndigits = buffer_size - digitno;
+  jvm_memmove(buffer, buffer + digitno, ndigits);
+  d.dec_exponent = dec_exponent + 1;
+  d.n_digits = ndigits;
+}
+
+void FloatingDecimal::dtoa(Digits& d, int bin_exp, jlong fract_bits,
+                           int n_significant_bits) {
+  // Examine the number. Determine if it is an easy case, which we can do
+  // pretty trivially using long conversion, or whether we must do real
+  // work.
+  const int n_fract_bits = count_bits(fract_bits);
+  const int n_tiny_bits = max(0, n_fract_bits - bin_exp - 1);
+  if (bin_exp <= max_small_bin_exp && bin_exp >= min_small_bin_exp) {
+    // Look more closely at the number to decide if, with scaling by
+    // 10^n_tiny_bits, the result will fit in a long.
+    if (n_tiny_bits < long5pow_length &&
+        n_fract_bits + n5bits[n_tiny_bits] < 64 && n_tiny_bits == 0) {
+      // Shift left or right appropriately to align the binary point at
+      // the extreme right. (As in the Java code, the n_tiny_bits > 0
+      // case is not used because it prints excess digits for floats.)
+      jlong half_ulp;
+      if (bin_exp > n_significant_bits) {
+        half_ulp = JVM_LL(1) << (bin_exp - n_significant_bits - 1);
+      } else {
+        half_ulp = 0;
+      }
+      if (bin_exp >= exp_shift) {
+        fract_bits = java_lshl(fract_bits, bin_exp - exp_shift);
+      } else {
+        fract_bits = java_lushr(fract_bits, exp_shift - bin_exp);
+      }
+      develop_long_digits(d, 0, fract_bits, half_ulp);
+      return;
+    }
+  }
+
+  // This is the hard case. We compute large positive integers B and S
+  // and integer dec_exp, such that
+  //   d = (B / S) * 10^dec_exp
+  //   1 <= B / S < 10
+  // and M, (1/2) of the ULP of d scaled like B. The digits are the
+  // quotients of B / S, and we stop when the remainder is <= M.
+  //
+  // The decimal exponent is estimated from the mantissa scaled to
+  // 1 <= d2 < 2, with the same floating-point operations as the Java
+  // code so that the estimate is identical.
+  const jdouble d2 = double_from_bits(exp_one | (fract_bits & ~fract_hob));
+  int dec_exp = jvm_d2i(jvm_floor(
+      jvm_dadd(jvm_dadd(jvm_dmul(jvm_dsub(d2, 1.5), 0.289529654),
+                        0.176091259),
+               jvm_dmul(jvm_i2d(bin_exp), 0.301029995663981))));
+
+  const int B5 = max(0, -dec_exp);
+  int B2 = B5 + n_tiny_bits + bin_exp;
+  const int S5 = max(0, dec_exp);
+  int S2 = S5 + n_tiny_bits;
+  const int M5 = B5;
+  int M2 = B2 - n_significant_bits;
+
+  // Shift out the trailing zeros of the mantissa.
+  fract_bits = java_lushr(fract_bits, exp_shift + 1 - n_fract_bits);
+  B2 -= n_fract_bits - 1;
+  const int common2factor = min(B2, S2);
+  B2 -= common2factor;
+  S2 -= common2factor;
+  M2 -= common2factor;
+
+  // For exact powers of two, the next smallest number is only half as far
+  // away as we think.
+  if (n_fract_bits == 1) {
+    M2 -= 1;
+  }
+  if (M2 < 0) {
+    // We cannot scale M down far enough, so scale the others up.
+    B2 -= M2;
+    S2 -= M2;
+    M2 = 0;
+  }
+
+  char* const digits = d.digits;
+  int ndigit = 0;
+  bool low, high;
+  jlong low_digit_difference;
+  int q;
+
+  // Use int or long arithmetic when all the numbers fit.
+  const int Bbits = n_fract_bits + B2 +
+      ((B5 < n5bits_length) ? n5bits[B5] : (B5 * 3));
+  const int ten_s_bits = S2 + 1 +
+      (((S5 + 1) < n5bits_length) ? n5bits[S5 + 1] : ((S5 + 1) * 3));
+  if (Bbits < 64 && ten_s_bits < 64) {
+    if (Bbits < 32 && ten_s_bits < 32) {
+      jint b = java_ishl(java_imul((jint)fract_bits, small5pow[B5]), B2);
+      const jint s = java_ishl(small5pow[S5], S2);
+      jint m = java_ishl(small5pow[M5], M2);
+      const jint tens = java_imul(s, 10);
+
+      // Unroll the first iteration. If our dec_exp estimate was too high,
+      // our first quotient will be zero. In this case, we discard it and
+      // decrement dec_exp.
+      q = b / s;
+      b = java_imul(10, b % s);
+      m = java_imul(m, 10);
+      low  = (b < m);
+      high = (java_iadd(b, m) > tens);
+      GUARANTEE(q < 10, "excessively large digit");
+      if (q == 0 && !high) {
+        dec_exp--;
+      } else {
+        digits[ndigit++] = (char)('0' + q);
+      }
+      // The Java format always has at least one digit after the point,
+      // so the E-form needs more than one digit.
+      if (dec_exp <= -3 || dec_exp >= 8) {
+        high = low = false;
+      }
+      while (!low && !high) {
+        q = b / s;
+        b = java_imul(10, b % s);
+        m = java_imul(m, 10);
+        GUARANTEE(q < 10, "excessively large digit");
+        if (m > 0) {
+          low  = (b < m);
+          high = (java_iadd(b, m) > tens);
+        } else {
+          // m overflowed, so it is certainly > b, and b + m > tens.
+          low = true;
+          high = true;
+        }
+        digits[ndigit++] = (char)('0' + q);
+      }
+      low_digit_difference = java_isub(java_ishl(b, 1), tens);
+    } else {
+      jlong b = java_lshl(java_lmul(fract_bits, long5pow[B5]), B2);
+      const jlong s = java_lshl(long5pow[S5], S2);
+      jlong m = java_lshl(long5pow[M5], M2);
+      const jlong tens = java_lmul(s, 10);
+
+      q = (int)(b / s);
+      b = java_lmul(10, b % s);
+      m = java_lmul(m, 10);
+      low  = (b < m);
+      high = (java_ladd(b, m) > tens);
+      GUARANTEE(q < 10, "excessively large digit");
+      if (q == 0 && !high) {
+        dec_exp--;
+      } else {
+        digits[ndigit++] = (char)('0' + q);
+      }
+      if (dec_exp <= -3 || dec_exp >= 8) {
+        high = low = false;
+      }
+      while (!low && !high) {
+        q = (int)(b / s);
+        b = java_lmul(10, b % s);
+        m = java_lmul(m, 10);
+        GUARANTEE(q < 10, "excessively large digit");
+        if (m > 0) {
+          low  = (b < m);
+          high = (java_ladd(b, m) > tens);
+        } else {
+          low = true;
+          high = true;
+        }
+        digits[ndigit++] = (char)('0' + q);
+      }
+      low_digit_difference = java_lsub(java_lshl(b, 1), tens);
+    }
+  } else {
+    // We really must do big integer arithmetic.
+    BigInt Bval, Sval, Mval, tenSval;
+    Bval.set((julong)fract_bits);
+    Bval.mult_pow52(B5, B2);
+    Sval.set(1);
+    Sval.mult_pow52(S5, S2);
+    Mval.set(1);
+    Mval.mult_pow52(M5, M2);
+    tenSval = Sval;
+    tenSval.mult(10);
+
+    q = Bval.quo_rem_iteration(Sval);
+    Mval.mult(10);
+    low  = (BigInt::compare(Bval, Mval) < 0);
+    high = (BigInt::compare_sum(Bval, Mval, tenSval) > 0);
+    if (q == 0 && !high) {
+      dec_exp--;
+    } else {
+      digits[ndigit++] = (char)('0' + q);
+    }
+    if (dec_exp <= -3 || dec_exp >= 8) {
+      high = low = false;
+    }
+    while (!low && !high) {
+      q = Bval.quo_rem_iteration(Sval);
+      Mval.mult(10);
+      low  = (BigInt::compare(Bval, Mval) < 0);
+      high = (BigInt::compare_sum(Bval, Mval, tenSval) > 0);
+      digits[ndigit++] = (char)('0' + q);
+    }
+    if (high && low) {
+      Bval.lshift(1);
+      low_digit_difference = BigInt::compare(Bval, tenSval);
+    } else {
+      low_digit_difference = 0;
+    }
+  }
+  d.dec_exponent = dec_exp + 1;
+  d.n_digits = ndigit;
+
+  // The last digit gets rounded based on the stopping condition.
+  if (high) {
+    if (low) {
+      if (low_digit_difference == 0) {
+        // It's a tie! Choose based on which digits we like.
+        if ((digits[ndigit - 1] & 1) != 0) {
+          d.roundup();
+        }
+      } else if (low_digit_difference > 0) {
+        d.roundup();
+      }
+    } else {
+      d.roundup();
+    }
+  }
+}
+
+// Unpacks <bits> like the FloatingDecimal(double) and FloatingDecimal(float)
+// constructors, then formats the digits like toJavaFormatString().
+int FloatingDecimal::to_chars(jlong bits, bool is_single, char buffer[]) {
+  Digits d;
+  jlong fract_bits;
+  int bin_exp;
+  int n_significant_bits;
+  int hob_shift;
+  int bias;
+
+  if (is_single) {
+    const jint f_bits = (jint)bits;
+    d.is_negative = (f_bits & single_sign_mask) != 0;
+    bin_exp = (f_bits & single_exp_mask) >> single_exp_shift;
+    d.is_exceptional = (bin_exp == (single_exp_mask >> single_exp_shift));
+    // Move the mantissa to the position it has in a double.
+    fract_bits = ((jlong)(f_bits & single_fract_mask)) <<
+                 (exp_shift - single_exp_shift);
+    bias = single_exp_bias;
+    hob_shift = single_exp_shift;
+  } else {
+    d.is_negative = (bits & sign_mask) != 0;
+    bin_exp = (int)((bits & exp_mask) >> exp_shift);
+    d.is_exceptional = (bin_exp == (int)(exp_mask >> exp_shift));
+    fract_bits = bits & fract_mask;
+    bias = exp_bias;
+    hob_shift = exp_shift;
+  }
+
+  if (d.is_exceptional) {
+    // NaN has no sign!
+    d.is_negative = d.is_negative && (fract_bits == 0);
+  } else if (bin_exp == 0) {
+    if (fract_bits == 0) {
+      // Not a denormal, just a 0.
+      d.dec_exponent = 0;
+      d.digits[0] = '0';
+      d.n_digits = 1;
+    } else {
+      // Normalize the denormal.
+      int shift = 0;
+      while ((fract_bits & fract_hob) == 0) {
+        fract_bits <<= 1;
+        shift++;
+      }
+      n_significant_bits = hob_shift + 1 - shift;
+      dtoa(d, 1 - shift - bias, fract_bits, n_significant_bits);
+    }
+  } else {
+    fract_bits |= fract_hob;
+    n_significant_bits = hob_shift + 1;
+    dtoa(d, bin_exp - bias, fract_bits, n_significant_bits);
+  }
+
+  char* p = buffer;
+  if (d.is_negative) {
+    *p++ = '-';
+  }
+  if (d.is_exceptional) {
+    const char* text = (fract_bits == 0) ? "Infinity" : "NaN";
+    while (*text != 0) {
+      *p++ = *text++;
+    }
+  } else if (d.dec_exponent > 0 && d.dec_exponent < 8) {
+    // digits.digits
+    const int char_length = min(d.n_digits, d.dec_exponent);
+    jvm_memcpy(p, d.digits, char_length);
+    p += char_length;
+    if (char_length < d.dec_exponent) {
+      for (int i = char_length; i < d.dec_exponent; i++) {
+        *p++ = '0';
+      }
+      *p++ = '.';
+      *p++ = '0';
+    } else {
+      *p++ = '.';
+      if (char_length < d.n_digits) {
+        const int t = d.n_digits - char_length;
+        jvm_memcpy(p, d.digits + char_length, t);
+        p += t;
+      } else {
+        *p++ = '0';
+      }
+    }
+  } else if (d.dec_exponent <= 0 && d.dec_exponent > -3) {
+    *p++ = '0';
+    *p++ = '.';
+    for (int i = d.dec_exponent; i < 0; i++) {
+      *p++ = '0';
+    }
+    jvm_memcpy(p, d.digits, d.n_digits);
+    p += d.n_digits;
+  } else {
+    *p++ = d.digits[0];
+    *p++ = '.';
+    if (d.n_digits > 1) {
+      jvm_memcpy(p, d.digits + 1, d.n_digits - 1);
+      p += d.n_digits - 1;
+    } else {
+      *p++ = '0';
+    }
+    *p++ = 'E';
+    int e;
+    if (d.dec_exponent <= 0) {
+      *p++ = '-';
+      e = -d.dec_exponent + 1;
+    } else {
+      e = d.dec_exponent - 1;
+    }
+    // The exponent has 1, 2, or 3 digits.
+    if (e <= 9) {
+      *p++ = (char)(e + '0');
+    } else if (e <= 99) {
+      *p++ = (char)(e / 10 + '0');
+      *p++ = (char)(e % 10 + '0');
+    } else {
+      *p++ = (char)(e / 100 + '0');
+      e %= 100;
+      *p++ = (char)(e / 10 + '0');
+      *p++ = (char)(e % 10 + '0');
+    }
+  }
+  GUARANTEE(p - buffer <= max_chars, "sanity");
+  return p - buffer;
+}
+
+int FloatingDecimal::double_to_chars(jdouble value, char buffer[]) {
+  return to_chars(double_bits(value), false, buffer);
+}
+
+int FloatingDecimal::float_to_chars(jfloat value, char buffer[]) {
+  return to_chars((jlong)float_bits(value), true, buffer);
+}
+
+// Parsing
+
+// Scans <chars> with the syntax of FloatingDecimal.readJavaFormatString()
+// and returns the value as <mantissa> * 10^<exponent>. Returns false if
+// the input is malformed, or if it has more than 19 significant digits
+// or a large exponent.
+bool FloatingDecimal::scan(const jchar* chars, int length, bool& is_negative,
+                           julong& mantissa, int& exponent) {
+  // Like String.trim()
+  int i = 0;
+  int end = length;
+  while (i < end && chars[i] <= ' ') {
+    i++;
+  }
+  while (end > i && chars[end - 1] <= ' ') {
+    end--;
+  }
+  if (i == end) {
+    return false;
+  }
+
+  is_negative = false;
+  if (chars[i] == '-' || chars[i] == '+') {
+    is_negative = (chars[i] == '-');
+    i++;
+  }
+
+  julong w = 0;
+  int significant_digits = 0;
+  int pending_zeros = 0;  // zeros after the last non-zero digit
+  int dec_exp = 0;
+  bool digit_seen = false;
+  bool point_seen = false;
+  for (; i < end; i++) {
+    const jchar c = chars[i];
+    if (c >= '0' && c <= '9') {
+      digit_seen = true;
+      if (point_seen) {
+        dec_exp--;
+      }
+      if (c == '0') {
+        if (w != 0) {
+          pending_zeros++;
+        }
+        continue;
+      }
+      significant_digits += pending_zeros + 1;
+      if (significant_digits > 19) {
+        return false;
+      }
+      for (; pending_zeros > 0; pending_zeros--) {
+        w *= 10;
+      }
+      w = w * 10 + (c - '0');
+    } else if (c == '.' && !point_seen) {
+      point_seen = true;
+    } else {
+      break;
+    }
+  }
+  if (!digit_seen) {
+    return false;
+  }
+  dec_exp += pending_zeros;
+
+  if (i < end && (chars[i] == 'e' || chars[i] == 'E')) {
+    i++;
+    bool exp_negative = false;
+    if (i < end && (chars[i] == '-' || chars[i] == '+')) {
+      exp_negative = (chars[i] == '-');
+      i++;
+    }
+    int exp_val = 0;
+    const int exp_start = i;
+    for (; i < end && chars[i] >= '0' && chars[i] <= '9'; i++) {
+      exp_val = exp_val * 10 + (chars[i] - '0');
+      if (exp_val > 9999) {
+        return false;
+      }
+    }
+    if (i == exp_start) {
+      return false;
+    }
+    dec_exp += exp_negative ? -exp_val : exp_val;
+  }
+
+  // A single trailing type suffix is allowed.
+  if (i == end - 1) {
+    const jchar c = chars[i];
+    if (c == 'f' || c == 'F' || c == 'd' || c == 'D') {
+      i++;
+    }
+  }
+  if (i != end) {
+    return false;
+  }
+
+  mantissa = w;
+  exponent = dec_exp;
+  return true;
+}
+
+// Eisel-Lemire: the 128 most significant bits of 5^q for the decimal
+// exponents q covered by eisel_lemire(), truncated for q >= 0 and rounded
+// up for q < 0. Inputs with other exponents are left to the Java code.
+static const int pow5_min_exponent = -100;
+static const int pow5_max_exponent = 100;
+static const julong pow5_128[][2] = {
+  {JVM_ULL(0xdff9772470297ebd), JVM_ULL(0x59787e2b93bc56f7)}, // 5^-100
+  {JVM_ULL(0x8bfbea76c619ef36), JVM_ULL(0x57eb4edb3c55b65a)}, // 5^-99
+  {JVM_ULL(0xaefae51477a06b03), JVM_ULL(0xede622920b6b23f1)}, // 5^-98
+  {JVM_ULL(0xdab99e59958885c4), JVM_ULL(0xe95fab368e45eced)}, // 5^-97
+  {JVM_ULL(0x88b402f7fd75539b), JVM_ULL(0x11dbcb0218ebb414)}, // 5^-96
+  {JVM_ULL(0xaae103b5fcd2a881), JVM_ULL(0xd652bdc29f26a119)}, // 5^-95
+  {JVM_ULL(0xd59944a37c0752a2), JVM_ULL(0x4be76d3346f0495f)}, // 5^-94
+  {JVM_ULL(0x857fcae62d8493a5), JVM_ULL(0x6f70a4400c562ddb)}, // 5^-93
+  {JVM_ULL(0xa6dfbd9fb8e5b88e), JVM_ULL(0xcb4ccd500f6bb952)}, // 5^-92
+  {JVM_ULL(0xd097ad07a71f26b2), JVM_ULL(0x7e2000a41346a7a7)}, // 5^-91
+  {JVM_ULL(0x825ecc24c873782f), JVM_ULL(0x8ed400668c0c28c8)}, // 5^-90
+  {JVM_ULL(0xa2f67f2dfa90563b), JVM_ULL(0x728900802f0f32fa)}, // 5^-89
+  {JVM_ULL(0xcbb41ef979346bca), JVM_ULL(0x4f2b40a03ad2ffb9)}, // 5^-88
+  {JVM_ULL(0xfea126b7d78186bc), JVM_ULL(0xe2f610c84987bfa8)}, // 5^-87
+  {JVM_ULL(0x9f24b832e6b0f436), JVM_ULL(0x0dd9ca7d2df4d7c9)}, // 5^-86
+  {JVM_ULL(0xc6ede63fa05d3143), JVM_ULL(0x91503d1c79720dbb)}, // 5^-85
+  {JVM_ULL(0xf8a95fcf88747d94), JVM_ULL(0x75a44c6397ce912a)}, // 5^-84
+  {JVM_ULL(0x9b69dbe1b548ce7c), JVM_ULL(0xc986afbe3ee11aba)}, // 5^-83
+  {JVM_ULL(0xc24452da229b021b), JVM_ULL(0xfbe85badce996168)}, // 5^-82
+  {JVM_ULL(0xf2d56790ab41c2a2), JVM_ULL(0xfae27299423fb9c3)}, // 5^-81
+  {JVM_ULL(0x97c560ba6b0919a5), JVM_ULL(0xdccd879fc967d41a)}, // 5^-80
+  {JVM_ULL(0xbdb6b8e905cb600f), JVM_ULL(0x5400e987bbc1c920)}, // 5^-79
+  {JVM_ULL(0xed246723473e3813), JVM_ULL(0x290123e9aab23b68)}, // 5^-78
+  {JVM_ULL(0x9436c0760c86e30b), JVM_ULL(0xf9a0b6720aaf6521)}, // 5^-77
+  {JVM_ULL(0xb94470938fa89bce), JVM_ULL(0xf808e40e8d5b3e69)}, // 5^-76
+  {JVM_ULL(0xe7958cb87392c2c2), JVM_ULL(0xb60b1d1230b20e04)}, // 5^-75
+  {JVM_ULL(0x90bd77f3483bb9b9), JVM_ULL(0xb1c6f22b5e6f48c2)}, // 5^-74
+  {JVM_ULL(0xb4ecd5f01a4aa828), JVM_ULL(0x1e38aeb6360b1af3)}, // 5^-73
+  {JVM_ULL(0xe2280b6c20dd5232), JVM_ULL(0x25c6da63c38de1b0)}, // 5^-72
+  {JVM_ULL(0x8d590723948a535f), JVM_ULL(0x579c487e5a38ad0e)}, // 5^-71
+  {JVM_ULL(0xb0af48ec79ace837), JVM_ULL(0x2d835a9df0c6d851)}, // 5^-70
+  {JVM_ULL(0xdcdb1b2798182244), JVM_ULL(0xf8e431456cf88e65)}, // 5^-69
+  {JVM_ULL(0x8a08f0f8bf0f156b), JVM_ULL(0x1b8e9ecb641b58ff)}, // 5^-68
+  {JVM_ULL(0xac8b2d36eed2dac5), JVM_ULL(0xe272467e3d222f3f)}, // 5^-67
+  {JVM_ULL(0xd7adf884aa879177), JVM_ULL(0x5b0ed81dcc6abb0f)}, // 5^-66
+  {JVM_ULL(0x86ccbb52ea94baea), JVM_ULL(0x98e947129fc2b4e9)}, // 5^-65
+  {JVM_ULL(0xa87fea27a539e9a5), JVM_ULL(0x3f2398d747b36224)}, // 5^-64
+  {JVM_ULL(0xd29fe4b18e88640e), JVM_ULL(0x8eec7f0d19a03aad)}, // 5^-63
+  {JVM_ULL(0x83a3eeeef9153e89), JVM_ULL(0x1953cf68300424ac)}, // 5^-62
+  {JVM_ULL(0xa48ceaaab75a8e2b), JVM_ULL(0x5fa8c3423c052dd7)}, // 5^-61
+  {JVM_ULL(0xcdb02555653131b6), JVM_ULL(0x3792f412cb06794d)}, // 5^-60
+  {JVM_ULL(0x808e17555f3ebf11), JVM_ULL(0xe2bbd88bbee40bd0)}, // 5^-59
+  {JVM_ULL(0xa0b19d2ab70e6ed6), JVM_ULL(0x5b6aceaeae9d0ec4)}, // 5^-58
+  {JVM_ULL(0xc8de047564d20a8b), JVM_ULL(0xf245825a5a445275)}, // 5^-57
+  {JVM_ULL(0xfb158592be068d2e), JVM_ULL(0xeed6e2f0f0d56712)}, // 5^-56
+  {JVM_ULL(0x9ced737bb6c4183d), JVM_ULL(0x55464dd69685606b)}, // 5^-55
+  {JVM_ULL(0xc428d05aa4751e4c), JVM_ULL(0xaa97e14c3c26b886)}, // 5^-54
+  {JVM_ULL(0xf53304714d9265df), JVM_ULL(0xd53dd99f4b3066a8)}, // 5^-53
+  {JVM_ULL(0x993fe2c6d07b7fab), JVM_ULL(0xe546a8038efe4029)}, // 5^-52
+  {JVM_ULL(0xbf8fdb78849a5f96), JVM_ULL(0xde98520472bdd033)}, // 5^-51
+  {JVM_ULL(0xef73d256a5c0f77c), JVM_ULL(0x963e66858f6d4440)}, // 5^-50
+  {JVM_ULL(0x95a8637627989aad), JVM_ULL(0xdde7001379a44aa8)}, // 5^-49
+  {JVM_ULL(0xbb127c53b17ec159), JVM_ULL(0x5560c018580d5d52)}, // 5^-48
+  {JVM_ULL(0xe9d71b689dde71af), JVM_ULL(0xaab8f01e6e10b4a6)}, // 5^-47
+  {JVM_ULL(0x9226712162ab070d), JVM_ULL(0xcab3961304ca70e8)}, // 5^-46
+  {JVM_ULL(0xb6b00d69bb55c8d1), JVM_ULL(0x3d607b97c5fd0d22)}, // 5^-45
+  {JVM_ULL(0xe45c10c42a2b3b05), JVM_ULL(0x8cb89a7db77c506a)}, // 5^-44
+  {JVM_ULL(0x8eb98a7a9a5b04e3), JVM_ULL(0x77f3608e92adb242)}, // 5^-43
+  {JVM_ULL(0xb267ed1940f1c61c), JVM_ULL(0x55f038b237591ed3)}, // 5^-42
+  {JVM_ULL(0xdf01e85f912e37a3), JVM_ULL(0x6b6c46dec52f6688)}, // 5^-41
+  {JVM_ULL(0x8b61313bbabce2c6), JVM_ULL(0x2323ac4b3b3da015)}, // 5^-40
+  {JVM_ULL(0xae397d8aa96c1b77), JVM_ULL(0xabec975e0a0d081a)}, // 5^-39
+  {JVM_ULL(0xd9c7dced53c72255), JVM_ULL(0x96e7bd358c904a21)}, // 5^-38
+  {JVM_ULL(0x881cea14545c7575), JVM_ULL(0x7e50d64177da2e54)}, // 5^-37
+  {JVM_ULL(0xaa242499697392d2), JVM_ULL(0xdde50bd1d5d0b9e9)}, // 5^-36
+  {JVM_ULL(0xd4ad2dbfc3d07787), JVM_ULL(0x955e4ec64b44e864)}, // 5^-35
+  {JVM_ULL(0x84ec3c97da624ab4), JVM_ULL(0xbd5af13bef0b113e)}, // 5^-34
+  {JVM_ULL(0xa6274bbdd0fadd61), JVM_ULL(0xecb1ad8aeacdd58e)}, // 5^-33
+  {JVM_ULL(0xcfb11ead453994ba), JVM_ULL(0x67de18eda5814af2)}, // 5^-32
+  {JVM_ULL(0x81ceb32c4b43fcf4), JVM_ULL(0x80eacf948770ced7)}, // 5^-31
+  {JVM_ULL(0xa2425ff75e14fc31), JVM_ULL(0xa1258379a94d028d)}, // 5^-30
+  {JVM_ULL(0xcad2f7f5359a3b3e), JVM_ULL(0x096ee45813a04330)}, // 5^-29
+  {JVM_ULL(0xfd87b5f28300ca0d), JVM_ULL(0x8bca9d6e188853fc)}, // 5^-28
+  {JVM_ULL(0x9e74d1b791e07e48), JVM_ULL(0x775ea264cf55347e)}, // 5^-27
+  {JVM_ULL(0xc612062576589dda), JVM_ULL(0x95364afe032a819e)}, // 5^-26
+  {JVM_ULL(0xf79687aed3eec551), JVM_ULL(0x3a83ddbd83f52205)}, // 5^-25
+  {JVM_ULL(0x9abe14cd44753b52), JVM_ULL(0xc4926a9672793543)}, // 5^-24
+  {JVM_ULL(0xc16d9a0095928a27), JVM_ULL(0x75b7053c0f178294)}, // 5^-23
+  {JVM_ULL(0xf1c90080baf72cb1), JVM_ULL(0x5324c68b12dd6339)}, // 5^-22
+  {JVM_ULL(0x971da05074da7bee), JVM_ULL(0xd3f6fc16ebca5e04)}, // 5^-21
+  {JVM_ULL(0xbce5086492111aea), JVM_ULL(0x88f4bb1ca6bcf585)}, // 5^-20
+  {JVM_ULL(0xec1e4a7db69561a5), JVM_ULL(0x2b31e9e3d06c32e6)}, // 5^-19
+  {JVM_ULL(0x9392ee8e921d5d07), JVM_ULL(0x3aff322e62439fd0)}, // 5^-18
+  {JVM_ULL(0xb877aa3236a4b449), JVM_ULL(0x09befeb9fad487c3)}, // 5^-17
+  {JVM_ULL(0xe69594bec44de15b), JVM_ULL(0x4c2ebe687989a9b4)}, // 5^-16
+  {JVM_ULL(0x901d7cf73ab0acd9), JVM_ULL(0x0f9d37014bf60a11)}, // 5^-15
+  {JVM_ULL(0xb424dc35095cd80f), JVM_ULL(0x538484c19ef38c95)}, // 5^-14
+  {JVM_ULL(0xe12e13424bb40e13), JVM_ULL(0x2865a5f206b06fba)}, // 5^-13
+  {JVM_ULL(0x8cbccc096f5088cb), JVM_ULL(0xf93f87b7442e45d4)}, // 5^-12
+  {JVM_ULL(0xafebff0bcb24aafe), JVM_ULL(0xf78f69a51539d749)}, // 5^-11
+  {JVM_ULL(0xdbe6fecebdedd5be), JVM_ULL(0xb573440e5a884d1c)}, // 5^-10
+  {JVM_ULL(0x89705f4136b4a597), JVM_ULL(0x31680a88f8953031)}, // 5^-9
+  {JVM_ULL(0xabcc77118461cefc), JVM_ULL(0xfdc20d2b36ba7c3e)}, // 5^-8
+  {JVM_ULL(0xd6bf94d5e57a42bc), JVM_ULL(0x3d32907604691b4d)}, // 5^-7
+  {JVM_ULL(0x8637bd05af6c69b5), JVM_ULL(0xa63f9a49c2c1b110)}, // 5^-6
+  {JVM_ULL(0xa7c5ac471b478423), JVM_ULL(0x0fcf80dc33721d54)}, // 5^-5
+  {JVM_ULL(0xd1b71758e219652b), JVM_ULL(0xd3c36113404ea4a9)}, // 5^-4
+  {JVM_ULL(0x83126e978d4fdf3b), JVM_ULL(0x645a1cac083126ea)}, // 5^-3
+  {JVM_ULL(0xa3d70a3d70a3d70a), JVM_ULL(0x3d70a3d70a3d70a4)}, // 5^-2
+  {JVM_ULL(0xcccccccccccccccc), JVM_ULL(0xcccccccccccccccd)}, // 5^-1
+  {JVM_ULL(0x8000000000000000), JVM_ULL(0x0000000000000000)}, // 5^0
+  {JVM_ULL(0xa000000000000000), JVM_ULL(0x0000000000000000)}, // 5^1
+  {JVM_ULL(0xc800000000000000), JVM_ULL(0x0000000000000000)}, // 5^2
+  {JVM_ULL(0xfa00000000000000), JVM_ULL(0x0000000000000000)}, // 5^3
+  {JVM_ULL(0x9c40000000000000), JVM_ULL(0x0000000000000000)}, // 5^4
+  {JVM_ULL(0xc350000000000000), JVM_ULL(0x0000000000000000)}, // 5^5
+  {JVM_ULL(0xf424000000000000), JVM_ULL(0x0000000000000000)}, // 5^6
+  {JVM_ULL(0x9896800000000000), JVM_ULL(0x0000000000000000)}, // 5^7
+  {JVM_ULL(0xbebc200000000000), JVM_ULL(0x0000000000000000)}, // 5^8
+  {JVM_ULL(0xee6b280000000000), JVM_ULL(0x0000000000000000)}, // 5^9
+  {JVM_ULL(0x9502f90000000000), JVM_ULL(0x0000000000000000)}, // 5^10
+  {JVM_ULL(0xba43b74000000000), JVM_ULL(0x0000000000000000)}, // 5^11
+  {JVM_ULL(0xe8d4a51000000000), JVM_ULL(0x0000000000000000)}, // 5^12
+  {JVM_ULL(0x9184e72a00000000), JVM_ULL(0x0000000000000000)}, // 5^13
+  {JVM_ULL(0xb5e620f480000000), JVM_ULL(0x0000000000000000)}, // 5^14
+  {JVM_ULL(0xe35fa931a0000000), JVM_ULL(0x0000000000000000)}, // 5^15
+  {JVM_ULL(0x8e1bc9bf04000000), JVM_ULL(0x0000000000000000)}, // 5^16
+  {JVM_ULL(0xb1a2bc2ec5000000), JVM_ULL(0x0000000000000000)}, // 5^17
+  {JVM_ULL(0xde0b6b3a76400000), JVM_ULL(0x0000000000000000)}, // 5^18
+  {JVM_ULL(0x8ac7230489e80000), JVM_ULL(0x0000000000000000)}, // 5^19
+  {JVM_ULL(0xad78ebc5ac620000), JVM_ULL(0x0000000000000000)}, // 5^20
+  {JVM_ULL(0xd8d726b7177a8000), JVM_ULL(0x0000000000000000)}, // 5^21
+  {JVM_ULL(0x878678326eac9000), JVM_ULL(0x0000000000000000)}, // 5^22
+  {JVM_ULL(0xa968163f0a57b400), JVM_ULL(0x0000000000000000)}, // 5^23
+  {JVM_ULL(0xd3c21bcecceda100), JVM_ULL(0x0000000000000000)}, // 5^24
+  {JVM_ULL(0x84595161401484a0), JVM_ULL(0x0000000000000000)}, // 5^25
+  {JVM_ULL(0xa56fa5b99019a5c8), JVM_ULL(0x0000000000000000)}, // 5^26
+  {JVM_ULL(0xcecb8f27f4200f3a), JVM_ULL(0x0000000000000000)}, // 5^27
+  {JVM_ULL(0x813f3978f8940984), JVM_ULL(0x4000000000000000)}, // 5^28
+  {JVM_ULL(0xa18f07d736b90be5), JVM_ULL(0x5000000000000000)}, // 5^29
+  {JVM_ULL(0xc9f2c9cd04674ede), JVM_ULL(0xa400000000000000)}, // 5^30
+  {JVM_ULL(0xfc6f7c4045812296), JVM_ULL(0x4d00000000000000)}, // 5^31
+  {JVM_ULL(0x9dc5ada82b70b59d), JVM_ULL(0xf020000000000000)}, // 5^32
+  {JVM_ULL(0xc5371912364ce305), JVM_ULL(0x6c28000000000000)}, // 5^33
+  {JVM_ULL(0xf684df56c3e01bc6), JVM_ULL(0xc732000000000000)}, // 5^34
+  {JVM_ULL(0x9a130b963a6c115c), JVM_ULL(0x3c7f400000000000)}, // 5^35
+  {JVM_ULL(0xc097ce7bc90715b3), JVM_ULL(0x4b9f100000000000)}, // 5^36
+  {JVM_ULL(0xf0bdc21abb48db20), JVM_ULL(0x1e86d40000000000)}, // 5^37
+  {JVM_ULL(0x96769950b50d88f4), JVM_ULL(0x1314448000000000)}, // 5^38
+  {JVM_ULL(0xbc143fa4e250eb31), JVM_ULL(0x17d955a000000000)}, // 5^39
+  {JVM_ULL(0xeb194f8e1ae525fd), JVM_ULL(0x5dcfab0800000000)}, // 5^40
+  {JVM_ULL(0x92efd1b8d0cf37be), JVM_ULL(0x5aa1cae500000000)}, // 5^41
+  {JVM_ULL(0xb7abc627050305ad), JVM_ULL(0xf14a3d9e40000000)}, // 5^42
+  {JVM_ULL(0xe596b7b0c643c719), JVM_ULL(0x6d9ccd05d0000000)}, // 5^43
+  {JVM_ULL(0x8f7e32ce7bea5c6f), JVM_ULL(0xe4820023a2000000)}, // 5^44
+  {JVM_ULL(0xb35dbf821ae4f38b), JVM_ULL(0xdda2802c8a800000)}, // 5^45
+  {JVM_ULL(0xe0352f62a19e306e), JVM_ULL(0xd50b2037ad200000)}, // 5^46
+  {JVM_ULL(0x8c213d9da502de45), JVM_ULL(0x4526f422cc340000)}, // 5^47
+  {JVM_ULL(0xaf298d050e4395d6), JVM_ULL(0x9670b12b7f410000)}, // 5^48
+  {JVM_ULL(0xdaf3f04651d47b4c), JVM_ULL(0x3c0cdd765f114000)}, // 5^49
+  {JVM_ULL(0x88d8762bf324cd0f), JVM_ULL(0xa5880a69fb6ac800)}, // 5^50
+  {JVM_ULL(0xab0e93b6efee0053), JVM_ULL(0x8eea0d047a457a00)}, // 5^51
+  {JVM_ULL(0xd5d238a4abe98068), JVM_ULL(0x72a4904598d6d880)}, // 5^52
+  {JVM_ULL(0x85a36366eb71f041), JVM_ULL(0x47a6da2b7f864750)}, // 5^53
+  {JVM_ULL(0xa70c3c40a64e6c51), JVM_ULL(0x999090b65f67d924)}, // 5^54
+  {JVM_ULL(0xd0cf4b50cfe20765), JVM_ULL(0xfff4b4e3f741cf6d)}, // 5^55
+  {JVM_ULL(0x82818f1281ed449f), JVM_ULL(0xbff8f10e7a8921a4)}, // 5^56
+  {JVM_ULL(0xa321f2d7226895c7), JVM_ULL(0xaff72d52192b6a0d)}, // 5^57
+  {JVM_ULL(0xcbea6f8ceb02bb39), JVM_ULL(0x9bf4f8a69f764490)}, // 5^58
+  {JVM_ULL(0xfee50b7025c36a08), JVM_ULL(0x02f236d04753d5b4)}, // 5^59
+  {JVM_ULL(0x9f4f2726179a2245), JVM_ULL(0x01d762422c946590)}, // 5^60
+  {JVM_ULL(0xc722f0ef9d80aad6), JVM_ULL(0x424d3ad2b7b97ef5)}, // 5^61
+  {JVM_ULL(0xf8ebad2b84e0d58b), JVM_ULL(0xd2e0898765a7deb2)}, // 5^62
+  {JVM_ULL(0x9b934c3b330c8577), JVM_ULL(0x63cc55f49f88eb2f)}, // 5^63
+  {JVM_ULL(0xc2781f49ffcfa6d5), JVM_ULL(0x3cbf6b71c76b25fb)}, // 5^64
+  {JVM_ULL(0xf316271c7fc3908a), JVM_ULL(0x8bef464e3945ef7a)}, // 5^65
+  {JVM_ULL(0x97edd871cfda3a56), JVM_ULL(0x97758bf0e3cbb5ac)}, // 5^66
+  {JVM_ULL(0xbde94e8e43d0c8ec), JVM_ULL(0x3d52eeed1cbea317)}, // 5^67
+  {JVM_ULL(0xed63a231d4c4fb27), JVM_ULL(0x4ca7aaa863ee4bdd)}, // 5^68
+  {JVM_ULL(0x945e455f24fb1cf8), JVM_ULL(0x8fe8caa93e74ef6a)}, // 5^69
+  {JVM_ULL(0xb975d6b6ee39e436), JVM_ULL(0xb3e2fd538e122b44)}, // 5^70
+  {JVM_ULL(0xe7d34c64a9c85d44), JVM_ULL(0x60dbbca87196b616)}, // 5^71
+  {JVM_ULL(0x90e40fbeea1d3a4a), JVM_ULL(0xbc8955e946fe31cd)}, // 5^72
+  {JVM_ULL(0xb51d13aea4a488dd), JVM_ULL(0x6babab6398bdbe41)}, // 5^73
+  {JVM_ULL(0xe264589a4dcdab14), JVM_ULL(0xc696963c7eed2dd1)}, // 5^74
+  {JVM_ULL(0x8d7eb76070a08aec), JVM_ULL(0xfc1e1de5cf543ca2)}, // 5^75
+  {JVM_ULL(0xb0de65388cc8ada8), JVM_ULL(0x3b25a55f43294bcb)}, // 5^76
+  {JVM_ULL(0xdd15fe86affad912), JVM_ULL(0x49ef0eb713f39ebe)}, // 5^77
+  {JVM_ULL(0x8a2dbf142dfcc7ab), JVM_ULL(0x6e3569326c784337)}, // 5^78
+  {JVM_ULL(0xacb92ed9397bf996), JVM_ULL(0x49c2c37f07965404)}, // 5^79
+  {JVM_ULL(0xd7e77a8f87daf7fb), JVM_ULL(0xdc33745ec97be906)}, // 5^80
+  {JVM_ULL(0x86f0ac99b4e8dafd), JVM_ULL(0x69a028bb3ded71a3)}, // 5^81
+  {JVM_ULL(0xa8acd7c0222311bc), JVM_ULL(0xc40832ea0d68ce0c)}, // 5^82
+  {JVM_ULL(0xd2d80db02aabd62b), JVM_ULL(0xf50a3fa490c30190)}, // 5^83
+  {JVM_ULL(0x83c7088e1aab65db), JVM_ULL(0x792667c6da79e0fa)}, // 5^84
+  {JVM_ULL(0xa4b8cab1a1563f52), JVM_ULL(0x577001b891185938)}, // 5^85
+  {JVM_ULL(0xcde6fd5e09abcf26), JVM_ULL(0xed4c0226b55e6f86)}, // 5^86
+  {JVM_ULL(0x80b05e5ac60b6178), JVM_ULL(0x544f8158315b05b4)}, // 5^87
+  {JVM_ULL(0xa0dc75f1778e39d6), JVM_ULL(0x696361ae3db1c721)}, // 5^88
+  {JVM_ULL(0xc913936dd571c84c), JVM_ULL(0x03bc3a19cd1e38e9)}, // 5^89
+  {JVM_ULL(0xfb5878494ace3a5f), JVM_ULL(0x04ab48a04065c723)}, // 5^90
+  {JVM_ULL(0x9d174b2dcec0e47b), JVM_ULL(0x62eb0d64283f9c76)}, // 5^91
+  {JVM_ULL(0xc45d1df942711d9a), JVM_ULL(0x3ba5d0bd324f8394)}, // 5^92
+  {JVM_ULL(0xf5746577930d6500), JVM_ULL(0xca8f44ec7ee36479)}, // 5^93
+  {JVM_ULL(0x9968bf6abbe85f20), JVM_ULL(0x7e998b13cf4e1ecb)}, // 5^94
+  {JVM_ULL(0xbfc2ef456ae276e8), JVM_ULL(0x9e3fedd8c321a67e)}, // 5^95
+  {JVM_ULL(0xefb3ab16c59b14a2), JVM_ULL(0xc5cfe94ef3ea101e)}, // 5^96
+  {JVM_ULL(0x95d04aee3b80ece5), JVM_ULL(0xbba1f1d158724a12)}, // 5^97
+  {JVM_ULL(0xbb445da9ca61281f), JVM_ULL(0x2a8a6e45ae8edc97)}, // 5^98
+  {JVM_ULL(0xea1575143cf97226), JVM_ULL(0xf52d09d71a3293bd)}, // 5^99
+  {JVM_ULL(0x924d692ca61be758), JVM_ULL(0x593c2626705f9c56)}  // 5^100
+};
+
+// (hi, lo) = a * b
+static void full_multiplication(julong a, julong b, julong& hi, julong& lo) {
+  const julong a_lo = (juint)a;
+  const julong a_hi = a >> 32;
+  const julong b_lo = (juint)b;
+  const julong b_hi = b >> 32;
+  const julong p0 = a_lo * b_lo;
+  const julong p1 = a_lo * b_hi;
+  const julong p2 = a_hi * b_lo;
+  const julong p3 = a_hi * b_hi;
+  const julong middle = p1 + (p0 >> 32) + (juint)p2;
+  lo = (middle << 32) | (juint)p0;
+  hi = p3 + (middle >> 32) + (p2 >> 32);
+}
+
+inline static int leading_zeros(julong x) {
+  int n = 0;
+  if ((x >> 32) == 0) { n += 32; x <<= 32; }
+  if ((x >> 48) == 0) { n += 16; x <<= 16; }
+  if ((x >> 56) == 0) { n +=  8; x <<=  8; }
+  if ((x >> 60) == 0) { n +=  4; x <<=  4; }
+  if ((x >> 62) == 0) { n +=  2; x <<=  2; }
+  if ((x >> 63) == 0) { n +=  1; }
+  return n;
+}
+
+// Computes the correctly rounded float or double nearest to
+// <w> * 10^<q> (w != 0) as in "Number Parsing at a Gigabyte per Second"
+// (Lemire, 2021). Returns false in the rare cases where the truncated
+// 128-bit product is not precise enough to decide the rounding.
+bool FloatingDecimal::eisel_lemire(julong w, int q, bool is_single,
+                                   jlong& bits) {
+  const int mantissa_bits      = is_single ? 23 : 52;
+  const int minimum_exponent   = is_single ? -127 : -1023;
+  const int infinite_power     = is_single ? 0xFF : 0x7FF;
+  const int min_round_to_even  = is_single ? -17 : -4;
+  const int max_round_to_even  = is_single ? 10 : 23;
+
+  if (q < pow5_min_exponent || q > pow5_max_exponent) {
+    return false;
+  }
+  const int lz = leading_zeros(w);
+  w <<= lz;
+
+  const julong* power = pow5_128[q - pow5_min_exponent];
+  julong hi, lo;
+  full_multiplication(w, power[0], hi, lo);
+  const julong precision_mask =
+      JVM_ULL(0xFFFFFFFFFFFFFFFF) >> (mantissa_bits + 3);
+  if ((hi & precision_mask) == precision_mask) {
+    // The low bits of the product might change the result.
+    julong hi2, lo2;
+    full_multiplication(w, power[1], hi2, lo2);
+    lo += hi2;
+    if (hi2 > lo) {
+      hi++;
+    }
+  }
+  if (lo == JVM_ULL(0xFFFFFFFFFFFFFFFF) && (q < -27 || q > 55)) {
+    return false;
+  }
+
+  const int upperbit = (int)(hi >> 63);
+  julong mantissa = hi >> (upperbit + 64 - mantissa_bits - 3);
+  // ((152170 + 65536) * q) >> 16 is floor(q * log2(10)) for |q| < 1000.
+  int power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz -
+               minimum_exponent;
+  if (power2 <= 0) {
+    // Denormal (or zero) result.
+    if (-power2 + 1 >= 64) {
+      bits = 0;
+      return true;
+    }
+    mantissa >>= -power2 + 1;
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    power2 = (mantissa < ((julong)1 << mantissa_bits)) ? 0 : 1;
+    bits = (jlong)(mantissa | ((julong)power2 << mantissa_bits));
+    return true;
+  }
+
+  // A product that lies exactly halfway between two floats must round to
+  // even; that can only happen for small exponents.
+  if (lo <= 1 && q >= min_round_to_even && q <= max_round_to_even &&
+      (mantissa & 3) == 1) {
+    if ((mantissa << (upperbit + 64 - mantissa_bits - 3)) == hi) {
+      mantissa &= ~(julong)1;
+    }
+  }
+  mantissa += (mantissa & 1);
+  mantissa >>= 1;
+  if (mantissa >= ((julong)2 << mantissa_bits)) {
+    mantissa = (julong)1 << mantissa_bits;
+    power2++;
+  }
+  mantissa &= ~((julong)1 << mantissa_bits);
+  if (power2 >= infinite_power) {
+    power2 = infinite_power;
+    mantissa = 0;
+  }
+  bits = (jlong)(mantissa | ((julong)power2 << mantissa_bits));
+  return true;
+}
+
+// Powers of ten that are exact as doubles and floats.
+static const jdouble double_pow10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const jfloat float_pow10[] = {
+  1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+bool FloatingDecimal::parse_double(const jchar* chars, int length,
+                                   jdouble& result) {
+  bool is_negative;
+  julong w;
+  int q;
+  if (!scan(chars, length, is_negative, w, q)) {
+    return false;
+  }
+
+  jlong bits;
+  if (w == 0) {
+    bits = 0;
+  } else if (w <= (JVM_ULL(1) << 53) && q >= -22 && q <= 22) {
+    // Both w and 10^|q| are exact, so one operation rounds correctly.
+    jdouble value = jvm_l2d((jlong)w);
+    if (q >= 0) {
+      value = jvm_dmul(value, double_pow10[q]);
+    } else {
+      value = jvm_ddiv(value, double_pow10[-q]);
+    }
+    bits = double_bits(value);
+  } else if (!eisel_lemire(w, q, false, bits)) {
+    return false;
+  }
+  if (is_negative) {
+    bits |= sign_mask;
+  }
+  result = double_from_bits(bits);
+  return true;
+}
+
+bool FloatingDecimal::parse_float(const jchar* chars, int length,
+                                  jfloat& result) {
+  bool is_negative;
+  julong w;
+  int q;
+  if (!scan(chars, length, is_negative, w, q)) {
+    return false;
+  }
+
+  jlong bits;
+  if (w == 0) {
+    bits = 0;
+  } else if (w <= (JVM_ULL(1) << 24) && q >= -10 && q <= 10) {
+    jfloat value = jvm_l2f((jlong)w);
+    if (q >= 0) {
+      value = jvm_fmul(value, float_pow10[q]);
+    } else {
+      value = jvm_fdiv(value, float_pow10[-q]);
+    }
+    bits = float_bits(value);
+  } else if (!eisel_lemire(w, q, true, bits)) {
+    return false;
+  }
+  if (is_negative) {
+    bits |= single_sign_mask;
+  }
+  result = float_from_bits((jint)bits);
+  return true;
+}
+
+#endif // ENABLE_FLOAT
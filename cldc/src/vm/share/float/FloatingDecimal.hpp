@@ -0,0 +1,82 @@
+/*
+ *   
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ * 
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ * 
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+
+#if ENABLE_FLOAT
+
+// Conversions between float/double and their decimal representation, as
+// used by Float.toString, Double.toString, Float.parseFloat and
+// Double.parseDouble.
+//
+// Formatting is a port of the digit generation of java.lang.FloatingDecimal
+// (including its int and long fast paths), so it produces exactly the
+// same characters as the Java code. The FDBigInt objects of the Java code
+// are replaced by fixed-size integers on the C stack.
+//
+// Parsing handles the common inputs only: those with at most 19
+// significant digits and a small decimal exponent. They are converted
+// with one floating-point operation when that is exact, or with the
+// Eisel-Lemire algorithm otherwise. The parse functions return false for
+// every other input (including malformed input), and the caller then falls
+// back to FloatingDecimal.readJavaFormatString().
+class FloatingDecimal : public AllStatic {
+ public:
+  enum {
+    // Enough for any result of double_to_chars() or float_to_chars().
+    max_chars = 32,
+    // Longest string that the parse natives hand to the parse functions;
+    // longer ones go straight to the Java code.
+    max_parse_length = 64
+  };
+
+  // Write the Java representation of <value> into <buffer>, which must
+  // have room for max_chars characters, and return its length.
+  static int double_to_chars(jdouble value, char buffer[]);
+  static int float_to_chars(jfloat value, char buffer[]);
+
+  // Parse <chars> with the syntax of Double.parseDouble and
+  // Float.parseFloat. Returns false if the input is not handled here.
+  static bool parse_double(const jchar* chars, int length, jdouble& result);
+  static bool parse_float(const jchar* chars, int length, jfloat& result);
+
+ private:
+  class Digits;
+  class BigInt;
+
+  static int to_chars(jlong bits, bool is_single, char buffer[]);
+  static void dtoa(Digits& d, int bin_exp, jlong fract_bits,
+                   int significant_bits);
+  static void develop_long_digits(Digits& d, int dec_exponent, jlong lvalue,
+                                  jlong insignificant);
+  static int count_bits(jlong v);
+
+  static bool scan(const jchar* chars, int length, bool& is_negative,
+                   julong& mantissa, int& exponent);
+  static bool eisel_lemire(julong mantissa, int exponent, bool is_single,
+                           jlong& bits);
+};
+
+#endif // ENABLE_FLOAT
@@ -323,13 +323,45 @@ bool JavaClass::compute_and_set_is_subtype_of(JavaClass* other_class) {
   return result;
 }
 
+juint  JavaClass::_subtype_check_keys[JavaClass::subtype_check_cache_size];
+jubyte JavaClass::_subtype_check_results[JavaClass::subtype_check_cache_size];
+
 bool JavaClass::is_subtype_of(JavaClass* other_class) {
-  JavaClass::Raw a = subtype_cache_1();
-  JavaClass::Raw b = subtype_cache_2();
-  return a.equals(other_class) // Fast check
-      || b.equals(other_class) // Fast check
-      // Computes the result and fills the cache
-      || compute_and_set_is_subtype_of(other_class);
+  {
+    JavaClass::Raw a = subtype_cache_1();
+    JavaClass::Raw b = subtype_cache_2();
+    if (a.equals(other_class) || b.equals(other_class) || // Fast check
+        equals(other_class)) {
+      return true;
+    }
+  }
+
+  if (GenerateROMImage) {
+    // The romizer may restructure the class hierarchy.
+    return compute_and_set_is_subtype_of(other_class);
+  }
+
+  // The key of two different classes is never 0, which marks an empty slot
+  const juint key = (juint(class_id()) << 16) | other_class->class_id();
+  const juint index = (key * 0x9E3779B1) >> 24;
+  GUARANTEE(index < subtype_check_cache_size, "sanity");
+
+  if (_subtype_check_keys[index] == key) {
+    if (!_subtype_check_results[index]) {
+      return false;
+    }
+    // Keep the per-class caches, used by the interpreter and compiled
+    // code, filled with the most recently used supertypes.
+    set_subtype_cache_2(subtype_cache_1());
+    set_subtype_cache_1(other_class);
+    return true;
+  }
+
+  // Computes the result and fills the caches
+  const bool result = compute_and_set_is_subtype_of(other_class);
+  _subtype_check_keys[index] = key;
+  _subtype_check_results[index] = result ? 1 : 0;
+  return result;
 }
 
 bool JavaClass::is_subclass_of(JavaClass* other_class) {
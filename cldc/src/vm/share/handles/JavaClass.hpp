@@ -219,6 +219,18 @@ public:
     clear_subtype_cache_2();
   }
 
+  // The two per-class subtype caches only hold positive results, and are
+  // easily thrashed when the same classes are checked against many
+  // different types. Results that miss them are remembered, positive or
+  // negative, in a global direct-mapped table indexed by the pair of
+  // class ids. A negative result can go stale, so the table is flushed
+  // whenever a class is loaded, a class id is reused, and (with
+  // ENABLE_ISOLATES, where class ids are task-local) on a task switch,
+  // including the temporary ones made by TaskGCContext.
+  static void flush_subtype_check_cache() {
+    jvm_memset(_subtype_check_keys, 0, sizeof(_subtype_check_keys));
+  }
+
   bool check_access_by(InstanceClass* sender_class, FailureMode fail_mode
                        JVM_TRAPS);
 
@@ -325,4 +337,11 @@ public:
 #endif
 
   friend class ConstantPoolRewriter;
+
+ private:
+  enum {
+    subtype_check_cache_size = 256     // Must be a power of 2
+  };
+  static juint  _subtype_check_keys[subtype_check_cache_size];
+  static jubyte _subtype_check_results[subtype_check_cache_size];
 };
@@ -626,7 +626,9 @@ public:
   // Bytecode attributes
   enum {
     bci_exception_has_osr_entry = 1,
-    bci_branch_taken = 1 << 1
+    bci_branch_taken = 1 << 1,
+    bci_allocation_eliminated = 1 << 2,  // see EscapeAnalysis.hpp
+    bci_store_to_eliminated = 1 << 3
   };
 
   // Computes method attributes used by compiler and romizer.
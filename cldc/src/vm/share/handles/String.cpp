@@ -27,10 +27,69 @@
 # include "incls/_precompiled.incl"
 # include "incls/_String.cpp.incl"
 
+bool String::_has_latin1_field = false;
+bool String::_has_hash_field = false;
+
+void String::initialize_layout() {
+  // The compact body is declared right after count, and the cached hash
+  // right after that, so each exists exactly when String instances are
+  // large enough to hold it.
+  const int size = Universe::string_class()->instance_size().value();
+  _has_latin1_field = size > latin1_offset();
+  _has_hash_field = size > hash_offset();
+  GUARANTEE(size == generated_instance_size(),
+            "String layout does not match the native entries");
+}
+
+bool String::fits_latin1(const jchar* chars, int length) {
+  for (const jchar* end = chars + length; chars < end; chars++) {
+    if (*chars > 0xFF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool latin1_matches_chars(const jubyte* bytes, const jchar* chars,
+                                 int length) {
+  for (const jubyte* end = bytes + length; bytes < end; ) {
+    if ((jchar)(*bytes++) != *chars++) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool String::matches(String *that_string) {
-  if (this->count() != that_string->count()) {
+  const int len = count();
+  if (len != that_string->count()) {
     return false;
   }
+
+  AllocationDisabler raw_pointers_used_in_this_function;
+  TypeArray::Raw this_latin1 = this->latin1();
+  TypeArray::Raw that_latin1 = that_string->latin1();
+
+  if (this_latin1.not_null() && that_latin1.not_null()) {
+    address this_base = this_latin1().base_address() + this->offset();
+    address that_base = that_latin1().base_address() + that_string->offset();
+    return jvm_memcmp(this_base, that_base, len) == 0;
+  }
+
+  if (this_latin1.not_null()) {
+    TypeArray::Raw that_array = that_string->value();
+    return latin1_matches_chars(
+        (jubyte*)this_latin1().base_address() + this->offset(),
+        (jchar*)that_array().base_address() + that_string->offset(), len);
+  }
+
+  if (that_latin1.not_null()) {
+    TypeArray::Raw this_array = this->value();
+    return latin1_matches_chars(
+        (jubyte*)that_latin1().base_address() + that_string->offset(),
+        (jchar*)this_array().base_address() + this->offset(), len);
+  }
+
   TypeArray::Raw this_array = this->value();
   TypeArray::Raw that_array = that_string->value();
   address this_base = this_array().base_address();
@@ -38,7 +97,7 @@ bool String::matches(String *that_string) {
   this_base += sizeof(jchar) * this->offset();
   that_base += sizeof(jchar) * that_string->offset();
 
-  if (jvm_memcmp(this_base, that_base, count() * 2) == 0) {
+  if (jvm_memcmp(this_base, that_base, len * 2) == 0) {
     return true;
   } else {
     return false;
@@ -46,9 +105,40 @@ bool String::matches(String *that_string) {
 }
 
 juint String::hash() {
+  if (!has_hash_field()) {
+    return compute_hash();
+  }
+  juint value = (juint)int_field(hash_offset());
+  if (value == 0) {
+    value = compute_hash();
+    // ROM strings already carry their hash (see
+    // ROMOptimizer::precompute_string_hashes()), and the TEXT block
+    // may be read-only.
+    if (value != 0 && !ROM::system_text_contains(obj())) {
+      int_field_put(hash_offset(), (jint)value);
+    }
+  }
+  return value;
+}
+
+juint String::compute_hash() {
   AllocationDisabler raw_pointers_used_in_this_function;
 
   juint value = 0;
+  TypeArray::Raw byte_array = this->latin1();
+  if (byte_array.not_null()) {
+    jubyte *ptr = (jubyte*) byte_array().base_address();
+    ptr += this->offset();
+    jubyte *end = ptr + this->count();
+
+    while (ptr < end) {
+      juint chr = (juint)(*ptr);
+      value = 31 * value + chr;
+      ptr++;
+    }
+    return value;
+  }
+
   TypeArray::Raw char_array = this->value();
   jchar *ptr = (jchar*) char_array().base_address();
   ptr += this->offset();
@@ -66,11 +156,18 @@ ReturnOop String::to_cstring(JVM_SINGLE_ARG_TRAPS) {
   UsingFastOops fast_oops;
   int len = count();
   int off = offset();
-  TypeArray::Fast ustring = value();
   TypeArray::Fast cstring = Universe::new_byte_array(len+1 JVM_CHECK_0);
-  jushort *uptr = ((jushort*)ustring().base_address()) + off;
   jubyte  *cptr = (jubyte*)cstring().base_address();
 
+  TypeArray::Raw bytes = latin1();
+  if (bytes.not_null()) {
+    jvm_memcpy(cptr, bytes().base_address() + off, len);
+    return cstring;
+  }
+
+  TypeArray::Fast ustring = value();
+  jushort *uptr = ((jushort*)ustring().base_address()) + off;
+
   for (int i=0; i<len; i++) {
     jushort c = *uptr++;
     *cptr++ = (jubyte)c;
@@ -79,17 +176,22 @@ ReturnOop String::to_cstring(JVM_SINGLE_ARG_TRAPS) {
   return cstring;
 }
 
+ReturnOop String::to_char_array(JVM_SINGLE_ARG_TRAPS) {
+  const int len = count();
+  TypeArray::Raw chars = Universe::new_char_array(len JVM_CHECK_0);
+  get_chars((jchar*)chars().base_address(), 0, len);
+  return chars.obj();
+}
+
 void String::print_string_on(Stream* st, int max_len) {
-  UsingFastOops fast_oops;
-  TypeArray::Fast t = value();
-  int index = offset();
-  int end_index = index + count();
+  int index = 0;
+  int end_index = count();
   int max_index = -1;
   if (max_len >= 0) {
     max_index = index + 100;
   }
   for (; index < end_index; index++) {
-    jchar c =  t().char_at(index);
+    jchar c = char_at(index);
     const char *format = (c == '"')                ? "\\\""
                        : (c <= 0xFF && isprint(c)) ? "%c"
                        : (c == '\n')               ? "\\n"
@@ -104,10 +206,269 @@ void String::print_string_on(Stream* st, int max_len) {
 }
 
 jchar String::char_at(int index) {
+  TypeArray::Raw bytes = latin1();
+  if (bytes.not_null()) {
+    return (jchar)bytes().ubyte_at(index + offset());
+  }
   TypeArray::Raw ta = value();
   return ta().char_at(index + offset());
 }
 
+void String::char_at_put(int index, jchar ch) {
+  TypeArray::Raw bytes = latin1();
+  if (bytes.not_null()) {
+    GUARANTEE(ch <= 0xFF, "not a Latin-1 character");
+    bytes().ubyte_at_put(index + offset(), (jubyte)ch);
+  } else {
+    TypeArray::Raw ta = value();
+    ta().char_at_put(index + offset(), ch);
+  }
+}
+
+void String::get_chars(jchar* buffer, int begin, int length) {
+  AllocationDisabler raw_pointers_used_in_this_function;
+
+  TypeArray::Raw bytes = latin1();
+  if (bytes.not_null()) {
+    const jubyte* src = (jubyte*)bytes().base_address() + offset() + begin;
+    for (const jubyte* end = src + length; src < end; ) {
+      *buffer++ = (jchar)(*src++);
+    }
+  } else {
+    TypeArray::Raw chars = value();
+    const jchar* src = (jchar*)chars().base_address() + offset() + begin;
+    jvm_memcpy(buffer, src, length * sizeof(jchar));
+  }
+}
+
+bool String::fits_latin1() {
+  if (!has_latin1_field()) {
+    return false;
+  }
+  if (is_latin1()) {
+    return true;
+  }
+
+  AllocationDisabler raw_pointers_used_in_this_function;
+  TypeArray::Raw chars = value();
+  return fits_latin1((jchar*)chars().base_address() + offset(), count());
+}
+
+// Word-at-a-time (SWAR) scanning: a juint holds four Latin-1 or two
+// UTF-16 characters. has_zero_byte(x) is non-zero exactly when one of the
+// bytes of x is zero, and likewise has_zero_char(x) for the jchars, so a
+// word is examined character by character only when it holds a match.
+static const juint swar_ones_8   = 0x01010101;
+static const juint swar_highs_8  = 0x80808080;
+static const juint swar_ones_16  = 0x00010001;
+static const juint swar_highs_16 = 0x80008000;
+
+inline static juint has_zero_byte(juint x) {
+  return (x - swar_ones_8) & ~x & swar_highs_8;
+}
+
+inline static juint has_zero_char(juint x) {
+  return (x - swar_ones_16) & ~x & swar_highs_16;
+}
+
+inline static bool is_word_aligned(const void* p) {
+  return (((juint)p) & (sizeof(juint) - 1)) == 0;
+}
+
+// Index of the first <ch> in base[from, end), or -1.
+static int find_byte(const jubyte* base, int from, int end, jubyte ch) {
+  const jubyte* p = base + from;
+  const jubyte* const limit = base + end;
+  for (; p < limit && !is_word_aligned(p); p++) {
+    if (*p == ch) {
+      return p - base;
+    }
+  }
+  const juint pattern = ch * swar_ones_8;
+  for (; limit - p >= (int)sizeof(juint); p += sizeof(juint)) {
+    if (has_zero_byte(*(juint*)p ^ pattern)) {
+      break;
+    }
+  }
+  for (; p < limit; p++) {
+    if (*p == ch) {
+      return p - base;
+    }
+  }
+  return -1;
+}
+
+// Index of the first <ch> in base[from, end), or -1.
+static int find_char(const jchar* base, int from, int end, jchar ch) {
+  const jchar* p = base + from;
+  const jchar* const limit = base + end;
+  for (; p < limit && !is_word_aligned(p); p++) {
+    if (*p == ch) {
+      return p - base;
+    }
+  }
+  const juint pattern = ch * swar_ones_16;
+  for (; (limit - p) * sizeof(jchar) >= sizeof(juint);
+       p += sizeof(juint) / sizeof(jchar)) {
+    if (has_zero_char(*(juint*)p ^ pattern)) {
+      break;
+    }
+  }
+  for (; p < limit; p++) {
+    if (*p == ch) {
+      return p - base;
+    }
+  }
+  return -1;
+}
+
+// Index of the last <ch> in base[0, from], or -1.
+static int find_last_byte(const jubyte* base, int from, jubyte ch) {
+  const jubyte* p = base + from + 1;
+  while (p > base && !is_word_aligned(p)) {
+    if (*--p == ch) {
+      return p - base;
+    }
+  }
+  const juint pattern = ch * swar_ones_8;
+  for (; p - base >= (int)sizeof(juint); p -= sizeof(juint)) {
+    if (has_zero_byte(*(juint*)(p - sizeof(juint)) ^ pattern)) {
+      break;
+    }
+  }
+  while (p > base) {
+    if (*--p == ch) {
+      return p - base;
+    }
+  }
+  return -1;
+}
+
+// Index of the last <ch> in base[0, from], or -1.
+static int find_last_char(const jchar* base, int from, jchar ch) {
+  const jchar* p = base + from + 1;
+  while (p > base && !is_word_aligned(p)) {
+    if (*--p == ch) {
+      return p - base;
+    }
+  }
+  const juint pattern = ch * swar_ones_16;
+  const int chars_per_word = sizeof(juint) / sizeof(jchar);
+  for (; p - base >= chars_per_word; p -= chars_per_word) {
+    if (has_zero_char(*(juint*)(p - chars_per_word) ^ pattern)) {
+      break;
+    }
+  }
+  while (p > base) {
+    if (*--p == ch) {
+      return p - base;
+    }
+  }
+  return -1;
+}
+
+// Index of the first byte where <a> and <b> differ, or <length>.
+static int mismatch_bytes(const jubyte* a, const jubyte* b, int length) {
+  int i = 0;
+  if ((((juint)a ^ (juint)b) & (sizeof(juint) - 1)) == 0) {
+    for (; i < length && !is_word_aligned(a + i); i++) {
+      if (a[i] != b[i]) {
+        return i;
+      }
+    }
+    for (; length - i >= (int)sizeof(juint); i += sizeof(juint)) {
+      if (*(juint*)(a + i) != *(juint*)(b + i)) {
+        break;
+      }
+    }
+  }
+  for (; i < length; i++) {
+    if (a[i] != b[i]) {
+      return i;
+    }
+  }
+  return length;
+}
+
+// The characters of a String in whichever body it uses, starting at the
+// String's offset. Only valid while allocation is disabled.
+class StringChars {
+ public:
+  StringChars(String* str) {
+    _length = str->count();
+    TypeArray::Raw bytes = str->latin1();
+    if (bytes.not_null()) {
+      _bytes = (jubyte*)bytes().base_address() + str->offset();
+      _chars = NULL;
+    } else {
+      TypeArray::Raw chars = str->value();
+      _bytes = NULL;
+      _chars = (jchar*)chars().base_address() + str->offset();
+    }
+  }
+
+  int length() const { return _length; }
+
+  jchar at(int index) const {
+    return (_bytes != NULL) ? (jchar)_bytes[index] : _chars[index];
+  }
+
+  // Index of the first <ch> in [from, end), or -1.
+  int find(jchar ch, int from, int end) const {
+    if (_bytes != NULL) {
+      return (ch > 0xFF) ? -1 : find_byte(_bytes, from, end, (jubyte)ch);
+    }
+    return find_char(_chars, from, end, ch);
+  }
+
+  // Index of the last <ch> in [0, from], or -1.
+  int find_last(jchar ch, int from) const {
+    if (_bytes != NULL) {
+      return (ch > 0xFF) ? -1 : find_last_byte(_bytes, from, (jubyte)ch);
+    }
+    return find_last_char(_chars, from, ch);
+  }
+
+  // Number of leading characters of this[offset, offset + length) that
+  // match other[other_offset, other_offset + length).
+  int mismatch(int offset, const StringChars& other, int other_offset,
+               int length) const {
+    if (_bytes != NULL && other._bytes != NULL) {
+      return mismatch_bytes(_bytes + offset, other._bytes + other_offset,
+                            length);
+    }
+    if (_chars != NULL && other._chars != NULL) {
+      return mismatch_bytes((jubyte*)(_chars + offset),
+                            (jubyte*)(other._chars + other_offset),
+                            length * sizeof(jchar)) / sizeof(jchar);
+    }
+    int i = 0;
+    while (i < length && at(offset + i) == other.at(other_offset + i)) {
+      i++;
+    }
+    return i;
+  }
+
+ private:
+  const jubyte* _bytes;
+  const jchar*  _chars;
+  int           _length;
+};
+
+jint String::index_of(jchar ch, jint fromIndex) {
+  const int len = count();
+  if (fromIndex < 0) {
+    fromIndex = 0;
+  }
+  if (fromIndex >= len) {
+    return -1;
+  }
+
+  AllocationDisabler raw_pointers_used_in_this_function;
+  StringChars chars(this);
+  return chars.find(ch, fromIndex, len);
+}
+
 jint String::last_index_of(jchar ch, jint fromIndex) {
   if (count() == 0 || fromIndex < 0) {
     return -1;
@@ -116,26 +477,122 @@ jint String::last_index_of(jchar ch, jint fromIndex) {
   if (fromIndex >= count()) {
     fromIndex = count() - 1;
   }
-   
-  TypeArray::Raw array = value();
-  const jchar* const base = (jchar*)array().base_address() + offset();
 
-  // Pointer to the start point of the search.
-  const jchar* p = base + fromIndex;
+  AllocationDisabler raw_pointers_used_in_this_function;
+  StringChars chars(this);
+  return chars.find_last(ch, fromIndex);
+}
 
-  do {
-    if (*p == ch) {
-      return p - base;
+jint String::compare_to(String* other) {
+  AllocationDisabler raw_pointers_used_in_this_function;
+  StringChars a(this);
+  StringChars b(other);
+  const int n = min(a.length(), b.length());
+  const int i = a.mismatch(0, b, 0, n);
+  if (i < n) {
+    return (jint)a.at(i) - (jint)b.at(i);
+  }
+  return a.length() - b.length();
+}
+
+bool String::region_matches(jint toffset, String* other, jint ooffset,
+                            jint len) {
+  // Note: toffset, ooffset, or len might be near -1>>>1.
+  if ((ooffset < 0) || (toffset < 0) ||
+      (toffset > (jlong)count() - len) ||
+      (ooffset > (jlong)other->count() - len)) {
+    return false;
+  }
+  if (len <= 0) {
+    return true;
+  }
+
+  AllocationDisabler raw_pointers_used_in_this_function;
+  StringChars a(this);
+  StringChars b(other);
+  return a.mismatch(toffset, b, ooffset, len) == len;
+}
+
+// Below these sizes, building the shift table costs more than it saves.
+static const int horspool_min_pattern = 4;
+static const int horspool_min_text    = 64;
+
+// Boyer-Moore-Horspool search, used for long patterns. The shift table is
+// indexed by the low byte of each character; characters that share a
+// bucket get the smallest of their shifts, which is always safe.
+static int horspool_search(const StringChars& text, const StringChars& pattern,
+                           int from) {
+  const int text_len = text.length();
+  const int pattern_len = pattern.length();
+  const int last = pattern_len - 1;
+
+  int shift[256];
+  int i;
+  for (i = 0; i < 256; i++) {
+    shift[i] = pattern_len;
+  }
+  for (i = 0; i < last; i++) {
+    shift[pattern.at(i) & 0xFF] = last - i;
+  }
+
+  const jchar last_char = pattern.at(last);
+  for (i = from; i <= text_len - pattern_len; ) {
+    const jchar c = text.at(i + last);
+    if (c == last_char && text.mismatch(i, pattern, 0, last) == last) {
+      return i;
     }
-  } while (--p >= base);
+    i += shift[c & 0xFF];
+  }
+  return -1;
+}
 
+jint String::index_of(String* str, jint fromIndex) {
+  const int len = count();
+  const int str_len = str->count();
+  if (fromIndex >= len) {
+    // There is an empty string at index 0 in an empty string.
+    // Note: fromIndex might be near -1>>>1.
+    return (len == 0 && fromIndex == 0 && str_len == 0) ? 0 : -1;
+  }
+  if (fromIndex < 0) {
+    fromIndex = 0;
+  }
+  if (str_len == 0) {
+    return fromIndex;
+  }
+  if (str_len > len - fromIndex) {
+    return -1;
+  }
+
+  AllocationDisabler raw_pointers_used_in_this_function;
+  StringChars text(this);
+  StringChars pattern(str);
+
+  if (str_len >= horspool_min_pattern &&
+      len - fromIndex >= horspool_min_text) {
+    return horspool_search(text, pattern, fromIndex);
+  }
+
+  // Short pattern: scan for the first character a word at a time, then
+  // compare the rest.
+  const jchar first = pattern.at(0);
+  const int max = len - str_len;
+  for (int i = fromIndex; i <= max; i++) {
+    i = text.find(first, i, max + 1);
+    if (i < 0) {
+      break;
+    }
+    if (text.mismatch(i + 1, pattern, 1, str_len - 1) == str_len - 1) {
+      return i;
+    }
+  }
   return -1;
 }
 
 #if !defined(PRODUCT) || ENABLE_TTY_TRACE
 void String::print_value_on(Stream* st) {
   TypeArray::Raw t = value();
-  if (t.is_null()) {
+  if (t.is_null() && !is_latin1()) {
     st->print("(uninitialized)");
   } else {
     st->print("String \"");
@@ -28,9 +28,15 @@
 // Example: new java.lang.Object();
 
 class String : public Instance {
+  static bool _has_latin1_field;
+  static bool _has_hash_field;
+
+  juint compute_hash();
+
  public:
   static int value_offset()  { return header_size() + 0; }
   void set_value(Oop* value)  { obj_field_put(value_offset(), value);  }
+  void clear_value()          { obj_field_clear(value_offset());       }
 
   HANDLE_DEFINITION(String, Instance);
 
@@ -43,6 +49,42 @@ class String : public Instance {
   static int count_offset(){
     return header_size() + sizeof(jobject) + sizeof(jint);
   }
+  // A String whose characters all fit in ISO-8859-1 may keep them in a
+  // byte[] body (latin1), one byte per character, and leave value NULL.
+  // Exactly one of the two bodies is set, and offset applies to
+  // whichever one is used. The field exists only in class libraries that
+  // support compact strings -- see has_latin1_field().
+  static int latin1_offset(){
+    return header_size() + sizeof(jobject) + 2 * sizeof(jint);
+  }
+
+  // The hash code is cached in an int field right after latin1, with 0
+  // meaning "not computed yet". The romizer fills it in for all ROM
+  // strings, so the VM never has to write into a ROM string.
+  static int hash_offset(){
+    return latin1_offset() + sizeof(jobject);
+  }
+
+  // The size of the String instances allocated by the hand-written
+  // native entries, which is fixed when the VM is built: only the
+  // cldc1.1.1 class library (ENABLE_CLDC_111) has latin1 and hash.
+  static int generated_instance_size() {
+#if ENABLE_CLDC_111
+    return hash_offset() + sizeof(jint);
+#else
+    return count_offset() + sizeof(jint);
+#endif
+  }
+
+  // Called once the java.lang.String class is available.
+  static void initialize_layout();
+  static bool has_latin1_field() {
+    return _has_latin1_field;
+  }
+  static bool has_hash_field() {
+    return _has_hash_field;
+  }
+  static bool fits_latin1(const jchar* chars, int length);
 
  public:
   // ^TypeArray
@@ -50,6 +92,23 @@ class String : public Instance {
     return obj_field(value_offset());
   }
 
+  // ^TypeArray, or NULL when the string uses the UTF-16 body
+  ReturnOop latin1() {
+    return has_latin1_field() ? obj_field(latin1_offset()) : (ReturnOop)NULL;
+  }
+  void set_latin1(Oop* value) {
+    GUARANTEE(has_latin1_field(), "no compact body in this String class");
+    obj_field_put(latin1_offset(), value);
+  }
+  void clear_latin1() {
+    if (has_latin1_field()) {
+      obj_field_clear(latin1_offset());
+    }
+  }
+  bool is_latin1() {
+    return latin1() != NULL;
+  }
+
   jint offset() {
     return int_field(offset_offset());
   }
@@ -85,6 +144,25 @@ class String : public Instance {
 #endif
 
   jchar char_at(int index);
+  // Only used while the VM builds a new string.
+  void char_at_put(int index, jchar ch);
+
+  // Copy <length> characters starting at <begin> into <buffer>.
+  void get_chars(jchar* buffer, int begin, int length);
+
+  // Return a new char[] holding the characters of this string.
+  ReturnOop to_char_array(JVM_SINGLE_ARG_TRAPS);
 
+  // True if every character of this string fits in ISO-8859-1.
+  bool fits_latin1();
+
+  jint index_of(jchar ch, jint fromIndex);
   jint last_index_of(jchar ch, jint fromIndex);
+
+  // Same semantics as the java.lang.String methods of the same name
+  // (region_matches is the case-sensitive variant). <other> and <str>
+  // must not be NULL.
+  jint compare_to(String* other);
+  bool region_matches(jint toffset, String* other, jint ooffset, jint len);
+  jint index_of(String* str, jint fromIndex);
 };
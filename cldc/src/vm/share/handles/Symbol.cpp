@@ -311,12 +311,9 @@ ReturnOop Symbol::copy_string_to_byte_array(OopDesc* str, bool slashify JVM_TRAP
   utf8 start = (utf8)byte_array().base_address();
   utf8 to = start;
 
-  TypeArray::Fast jchar_array = string().value();
-  jchar *from = (jchar *) jchar_array().base_address();
-  from += string().offset();
-
-  for( jchar* const end = from + string().count(); from < end; from++) {
-    jchar c = *from; 
+  const int count = string().count();
+  for (int i = 0; i < count; i++) {
+    jchar c = string().char_at(i);
     if( slashify ) {
       switch( c ) {
         case '.': c = '/'; break;
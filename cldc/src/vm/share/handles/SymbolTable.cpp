@@ -288,3 +288,28 @@ void SymbolTable::grow_and_replace_symbol_table( void ) {
   Task::current()->set_symbol_table(new_table);
 #endif
 }
+
+void SymbolTable::print_statistics(Stream* st) {
+  const juint mask = juint(length() - 1);
+  int count = 0;
+  int total_probes = 0;
+  int max_probes = 0;
+
+  for (juint i = 0; i <= mask; i++) {
+    Symbol::Raw symbol = obj_at(i);
+    if (symbol.not_null()) {
+      const int probes = (int)((i - (hash(&symbol) & mask)) & mask) + 1;
+      total_probes += probes;
+      if (probes > max_probes) {
+        max_probes = probes;
+      }
+      count ++;
+    }
+  }
+
+  // Average number of probes for finding a symbol, in hundredths.
+  const int avg = (count == 0) ? 0 : (total_probes * 100 / count);
+  st->print_cr("symbol table: %d slots, %d symbols, "
+               "probes avg %d.%02d max %d", length(), count,
+               avg / 100, avg % 100, max_probes);
+}
@@ -76,6 +76,10 @@ public:
     return Universe::new_obj_array(size JVM_NO_CHECK_AT_BOTTOM);
   }
 
+  // Prints the size and load of the symbol table, and the number of
+  // probes needed to find the symbols in it.
+  void print_statistics(Stream* st);
+
 private:
   // This is the main work-horse for looking up (and optionally creating)
   // a Symbol. The UTF8 source of the symbol may come from either byte_array,
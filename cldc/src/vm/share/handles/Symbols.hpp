@@ -32,6 +32,7 @@
   template(java_lang_Object,       "java/lang/Object")                      \
   template(java_lang_Class,        "java/lang/Class")                       \
   template(java_lang_String,       "java/lang/String")                      \
+  template(java_lang_StringBuffer, "java/lang/StringBuffer")                \
   template(java_lang_System,       "java/lang/System")                      \
   template(java_lang_Thread,       "java/lang/Thread")                      \
   template(java_lang_Throwable,    "java/lang/Throwable")                   \
@@ -92,6 +93,9 @@
   template(min_name,               "min")                                   \
   template(max_name,               "max")                                   \
   template(abs_name,               "abs")                                   \
+  template(sqrt_name,              "sqrt")                                  \
+  template(floor_name,             "floor")                                 \
+  template(ceil_name,              "ceil")                                  \
   template(internal_exit_name,     "internalExit")                          \
   template(println_name,           "println")                               \
   template(printStackTrace_name,   "printStackTrace")                       \
@@ -102,6 +106,8 @@
   template(create_sys_image_name,  "createSysImage")                        \
   template(create_app_image_name,  "createAppImage")                        \
   template(arraycopy_name,         "arraycopy")                             \
+  template(append_name,            "append")                                \
+  template(to_string_name,         "toString")                              \
   template(unchecked_byte_arraycopy_name,  "unchecked_byte_arraycopy")      \
   template(unchecked_char_arraycopy_name,  "unchecked_char_arraycopy")      \
   template(unchecked_int_arraycopy_name,   "unchecked_int_arraycopy")       \
@@ -118,6 +124,7 @@
                                    "(Ljava/lang/String;)V")                 \
   sig_template(char_array_char_array_int_void_signature,                    \
                                 "([C[CI)V") \
+  sig_template(int_void_signature, "(I)V")                                   \
   sig_template(void_signature,     "()V")
 
 #if ENABLE_CLDC_11
@@ -644,6 +644,7 @@ bool Universe::bootstrap_with_rom(const JvmPathChar* classpath) {
       JVM_FATAL(bootstrap_heap_too_small);
     }
   }
+  String::initialize_layout();
 
   // Allocate sleep queue in system area
   *(OopDesc**)scheduler_waiting() =
@@ -894,6 +895,7 @@ bool Universe::bootstrap_without_rom(const JvmPathChar* classpath) {
   // Load remaining root classes.
   load_root_class(string_class(),
                   Symbols::java_lang_String());
+  String::initialize_layout();
   load_root_class(system_class(),
                   Symbols::java_lang_System());
   load_root_class(math_class(),
@@ -1274,6 +1276,7 @@ void Universe::apocalypse() {
   _is_bootstrapping = true;
   _is_stopping      = false;
   set_number_of_java_classes(0);
+  JavaClass::flush_subtype_check_cache();
   ExecutionStackDesc::_stack_list = NULL;
 
 #if ENABLE_ISOLATES
@@ -1516,6 +1519,7 @@ void Universe::register_java_class(JavaClass *klass) {
 #if ENABLE_ISOLATES
   Task::current()->set_class_count(class_id + 1);
 #endif
+  JavaClass::flush_subtype_check_cache();
 }
 
 void Universe::unregister_last_java_class() {
@@ -1525,6 +1529,7 @@ void Universe::unregister_last_java_class() {
   Task::current()->set_class_count(class_id);
 #endif
   set_number_of_java_classes(class_id);
+  JavaClass::flush_subtype_check_cache();
 }
 
 // This is called after we load a real class to replace a fake class of
@@ -1542,6 +1547,7 @@ void Universe::pop_class_id(InstanceClass *new_cls, InstanceClass *old_cls)
   ClassInfo::Raw info = new_cls->class_info();
   info().set_class_id(old_index);
   set_number_of_java_classes(class_id);
+  JavaClass::flush_subtype_check_cache();
 }
 
 ReturnOop Universe::new_obj_array(int length JVM_TRAPS) {
@@ -1576,14 +1582,21 @@ ReturnOop Universe::interned_string_from_utf8(Oop *oop JVM_TRAPS) {
 
   s().set_offset(0);
   s().set_count(length);
-  TypeArray::Fast t = new_char_array(length JVM_CHECK_0);
-  s().set_value(&t);
+  const bool compact = String::has_latin1_field();
+  TypeArray::Fast t;
+  if (compact) {
+    // ASCII is a subset of Latin-1, so the bytes can be used as they are.
+    t = new_byte_array(length JVM_CHECK_0);
+    s().set_latin1(&t);
+  } else {
+    t = new_char_array(length JVM_CHECK_0);
+    s().set_value(&t);
+  }
 
   {
     AllocationDisabler raw_pointers_used_in_this_block;
     jubyte *src;
     jubyte *src_end;
-    jchar  *dst = (jchar*) t().base_address();
     jint mask = 0x80;
 
     if (is_symbol) {
@@ -1593,13 +1606,25 @@ ReturnOop Universe::interned_string_from_utf8(Oop *oop JVM_TRAPS) {
     }
     src_end = src + length;
 
-    while (src < src_end) {
-      juint b = (jint)(*src++);
-      if ((b == 0) || (b & mask) != 0) {
-        // This string contains non-ascii chars. Let's go to slow case
-        goto slow;
+    if (compact) {
+      jubyte *dst = (jubyte*) t().base_address();
+      while (src < src_end) {
+        juint b = (jint)(*src++);
+        if ((b == 0) || (b & mask) != 0) {
+          goto slow;
+        }
+        *dst++ = (jubyte)(b);
+      }
+    } else {
+      jchar  *dst = (jchar*) t().base_address();
+      while (src < src_end) {
+        juint b = (jint)(*src++);
+        if ((b == 0) || (b & mask) != 0) {
+          // This string contains non-ascii chars. Let's go to slow case
+          goto slow;
+        }
+        *dst++ = (jchar)(b);
       }
-      *dst++ = (jchar)(b);
     }
   }
 
@@ -1657,11 +1682,55 @@ ReturnOop Universe::new_string(CharacterStream* stream, int lead_spaces,
     stream_length + lead_spaces + trail_spaces : 0;
   s().set_offset(0);
   s().set_count(length);
-  TypeArray::Fast t = new_char_array(length JVM_CHECK_0);
-  s().set_value(&t);
+
+  // The characters read from <stream>; the padding is filled in by the
+  // caller.
+  const jint stream_chars = length - lead_spaces - trail_spaces;
+  bool compact = String::has_latin1_field();
+  if (compact) {
+    stream->reset();
+    for (int i = 0; i < stream_chars; i++) {
+      if (stream->read() > 0xFF) {
+        compact = false;
+        break;
+      }
+    }
+  }
+
   stream->reset();
-  for (int index = lead_spaces; index < length; index++) {
-    t().char_at_put(index, stream->read());
+  if (compact) {
+    TypeArray::Fast t = new_byte_array(length JVM_CHECK_0);
+    s().set_latin1(&t);
+    for (int i = 0; i < stream_chars; i++) {
+      t().ubyte_at_put(lead_spaces + i, (jubyte)stream->read());
+    }
+  } else {
+    TypeArray::Fast t = new_char_array(length JVM_CHECK_0);
+    s().set_value(&t);
+    for (int index = lead_spaces; index < length; index++) {
+      t().char_at_put(index, stream->read());
+    }
+  }
+  return s;
+}
+
+ReturnOop Universe::new_string(const jchar* chars, int length JVM_TRAPS) {
+  UsingFastOops fast_oops;
+  String::Fast s = new_instance(string_class() JVM_CHECK_0);
+  s().set_offset(0);
+  s().set_count(length);
+
+  if (String::has_latin1_field() && String::fits_latin1(chars, length)) {
+    TypeArray::Fast t = new_byte_array(length JVM_CHECK_0);
+    s().set_latin1(&t);
+    jubyte *dst = (jubyte*) t().base_address();
+    for (int i = 0; i < length; i++) {
+      dst[i] = (jubyte)chars[i];
+    }
+  } else {
+    TypeArray::Fast t = new_char_array(length JVM_CHECK_0);
+    s().set_value(&t);
+    jvm_memcpy(t().base_address(), chars, length * sizeof(jchar));
   }
   return s;
 }
@@ -1678,6 +1747,19 @@ ReturnOop Universe::new_string(TypeArray *char_array, int offset, int length
   return s;
 }
 
+ReturnOop Universe::new_latin1_string(TypeArray *byte_array, int offset,
+                                      int length JVM_TRAPS) {
+  GUARANTEE(String::has_latin1_field(), "no compact body in String class");
+  String::Raw s = new_instance(string_class() JVM_NO_CHECK);
+  if (s.not_null()) {
+    s().set_latin1(byte_array);
+    s().set_offset(offset);
+    s().set_count(length);
+  }
+
+  return s;
+}
+
 ReturnOop Universe::new_symbol(TypeArray *byte_array, utf8 name, int length
                                JVM_TRAPS) {
   int byte_array_offset = 0;
@@ -2263,14 +2345,11 @@ ReturnOop Universe::copy_strings_to_char_arrays(OopDesc* strings JVM_TRAPS) {
   ObjArray::Fast result = new_obj_array(char_array_class(), length
                                         JVM_OZCHECK(result));
   String::Fast s;
-  TypeArray::Fast chars, chars_copy;
+  TypeArray::Fast chars_copy;
 
   for (int i = 0; i < length; i++) {
     s = string_array().obj_at(i);
-    chars = s().value();
-    int char_count = s().count();
-    chars_copy = Universe::new_char_array(char_count JVM_OZCHECK(chars_copy));
-    TypeArray::array_copy(&chars, s().offset(), &chars_copy, 0, char_count);
+    chars_copy = s().to_char_array(JVM_SINGLE_ARG_OZCHECK(chars_copy));
     result().obj_at_put(i, &chars_copy);
   }
   return result;
@@ -2312,6 +2391,14 @@ ReturnOop Universe::deep_copy(OopDesc* obj JVM_TRAPS) {
     String::Fast orig = obj;
     const int offset = orig().offset();
     const int length = orig().count();
+    TypeArray::Fast orig_latin1 = orig().latin1();
+    if (orig_latin1.not_null()) {
+      TypeArray::Fast copy_latin1 =
+          new_byte_array(length JVM_OZCHECK(copy_latin1));
+      TypeArray::array_copy(&orig_latin1, offset, &copy_latin1, 0, length);
+      return new_latin1_string(&copy_latin1, 0, length
+                               JVM_NO_CHECK_AT_BOTTOM);
+    }
     TypeArray::Fast orig_value = orig().value();
     TypeArray::Fast copy_value = new_char_array(length JVM_OZCHECK(copy_value));
     TypeArray::array_copy(&orig_value, offset, &copy_value, 0, length);
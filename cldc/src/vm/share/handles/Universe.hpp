@@ -90,6 +90,13 @@ class Universe: public AllStatic {
                               int trail_spaces JVM_TRAPS);
   static ReturnOop new_string(TypeArray *char_array, int offset, int length
                               JVM_TRAPS);
+  // Uses the compact Latin-1 body when possible. <chars> must not point
+  // into the object heap.
+  static ReturnOop new_string(const jchar* chars, int length JVM_TRAPS);
+  // Allocate a String over a byte[] of ISO-8859-1 characters. Only valid
+  // if String::has_latin1_field().
+  static ReturnOop new_latin1_string(TypeArray *byte_array, int offset,
+                                     int length JVM_TRAPS);
   static ReturnOop interned_string_for(CharacterStream *stream JVM_TRAPS);
   static ReturnOop interned_string_for(String *string JVM_TRAPS);
   static ReturnOop interned_string_from_utf8(Oop *oop JVM_TRAPS);
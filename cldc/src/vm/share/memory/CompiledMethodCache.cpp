@@ -45,6 +45,9 @@ CompiledMethodCache::Item* CompiledMethodCache::_patched_method;
 CompiledMethodCache::weight_type CompiledMethodCache::_aligned_weights;
 #define weights _aligned_weights._weights
 
+CompiledMethodCache::History
+CompiledMethodCache::_history[ CompiledMethodCache::HistorySize ];
+
 inline void CompiledMethodCache::lock( const int i ) {
   weights[ i ] |= Byte(LockMask);
 }
@@ -82,6 +85,91 @@ inline void CompiledMethodCache::set_index( Item* p, const int i ) {
   p->set_cache_index( i );
 }
 
+CompiledMethodCache::History*
+CompiledMethodCache::history_for( const MethodDesc* m, const bool create ) {
+  const Method::Raw method = (MethodDesc*) m;
+  const jushort holder_id = method().holder_id();
+  const jushort name_index = method().name_index();
+  const jushort signature_index = method().signature_index();
+
+  const unsigned hash =
+    unsigned(holder_id) * 31 + unsigned(name_index) * 7 + signature_index;
+  History* victim = NULL;
+  for( int probe = 0; probe < HistoryProbes; probe++ ) {
+    History* h = _history + ((hash + probe) & (HistorySize - 1));
+    if( h->compilations == 0 ) {
+      if( victim == NULL || victim->compilations != 0 ) {
+        victim = h;
+      }
+      continue;
+    }
+    if( h->holder_id == holder_id && h->name_index == name_index &&
+        h->signature_index == signature_index ) {
+      return h;
+    }
+    if( victim == NULL || h->compilations < victim->compilations ) {
+      victim = h;
+    }
+  }
+
+  if( !create ) {
+    return NULL;
+  }
+  jvm_memset( victim, 0, sizeof *victim );
+  victim->holder_id = holder_id;
+  victim->name_index = name_index;
+  victim->signature_index = signature_index;
+  return victim;
+}
+
+inline void CompiledMethodCache::record_compilation( const Item* p ) {
+  History* h = history_for( p->method(), true );
+  if( h->compilations < 0xFF ) {
+    h->compilations++;
+  }
+  h->bytes += get_size( p );
+
+  if( h->flags & HistoryEvicted ) {
+    h->flags &= ~HistoryEvicted;
+    if( h->recompilations < 0xFF ) {
+      h->recompilations++;
+    }
+    PERFORMANCE_COUNTER_INCREMENT(compiled_method_recompilations, 1);
+
+    if( CompiledMethodPinThreshold > 0 &&
+        h->recompilations >= CompiledMethodPinThreshold &&
+        !(h->flags & HistoryPinned) ) {
+      h->flags |= HistoryPinned;
+      PERFORMANCE_COUNTER_INCREMENT(compiled_method_pins, 1);
+#ifndef PRODUCT
+      if( TraceCompiledMethodCache ) {
+        TTY_TRACE(( "\nPinning " ));
+        item_print( p );
+        tty->cr();
+      }
+#endif
+    }
+  }
+}
+
+inline void CompiledMethodCache::record_eviction( const Item* p ) {
+  PERFORMANCE_COUNTER_INCREMENT(compiled_method_evictions, 1);
+  PERFORMANCE_COUNTER_INCREMENT(compiled_method_evicted_bytes, get_size(p));
+
+  History* h = history_for( p->method(), false );
+  if( h != NULL ) {
+    if( h->evictions < 0xFF ) {
+      h->evictions++;
+    }
+    h->flags |= HistoryEvicted;
+  }
+}
+
+inline bool CompiledMethodCache::is_pinned( const Item* p ) {
+  const History* h = history_for( p->method(), false );
+  return h != NULL && (h->flags & HistoryPinned) != 0;
+}
+
 inline void CompiledMethodCache::lock ( const Item* p ) {
   if( has_index( p ) ) {
     const int i = get_index( p );
@@ -150,6 +238,7 @@ void CompiledMethodCache::insert( Item* p ) {
   _method_execution_sensor[ i ] = 0xFF; // To avoid double increment
   Map[ i ] = p;
   size += get_size( p );
+  record_compilation( p );
 
 #if ENABLE_PERFORMANCE_COUNTERS && SUPPORTS_PROFILER_CONTROL
   {
@@ -169,6 +258,7 @@ void CompiledMethodCache::init( void ) {
   last_old = -1;
   jvm_memset( Map, 0, sizeof Map );
   jvm_memset( weights, 0, sizeof weights );
+  jvm_memset( _history, 0, sizeof _history );
   method_execution_sensor_reset();
   if( TraceCompiledMethodCache ) {
     TTY_TRACE_CR(( "CompiledMethodCache::init()" ));
@@ -225,6 +315,25 @@ void CompiledMethodCache::lock_unevictable ( void ) {
     }
   }
 
+  // Methods that keep being recompiled after eviction are protected as
+  // long as they are still executed (have a non-zero weight). At most half
+  // of the compiled code is pinned, so that eviction can always make
+  // progress.
+  {
+    const int upb = CompiledMethodCache::upb;
+    size_t pinned_size = 0;
+    for( int i = 0; i <= upb; i++ ) {
+      if( weights[ i ] != 0 && is_pinned( Map[ i ] ) ) {
+        const size_t item_size = get_size( Map[ i ] );
+        if( pinned_size + item_size > (size >> 1) ) {
+          break;
+        }
+        pinned_size += item_size;
+        lock( i );
+      }
+    }
+  }
+
   ForAllThreads( thread ) {
     for( Frame frame( &thread() );; ) {
       if( frame.is_entry_frame() ) {
@@ -474,6 +583,7 @@ void CompiledMethodCache::evict_zero_weight( void ) {
       set_index( p, dst );
     } else {
       size -= get_size( p );
+      record_eviction( p );
       free( p );
     }
   }  
@@ -518,6 +628,43 @@ void CompiledMethodCache::compute_last_old( const Item* const threshold ) {
   last_old = i;
 }
 
+// Available in product builds, so that the eviction behavior of a real
+// deployment can be examined. Names are printed from the original
+// (non-renamed) symbols, since Method::print_name_on() is debug-only.
+void CompiledMethodCache::print_statistics( void ) {
+  tty->print_cr("Compiled method history (compiled/evicted/recompiled/bytes):");
+  for( int i = 0; i < HistorySize; i++ ) {
+    const History* h = _history + i;
+    if( h->compilations == 0 ) {
+      continue;
+    }
+    tty->print("%3d %3d %3d %7d %s", h->compilations, h->evictions,
+               h->recompilations, h->bytes,
+               (h->flags & HistoryPinned) ? "pinned " : "");
+
+    // Find the method by its name and signature indices
+    if( h->holder_id < TaskContext::number_of_java_classes() ) {
+      InstanceClass::Raw klass = Universe::class_from_id(h->holder_id);
+      ObjArray::Raw methods = klass().methods();
+      Method::Raw m;
+      const int len = methods().length();
+      for( int j = 0; j < len; j++ ) {
+        m = methods().obj_at(j);
+        if( m.not_null() && m().name_index() == h->name_index &&
+            m().signature_index() == h->signature_index ) {
+          Symbol::Raw class_name = klass().original_name();
+          Symbol::Raw method_name = m().get_original_name();
+          tty->print("%.*s.%.*s",
+                     (int)class_name().length(), class_name().base_address(),
+                     (int)method_name().length(), method_name().base_address());
+          break;
+        }
+      }
+    }
+    tty->cr();
+  }
+}
+
 #ifndef PRODUCT
 void CompiledMethodCache::verify() {
   ForAllThreads( thread ) {
@@ -29,6 +29,7 @@
  */
 
 class CompiledMethodDesc;
+class MethodDesc;
 
 class CompiledMethodCache {
 public:
@@ -82,6 +83,10 @@ public:
 #ifndef PRODUCT
   static void dump( void );
 #endif
+
+  // Print the per-method compilation, eviction and recompilation counts
+  static void print_statistics( void );
+
 //private:      // ADS compiler does not like private datatypes
   typedef unsigned char Byte;   // The shortest fast native integer
   typedef unsigned long DWord;  // The longest of the fast aligned integer types
@@ -155,6 +160,36 @@ public:
 
   static void verify() PRODUCT_RETURN;
 
+  // Recompilation tracking. The history survives the eviction of the
+  // compiled code, so a method that is repeatedly evicted and compiled
+  // again can be detected. Methods are identified by their holder id and
+  // the name and signature indices, which do not change when the method
+  // object is moved by the GC. The table is a small hash table; when its
+  // probe window is full, the least compiled record in the window is
+  // reused.
+  struct History {
+    jushort holder_id;
+    jushort name_index;
+    jushort signature_index;
+    Byte    compilations;     // Saturated at 0xFF; 0 means an empty slot
+    Byte    evictions;        // Saturated at 0xFF
+    Byte    recompilations;   // Compilations following an eviction
+    Byte    flags;
+    juint   bytes;            // Total size of the code compiled
+  };
+  enum {
+    HistorySize     = 64,     // Must be a power of 2
+    HistoryProbes   = 8,
+    HistoryEvicted  = 1 << 0, // Evicted since the last compilation
+    HistoryPinned   = 1 << 1  // Protected from eviction while it runs
+  };
+  static History _history[ HistorySize ];
+
+  static History* history_for( const MethodDesc* m, const bool create );
+  static inline void record_compilation( const Item* p );
+  static inline void record_eviction   ( const Item* p );
+  static inline bool is_pinned         ( const Item* p );
+
 #if ENABLE_COMPILER && ENABLE_ISOLATES
   static void cleanup_unmarked ( void );
 #endif
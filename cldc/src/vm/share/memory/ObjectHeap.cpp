@@ -4590,6 +4590,9 @@ void ObjectHeap::compact_and_move_compiler_area(const int compiler_area_shift) {
     OsMisc_flush_icache((address)_compiler_area_start,
                         DISTANCE(_compiler_area_start, _compiler_area_top));
   }
+#if ENABLE_PERF_MAP
+  PerfMap::compiler_area_changed();
+#endif
   EventLogger::end(EventLogger::COMPILER_GC);
 
   DIRTY_HEAP(_inline_allocation_top,
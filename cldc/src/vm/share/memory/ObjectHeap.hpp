@@ -418,6 +418,9 @@ public:
   static address glue_code_start() {
     return _glue_code;
   }
+  static size_t glue_code_size() {
+    return _glue_code_size;
+  }
   static void finalize_all( void ) {
     finalize( _finalizer_reachable );
     finalize( _finalizer_pending   );
@@ -345,7 +345,7 @@ StackmapGenerator::compress_verifier_stackmaps(InstanceClass *ic JVM_TRAPS) {
 
     // Compress verifier stackmaps into
     // space conserving reference-only stackmap
-    method_stackmap = method().stackmaps();
+    method_stackmap = ClassFileParser::expand_stackmaps(&method JVM_CHECK);
 
     gc_stackmap = Universe::gc_block_stackmap(); 
     // max_execution_stack_count() returns maximum stack +
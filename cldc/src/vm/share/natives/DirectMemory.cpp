@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) Max Mu
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License version 2 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * Please visit www.joshvm.org if you need additional information or
+ * have any questions.
+ */
+
+/*
+ * Natives of org.joshvm.util.DirectMemory, the native (non-heap) storage
+ * behind direct ByteBuffers.
+ *
+ * A block is allocated with OsMemory_allocate() and released by the native
+ * finalizer of its DirectMemory object, so it lives exactly as long as the
+ * last ByteBuffer view that refers to it. Addresses are passed to and from
+ * Java as ints (the VM is 32-bit only). All range checks are done by
+ * ByteBuffer before calling in here; multi-byte values are assembled one
+ * byte at a time so that unaligned accesses are safe on every port.
+ */
+
+#include "incls/_precompiled.incl"
+#include "incls/_DirectMemory.cpp.incl"
+
+extern "C" {
+
+static inline jubyte* direct_address(jint address) {
+  return (jubyte*)address;
+}
+
+static jlong get_direct_value(jint address, int size, jboolean big_endian) {
+  const jubyte* p = direct_address(address);
+  julong value = 0;
+  if (big_endian) {
+    for (int i = 0; i < size; i++) {
+      value = (value << 8) | p[i];
+    }
+  } else {
+    for (int i = size - 1; i >= 0; i--) {
+      value = (value << 8) | p[i];
+    }
+  }
+  return (jlong)value;
+}
+
+static void put_direct_value(jint address, int size, jboolean big_endian,
+                             jlong value) {
+  jubyte* p = direct_address(address);
+  julong v = (julong)value;
+  if (big_endian) {
+    for (int i = size - 1; i >= 0; i--) {
+      p[i] = (jubyte)v;
+      v >>= 8;
+    }
+  } else {
+    for (int i = 0; i < size; i++) {
+      p[i] = (jubyte)v;
+      v >>= 8;
+    }
+  }
+}
+
+// private static native int allocate0(int size);
+jint Java_org_joshvm_util_DirectMemory_allocate0(JVM_SINGLE_ARG_TRAPS) {
+  const jint size = KNI_GetParameterAsInt(1);
+  const size_t bytes = size > 0 ? (size_t)size : 1;
+
+  void* block = OsMemory_allocate(bytes);
+  if (block == NULL) {
+    // Unreachable buffers only give their memory back when their
+    // finalizers run, which happens at the end of a collection.
+    ObjectHeap::full_collect(JVM_SINGLE_ARG_CHECK_0);
+    block = OsMemory_allocate(bytes);
+    if (block == NULL) {
+      Throw::out_of_memory_error(JVM_SINGLE_ARG_THROW_0);
+    }
+  }
+  jvm_memset(block, 0, bytes);
+  return (jint)block;
+}
+
+// private native void finalize();
+void Java_org_joshvm_util_DirectMemory_finalize() {
+  KNI_StartHandles(2);
+  KNI_DeclareHandle(thisObj);
+  KNI_DeclareHandle(clazz);
+  KNI_GetThisPointer(thisObj);
+  KNI_GetObjectClass(thisObj, clazz);
+
+  jfieldID address_id = KNI_GetFieldID(clazz, "address", "I");
+  jint address = KNI_GetIntField(thisObj, address_id);
+  if (address != 0) {
+    OsMemory_free((void*)address);
+    KNI_SetIntField(thisObj, address_id, 0);
+  }
+  KNI_EndHandles();
+}
+
+// static native boolean isBigEndian0();
+jint Java_org_joshvm_util_DirectMemory_isBigEndian0() {
+  const jint probe = 1;
+  return *(const jubyte*)&probe == 0 ? KNI_TRUE : KNI_FALSE;
+}
+
+// static native byte getByte(int address);
+jint Java_org_joshvm_util_DirectMemory_getByte() {
+  return (jbyte)*direct_address(KNI_GetParameterAsInt(1));
+}
+
+// static native void putByte(int address, byte value);
+void Java_org_joshvm_util_DirectMemory_putByte() {
+  *direct_address(KNI_GetParameterAsInt(1)) =
+      (jubyte)KNI_GetParameterAsInt(2);
+}
+
+// static native short getShort(int address, boolean bigEndian);
+jint Java_org_joshvm_util_DirectMemory_getShort() {
+  return (jshort)get_direct_value(KNI_GetParameterAsInt(1), sizeof(jshort),
+                                  KNI_GetParameterAsBoolean(2));
+}
+
+// static native void putShort(int address, short value, boolean bigEndian);
+void Java_org_joshvm_util_DirectMemory_putShort() {
+  put_direct_value(KNI_GetParameterAsInt(1), sizeof(jshort),
+                   KNI_GetParameterAsBoolean(3), KNI_GetParameterAsInt(2));
+}
+
+// static native int getInt(int address, boolean bigEndian);
+jint Java_org_joshvm_util_DirectMemory_getInt() {
+  return (jint)get_direct_value(KNI_GetParameterAsInt(1), sizeof(jint),
+                                KNI_GetParameterAsBoolean(2));
+}
+
+// static native void putInt(int address, int value, boolean bigEndian);
+void Java_org_joshvm_util_DirectMemory_putInt() {
+  put_direct_value(KNI_GetParameterAsInt(1), sizeof(jint),
+                   KNI_GetParameterAsBoolean(3), KNI_GetParameterAsInt(2));
+}
+
+// static native long getLong(int address, boolean bigEndian);
+jlong Java_org_joshvm_util_DirectMemory_getLong() {
+  return get_direct_value(KNI_GetParameterAsInt(1), sizeof(jlong),
+                          KNI_GetParameterAsBoolean(2));
+}
+
+// static native void putLong(int address, long value, boolean bigEndian);
+void Java_org_joshvm_util_DirectMemory_putLong() {
+  // The long value occupies parameter slots 2 and 3.
+  put_direct_value(KNI_GetParameterAsInt(1), sizeof(jlong),
+                   KNI_GetParameterAsBoolean(4), KNI_GetParameterAsLong(2));
+}
+
+// static native void copyToArray(int address, byte[] dst, int offset,
+//                                int length);
+void Java_org_joshvm_util_DirectMemory_copyToArray() {
+  TypeArray::Raw dst = GET_PARAMETER_AS_OOP(2);
+  const jint offset = KNI_GetParameterAsInt(3);
+  const jint length = KNI_GetParameterAsInt(4);
+  jvm_memcpy(dst().byte_base_address() + offset,
+             direct_address(KNI_GetParameterAsInt(1)), length);
+}
+
+// static native void copyFromArray(byte[] src, int offset, int address,
+//                                  int length);
+void Java_org_joshvm_util_DirectMemory_copyFromArray() {
+  TypeArray::Raw src = GET_PARAMETER_AS_OOP(1);
+  const jint offset = KNI_GetParameterAsInt(2);
+  const jint length = KNI_GetParameterAsInt(4);
+  jvm_memcpy(direct_address(KNI_GetParameterAsInt(3)),
+             src().byte_base_address() + offset, length);
+}
+
+// static native void copy(int src, int dst, int length);
+void Java_org_joshvm_util_DirectMemory_copy() {
+  jvm_memmove(direct_address(KNI_GetParameterAsInt(2)),
+              direct_address(KNI_GetParameterAsInt(1)),
+              KNI_GetParameterAsInt(3));
+}
+
+} // extern "C"
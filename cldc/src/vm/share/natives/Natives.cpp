@@ -31,80 +31,91 @@
 
 #if ENABLE_DYNAMIC_NATIVE_METHODS || ENABLE_ROM_GENERATOR
 
-ReturnOop Natives::get_native_function_name(Method *method JVM_TRAPS) {
+void Natives::get_native_name_parts(Method *method, Symbol *class_name,
+                                    Symbol *method_name, Symbol *signature) {
   bool dummy;
-  InstanceClass ic = method->holder();
-  ConstantPool cp = ic.constants();
-  Symbol class_name = ic.original_name();
-  Symbol method_name = method->get_original_name(dummy);
-  Symbol signature;
-
-  ObjArray methods = ic.methods();
-  for (int i=0; i<methods.length(); i++) {
-    Method other_method = methods.obj_at(i);
+  InstanceClass::Raw ic = method->holder();
+  *class_name = ic().original_name();
+  *method_name = method->get_original_name(dummy);
+  signature->set_null();
+
+  ObjArray::Raw methods = ic().methods();
+  for (int i=0; i<methods().length(); i++) {
+    Method::Raw other_method = methods().obj_at(i);
     if (other_method.is_null()) {
       // removed <clinit>
       continue;
     }
-    if (!other_method.is_native()) {
+    if (!other_method().is_native()) {
       continue;
     }
     if (method->equals(&other_method)) {
       continue;
     }
-    Symbol other_name = other_method.get_original_name(dummy);
-    if (method_name.matches(&other_name)) {
+    Symbol::Raw other_name = other_method().get_original_name(dummy);
+    if (method_name->matches(&other_name)) {
       // Overloaded native method - need signature
-      signature = method->signature();
+      *signature = method->signature();
       break;
     }
   }
+}
+
+ReturnOop Natives::get_native_function_name(Method *method JVM_TRAPS) {
+  UsingFastOops fast_oops;
+  Symbol::Fast class_name;
+  Symbol::Fast method_name;
+  Symbol::Fast signature;
+  get_native_name_parts(method, &class_name, &method_name, &signature);
   return convert_to_jni_name(&class_name, &method_name, &signature
                                       JVM_NO_CHECK_AT_BOTTOM_0);
 }
 
-ReturnOop Natives::convert_to_jni_name(Symbol *class_name,
-                                       Symbol *method_name,
-                                       Symbol *signature JVM_TRAPS) {
-  TypeArray byte_array;
-  int max_len = class_name->length() + method_name->length();
-  if (!signature->is_null()) {
-    max_len += signature->length();
-  }
-  max_len *= 4; // each character can expand to 4 bytes max
-  max_len += 5 + 1 + 2;  // "Java_", "_", "__"
-
-  byte_array = Universe::new_byte_array(max_len+1 JVM_CHECK_0);
+int Natives::jni_name_length(Symbol *class_name, Symbol *method_name,
+                             Symbol *signature) {
+  // The mangled signature is made from the decoded signature, which can
+  // be much longer than the signature symbol, so just do a dry run.
+  return write_jni_name(NULL, class_name, method_name, signature);
+}
 
+int Natives::write_jni_name(char *buffer, Symbol *class_name,
+                            Symbol *method_name, Symbol *signature) {
   int index = 0;
-  append_jni(&byte_array, "Java_", &index);
-  append_jni(&byte_array, class_name, 0, 0, &index  JVM_CHECK_0);
-  append_jni(&byte_array, "_", &index);
-  append_jni(&byte_array, method_name, 0, 0, &index JVM_CHECK_0);
+  append_jni(buffer, "Java_", &index);
+  append_jni(buffer, class_name, 0, 0, &index);
+  append_jni(buffer, "_", &index);
+  append_jni(buffer, method_name, 0, 0, &index);
 
   if (!signature->is_null()) {
-    append_jni(&byte_array, "__", &index);
+    append_jni(buffer, "__", &index);
     // Only include the stuff inside the parentheses.
-    append_jni(&byte_array, signature, 1, ')', &index JVM_CHECK_0);
+    append_jni(buffer, signature, 1, ')', &index);
   }
-
-  return byte_array;
+  return index;
 }
 
-void Natives::append_jni(TypeArray *byte_array, const char *str, int *index) {
-  char *data = ((char*)byte_array->data()) + *index;
-  char *start = data;
+ReturnOop Natives::convert_to_jni_name(Symbol *class_name,
+                                       Symbol *method_name,
+                                       Symbol *signature JVM_TRAPS) {
+  const int length = jni_name_length(class_name, method_name, signature);
+  TypeArray::Raw byte_array = Universe::new_byte_array(length+1 JVM_CHECK_0);
 
-  while (*str) {
-    *data++ = *str++;
-  }
+  // No allocation below this point.
+  write_jni_name((char*)byte_array().data(), class_name, method_name,
+                 signature);
+  return byte_array.obj();
+}
 
-  *data = 0;
-  *index += (data - start);
+void Natives::append_jni(char *buffer, const char *str, int *index) {
+  const int length = jvm_strlen(str);
+  if (buffer != NULL) {
+    jvm_memcpy(buffer + *index, str, length + 1);
+  }
+  *index += length;
 }
 
-void Natives::append_jni(TypeArray *byte_array, Symbol *symbol,
-                         int skip, char end_char, int *index JVM_TRAPS) {
+void Natives::append_jni(char *buffer, Symbol *symbol,
+                         int skip, char end_char, int *index) {
   if (symbol->is_valid_method_signature(NULL)) {
     TypeSymbol::Raw type_symbol = symbol->obj();
 
@@ -113,104 +124,182 @@ void Natives::append_jni(TypeArray *byte_array, Symbol *symbol,
     type_symbol().print_decoded_on(&faos);
 
     LiteralStream literal_stream(faos.array());
-    append_jni(byte_array, &literal_stream, skip, end_char, index JVM_CHECK);
+    append_jni(buffer, &literal_stream, skip, end_char, index);
   } else {
     SymbolStream symbol_stream(symbol);
-    append_jni(byte_array, &symbol_stream, skip, end_char, index JVM_CHECK);
+    append_jni(buffer, &symbol_stream, skip, end_char, index);
   }
 }
 
-void Natives::append_jni(TypeArray *byte_array, CharacterStream *stream,
-                         int skip, char end_char, int *index JVM_TRAPS) {
-  String::Raw string = Universe::new_string(stream JVM_CHECK);
-  AllocationDisabler raw_pointers_used_below;
-
-  TypeArray::Raw jchar_array = string().value();
-  int offset = string().offset();
-  int count = string().count();
-  char *data = ((char*)byte_array->data()) + *index;
-  char *start = data;
+// The characters are read straight from <stream>, so that no String has
+// to be allocated. If <buffer> is NULL, only the length is computed.
+void Natives::append_jni(char *buffer, CharacterStream *stream,
+                         int skip, char end_char, int *index) {
+  char *data = (buffer != NULL) ? buffer + *index : NULL;
+  int length = 0;
 
   static const char HEX_DIGIT[16] = {'0', '1', '2', '3', '4', '5', '6', '7',
                                      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
 
+  const int count = stream->length();
+  stream->reset();
   for (int i = 0; i < count; i++) {
+    jchar ch = stream->read();
     if (i < skip) {
       continue;
     }
-    jchar ch = jchar_array().char_at(i + offset);
     if (ch == end_char) {
       break;
     }
+    char mangled[6];
+    int n = 0;
     if (('A' <= ch && ch <= 'Z') ||
         ('a' <= ch && ch <= 'z') ||
         ('0' <= ch && ch <= '9')) {
-      *data++ = (char)ch;
+      mangled[n++] = (char)ch;
     } else {
-      *data++ = '_';
+      mangled[n++] = '_';
 
       switch (ch) {
       case '/':
         break; // the _ is all we need
       case '_':
-        *data++ = '1';
+        mangled[n++] = '1';
         break;
       case ';':
-        *data++ = '2';
+        mangled[n++] = '2';
         break;
       case '[':
-        *data++ = '3';
+        mangled[n++] = '3';
         break;
       default:
-        *data++ = '0';
-        *data++ = HEX_DIGIT[(ch >> 12) & 0xf];
-        *data++ = HEX_DIGIT[(ch >> 8)  & 0xf];
-        *data++ = HEX_DIGIT[(ch >> 4)  & 0xf];
-        *data++ = HEX_DIGIT[ ch        & 0xf];
+        mangled[n++] = '0';
+        mangled[n++] = HEX_DIGIT[(ch >> 12) & 0xf];
+        mangled[n++] = HEX_DIGIT[(ch >> 8)  & 0xf];
+        mangled[n++] = HEX_DIGIT[(ch >> 4)  & 0xf];
+        mangled[n++] = HEX_DIGIT[ ch        & 0xf];
       }
     }
+    if (data != NULL) {
+      jvm_memcpy(data + length, mangled, n);
+    }
+    length += n;
   }
 
-  *data = 0;
-  *index += (data - start);
+  if (data != NULL) {
+    data[length] = 0;
+  }
+  *index += length;
 }
 
 ReturnOop Natives::get_jni_class_name(InstanceClass *klass JVM_TRAPS) {
-  Symbol name = klass->original_name();
-  int max_len = name.length() * 4; // each character can expand to 4 bytes max
-  max_len += 5;                    // "Java_";
+  UsingFastOops fast_oops;
+  Symbol::Fast name = klass->original_name();
+  int length = 0;
+  append_jni(NULL, "Java_", &length);
+  append_jni(NULL, &name, 0, 0, &length);
 
-  TypeArray byte_array = Universe::new_byte_array(max_len+1 JVM_CHECK_0);
+  TypeArray::Raw byte_array = Universe::new_byte_array(length+1 JVM_CHECK_0);
 
+  // No allocation below this point.
+  char *buffer = (char*)byte_array().data();
   int index = 0;
-  append_jni(&byte_array, "Java_", &index);
-  append_jni(&byte_array, &name, 0, 0, &index JVM_CHECK_0);
+  append_jni(buffer, "Java_", &index);
+  append_jni(buffer, &name, 0, 0, &index);
 
-  return byte_array;
+  return byte_array.obj();
 }
 #endif // ENABLE_DYNAMIC_NATIVE_METHODS || ENABLE_ROM_GENERATOR
 
 #if ENABLE_DYNAMIC_NATIVE_METHODS
 
+Natives::DynamicSymbol
+Natives::_dynamic_symbols[Natives::DYNAMIC_SYMBOL_CACHE_SIZE];
+
+static juint dynamic_symbol_hash(const char* name) {
+  juint hash = 2166136261u;
+  for (; *name; name++) {
+    hash = (hash ^ (juint)(unsigned char)*name) * 16777619;
+  }
+  return hash;
+}
+
+// Looks up <name> in the loaded libraries. The symbols found are kept in a
+// direct-mapped cache, so binding the same native method again (e.g., when
+// its class is loaded by another task) doesn't search all libraries.
+// Libraries are never unloaded, and later libraries can't hide a symbol
+// found in an earlier one, so the cache never becomes stale.
+address Natives::find_dynamic_symbol(const char* name) {
+  const juint hash = dynamic_symbol_hash(name);
+  DynamicSymbol* entry = &_dynamic_symbols[hash % DYNAMIC_SYMBOL_CACHE_SIZE];
+  if (entry->name != NULL && entry->hash == hash &&
+      jvm_strcmp(entry->name, name) == 0) {
+    return entry->function;
+  }
+
+  for (int i = 0; i < Universe::dynamic_lib_count; i++) {
+    address handle = (address)Universe::dynamic_lib_handles()->int_at(i);
+    address fptr = (address)Os::getSymbol(handle, name);
+    if (fptr != NULL) {
+      const size_t length = jvm_strlen(name) + 1;
+      char* copy = (char*)OsMemory_allocate(length);
+      if (copy != NULL) {
+        jvm_memcpy(copy, name, length);
+        if (entry->name != NULL) {
+          OsMemory_free(entry->name);
+        }
+        entry->name = copy;
+        entry->hash = hash;
+        entry->function = fptr;
+      }
+      return fptr;
+    }
+  }
+  return NULL;
+}
+
+void Natives::dispose_dynamic_symbols() {
+  for (int i = 0; i < DYNAMIC_SYMBOL_CACHE_SIZE; i++) {
+    DynamicSymbol* entry = &_dynamic_symbols[i];
+    if (entry->name != NULL) {
+      OsMemory_free(entry->name);
+      entry->name = NULL;
+    }
+  }
+}
+
 address Natives::load_dynamic_native_code(Method* method JVM_TRAPS) {
   if (Universe::dynamic_lib_count != 0) {
-    int i;
-    address handle = NULL;
-    TypeArray name_array =
-      Natives::get_native_function_name(method JVM_CHECK_0);
-    const char * name = (const char *)name_array.data();
-    for (i = 0; i < Universe::dynamic_lib_count; i++) {
-      handle = (address)Universe::dynamic_lib_handles()->int_at(i);
-      address fptr = (address)Os::getSymbol(handle, name);
-      if (fptr != NULL) {
-        method->set_native_code(fptr);
+    UsingFastOops fast_oops;
+    Symbol::Fast class_name;
+    Symbol::Fast method_name;
+    Symbol::Fast signature;
+    get_native_name_parts(method, &class_name, &method_name, &signature);
+
+    // Most names fit into a stack buffer, so binding doesn't allocate.
+    char static_name[MAX_STATIC_JNI_NAME + 1];
+    TypeArray::Fast name_array;
+    const char* name;
+    if (jni_name_length(&class_name, &method_name, &signature) <=
+        MAX_STATIC_JNI_NAME) {
+      write_jni_name(static_name, &class_name, &method_name, &signature);
+      name = static_name;
+    } else {
+      name_array = convert_to_jni_name(&class_name, &method_name, &signature
+                                       JVM_CHECK_0);
+      name = (const char *)name_array().data();
+    }
+
+    address fptr = find_dynamic_symbol(name);
+    if (fptr != NULL) {
+      // Later calls go straight to the bound function.
+      method->set_native_code(fptr);
 #if ENABLE_COMPILER
-        // The pointer to the old native code is hardcoded
-        // in compiled code. Must recompile.
-        method->unlink_compiled_code();
+      // The pointer to the old native code is hardcoded
+      // in compiled code. Must recompile.
+      method->unlink_compiled_code();
 #endif
-        return fptr;
-      }
+      return fptr;
     }
   }
 
@@ -289,7 +378,21 @@ void Java_illegal_method_execution(JVM_SINGLE_ARG_TRAPS) {
 // native public void write(int b)
 void Java_com_sun_cldchi_io_ConsoleOutputStream_write() {
   jint value = KNI_GetParameterAsInt(1);
-  tty->print("%c", value);
+  ConsoleOutput::write((char)value);
+}
+
+// private native void writeBytes(byte b[], int off, int len)
+// The range has been checked by ConsoleOutputStream.write(byte[], int, int)
+void Java_com_sun_cldchi_io_ConsoleOutputStream_writeBytes() {
+  TypeArray::Raw b = GET_PARAMETER_AS_OOP(1);
+  jint off = KNI_GetParameterAsInt(2);
+  jint len = KNI_GetParameterAsInt(3);
+  ConsoleOutput::write((const char*)b().byte_base_address() + off, len);
+}
+
+// private native void flush0()
+void Java_com_sun_cldchi_io_ConsoleOutputStream_flush0() {
+  ConsoleOutput::flush();
 }
 
   // com.sun.cldchi.jvm natives
@@ -791,13 +894,12 @@ OopDesc* Java_java_lang_Class_getName(JVM_SINGLE_ARG_TRAPS) {
   }
 
   {
-    TypeArray::Raw t = result().value();
     if (instance_pad) {
-      t().char_at_put(dimension, 'L');
-      t().char_at_put(t().length()-1, ';');
+      result().char_at_put(dimension, 'L');
+      result().char_at_put(result().length()-1, ';');
     }
     for (int i=0; i<dimension; i++) {
-      t().char_at_put(i, '[');
+      result().char_at_put(i, '[');
     }
   }
 
@@ -1066,6 +1168,16 @@ jint Java_java_lang_String_hashCode() {
   return this_obj().hash();
 }
 
+// private native int computeHash();
+//
+// Slow path of String.hashCode() when the hash has not been cached yet.
+// String::hash() stores the result in String.hash.
+jint Java_java_lang_String_computeHash() {
+  String::Raw this_obj = GET_PARAMETER_AS_OOP(0);
+
+  return this_obj().hash();
+}
+
 jint Java_java_lang_String_lastIndexOf__I() {
   String::Raw this_obj = GET_PARAMETER_AS_OOP(0);
   jint ch = KNI_GetParameterAsInt(1);
@@ -1089,6 +1201,116 @@ jint Java_java_lang_String_lastIndexOf__II() {
 
   return this_obj().last_index_of((jchar)ch, fromIndex);
 }
+
+jint Java_java_lang_String_indexOf__I() {
+  String::Raw this_obj = GET_PARAMETER_AS_OOP(0);
+  jint ch = KNI_GetParameterAsInt(1);
+
+  if ((ch & 0xFFFF0000) != 0) {
+    return -1;
+  }
+
+  return this_obj().index_of((jchar)ch, 0);
+}
+
+jint Java_java_lang_String_indexOf__II() {
+  String::Raw this_obj = GET_PARAMETER_AS_OOP(0);
+  jint ch = KNI_GetParameterAsInt(1);
+  jint fromIndex = KNI_GetParameterAsInt(2);
+
+  if ((ch & 0xFFFF0000) != 0) {
+    return -1;
+  }
+
+  return this_obj().index_of((jchar)ch, fromIndex);
+}
+
+// private native int search(String str, int fromIndex);
+jint Java_java_lang_String_search(JVM_SINGLE_ARG_TRAPS) {
+  String::Raw this_obj = GET_PARAMETER_AS_OOP(0);
+  String::Raw str = GET_PARAMETER_AS_OOP(1);
+  jint fromIndex = KNI_GetParameterAsInt(2);
+
+  if (str.is_null()) {
+    Throw::null_pointer_exception(empty_message JVM_THROW_0);
+  }
+
+  return this_obj().index_of(&str, fromIndex);
+}
+
+// private native int compare(String anotherString);
+jint Java_java_lang_String_compare(JVM_SINGLE_ARG_TRAPS) {
+  String::Raw this_obj = GET_PARAMETER_AS_OOP(0);
+  String::Raw other = GET_PARAMETER_AS_OOP(1);
+
+  if (other.is_null()) {
+    Throw::null_pointer_exception(empty_message JVM_THROW_0);
+  }
+
+  return this_obj().compare_to(&other);
+}
+
+// private native boolean regionEquals(int toffset, String other,
+//                                     int ooffset, int len);
+jint Java_java_lang_String_regionEquals(JVM_SINGLE_ARG_TRAPS) {
+  String::Raw this_obj = GET_PARAMETER_AS_OOP(0);
+  jint toffset = KNI_GetParameterAsInt(1);
+  String::Raw other = GET_PARAMETER_AS_OOP(2);
+  jint ooffset = KNI_GetParameterAsInt(3);
+  jint len = KNI_GetParameterAsInt(4);
+
+  if (other.is_null()) {
+    Throw::null_pointer_exception(empty_message JVM_THROW_0);
+  }
+
+  return this_obj().region_matches(toffset, &other, ooffset, len);
+}
+
+// private static native byte[] compress(char value[], int offset,
+//                                       int count);
+//
+// Returns the characters as a Latin-1 byte[], or null if any of them
+// doesn't fit. The caller has checked the bounds.
+ReturnOop Java_java_lang_String_compress(JVM_SINGLE_ARG_TRAPS) {
+  UsingFastOops fast_oops;
+  TypeArray::Fast chars = GET_PARAMETER_AS_OOP(1);
+  const jint offset = KNI_GetParameterAsInt(2);
+  const jint count  = KNI_GetParameterAsInt(3);
+
+  {
+    AllocationDisabler raw_pointers_used_in_this_block;
+    if (!String::fits_latin1((jchar*)chars().base_address() + offset,
+                             count)) {
+      return NULL;
+    }
+  }
+
+  TypeArray::Raw bytes = Universe::new_byte_array(count JVM_CHECK_0);
+  const jchar* src = (jchar*)chars().base_address() + offset;
+  jubyte* dst = (jubyte*)bytes().base_address();
+  for (jubyte* const end = dst + count; dst < end; ) {
+    *dst++ = (jubyte)(*src++);
+  }
+  return bytes.obj();
+}
+
+// private static native void inflate(byte src[], int srcOffset,
+//                                    char dst[], int dstOffset, int count);
+//
+// The caller has checked the bounds of both arrays.
+void Java_java_lang_String_inflate() {
+  TypeArray::Raw src = GET_PARAMETER_AS_OOP(1);
+  const jint src_offset = KNI_GetParameterAsInt(2);
+  TypeArray::Raw dst = GET_PARAMETER_AS_OOP(3);
+  const jint dst_offset = KNI_GetParameterAsInt(4);
+  const jint count      = KNI_GetParameterAsInt(5);
+
+  const jubyte* from = (jubyte*)src().base_address() + src_offset;
+  jchar* to = (jchar*)dst().base_address() + dst_offset;
+  for (jchar* const end = to + count; to < end; ) {
+    *to++ = (jchar)(*from++);
+  }
+}
 // java.lang.Thread natives
 
 ReturnOop Java_java_lang_Thread_currentThread(){
@@ -1408,6 +1630,435 @@ ReturnOop Java_com_sun_cldc_io_ResourceInputStream_clone(JVM_SINGLE_ARG_TRAPS) {
   return ObjectHeap::clone(GET_PARAMETER_AS_OOP(1) JVM_NO_CHECK_AT_BOTTOM);
 }
 
+// com.sun.cldc.i18n.Helper natives
+//
+// Bulk UTF-8 and modified UTF-8 conversion used by Helper, the UTF_8
+// readers and writers, and DataInputStream/DataOutputStream. Runs of
+// ASCII are converted a word at a time.
+
+static const jchar utf8_replacement_char = 0xFFFD; // 'RC' in UTF_8_Reader
+static const jubyte utf8_replacement_byte = 0x3F;  // '?' in UTF_8_Writer
+
+inline static bool utf8_is_word_aligned(const void* p) {
+  return (((juint)p) & (sizeof(juint) - 1)) == 0;
+}
+
+inline static bool utf8_is_high_surrogate(juint c) {
+  return 0xD800 <= c && c <= 0xDBFF;
+}
+
+inline static bool utf8_is_low_surrogate(juint c) {
+  return 0xDC00 <= c && c <= 0xDFFF;
+}
+
+// Checks the array arguments of the natives below. Throws
+// NullPointerException or ArrayIndexOutOfBoundsException and returns false
+// if they are not valid.
+static bool check_array_range(Array* array, jint offset, jint length
+                              JVM_TRAPS) {
+  if (array->is_null()) {
+    Throw::null_pointer_exception(empty_message JVM_THROW_0);
+  }
+  if (offset < 0 || length < 0 ||
+      (juint)offset + (juint)length > (juint)array->length()) {
+    Throw::array_index_out_of_bounds_exception(empty_message JVM_THROW_0);
+  }
+  return true;
+}
+
+// Decodes the UTF-8 bytes src[0, length) into <dst>, which must have room
+// for <length> chars, and returns the number of chars stored. Malformed
+// input is replaced exactly as UTF_8_Reader does it: a bad continuation
+// byte starts the next sequence, and overlong forms, surrogate code
+// points, values above U+10FFFF and a sequence cut short by the end of
+// the input each become one replacement character.
+static jint utf8_decode(const jubyte* src, jint length, jchar* dst) {
+  static const juint minimal_valid_value[] = {0x00, 0x80, 0x800, 0x10000};
+  const jubyte* const end = src + length;
+  jchar* const start = dst;
+
+  while (src < end) {
+    juint c = *src++;
+    if (c < 0x80) {
+      *dst++ = (jchar)c;
+      if (utf8_is_word_aligned(src)) {
+        while (end - src >= (int)sizeof(juint) &&
+               (*(juint*)src & 0x80808080) == 0) {
+          dst[0] = src[0];
+          dst[1] = src[1];
+          dst[2] = src[2];
+          dst[3] = src[3];
+          src += sizeof(juint);
+          dst += sizeof(juint);
+        }
+      }
+      continue;
+    }
+
+    int extra_bytes;
+    switch (c >> 4) {
+    case 12: case 13:
+      extra_bytes = 1;
+      c &= 0x1F;
+      break;
+    case 14:
+      extra_bytes = 2;
+      c &= 0x0F;
+      break;
+    case 15:
+      if ((c & 0x08) == 0) {
+        extra_bytes = 3;
+        c &= 0x07;
+        break;
+      }
+      // Fall through
+    default:
+      *dst++ = utf8_replacement_char;
+      continue;
+    }
+
+    bool malformed = false;
+    for (int i = 0; i < extra_bytes; i++) {
+      if (src >= end || (*src & 0xC0) != 0x80) {
+        malformed = true;
+        break;
+      }
+      c = (c << 6) | (*src++ & 0x3F);
+    }
+
+    if (malformed || c < minimal_valid_value[extra_bytes] ||
+        (0xD800 <= c && c <= 0xDFFF) || c > 0x10FFFF) {
+      *dst++ = utf8_replacement_char;
+    } else if (c <= 0xFFFF) {
+      *dst++ = (jchar)c;
+    } else {
+      c -= 0x10000;
+      *dst++ = (jchar)(0xD800 | (c >> 10));
+      *dst++ = (jchar)(0xDC00 | (c & 0x3FF));
+    }
+  }
+  return dst - start;
+}
+
+// Returns the number of bytes utf8_encode() produces for src[0, length).
+static jint utf8_encoded_length(const jchar* src, jint length) {
+  const jchar* const end = src + length;
+  jint result = 0;
+  while (src < end) {
+    const juint c = *src++;
+    if (c < 0x80) {
+      result += 1;
+    } else if (c < 0x800) {
+      result += 2;
+    } else if (utf8_is_high_surrogate(c)) {
+      if (src < end && utf8_is_low_surrogate(*src)) {
+        src++;
+        result += 4;
+      } else {
+        result += 1;
+      }
+    } else if (utf8_is_low_surrogate(c)) {
+      result += 1;
+    } else {
+      result += 3;
+    }
+  }
+  return result;
+}
+
+// Encodes src[0, length) as UTF-8 into <dst> and returns the number of
+// bytes stored. A surrogate pair becomes one 4-byte sequence, and an
+// unpaired surrogate is replaced by '?', like UTF_8_Writer does.
+static jint utf8_encode(const jchar* src, jint length, jubyte* dst) {
+  const jchar* const end = src + length;
+  jubyte* const start = dst;
+  while (src < end) {
+    juint c = *src++;
+    if (c < 0x80) {
+      *dst++ = (jubyte)c;
+      if (utf8_is_word_aligned(src)) {
+        while (end - src >= 2 && (*(juint*)src & 0xFF80FF80) == 0) {
+          dst[0] = (jubyte)src[0];
+          dst[1] = (jubyte)src[1];
+          src += 2;
+          dst += 2;
+        }
+      }
+    } else if (c < 0x800) {
+      *dst++ = (jubyte)(0xC0 | (c >> 6));
+      *dst++ = (jubyte)(0x80 | (c & 0x3F));
+    } else if (utf8_is_high_surrogate(c)) {
+      if (src < end && utf8_is_low_surrogate(*src)) {
+        c = 0x10000 + ((c & 0x3FF) << 10) + (*src++ & 0x3FF);
+        *dst++ = (jubyte)(0xF0 | (c >> 18));
+        *dst++ = (jubyte)(0x80 | ((c >> 12) & 0x3F));
+        *dst++ = (jubyte)(0x80 | ((c >> 6) & 0x3F));
+        *dst++ = (jubyte)(0x80 | (c & 0x3F));
+      } else {
+        *dst++ = utf8_replacement_byte;
+      }
+    } else if (utf8_is_low_surrogate(c)) {
+      *dst++ = utf8_replacement_byte;
+    } else {
+      *dst++ = (jubyte)(0xE0 | (c >> 12));
+      *dst++ = (jubyte)(0x80 | ((c >> 6) & 0x3F));
+      *dst++ = (jubyte)(0x80 | (c & 0x3F));
+    }
+  }
+  return dst - start;
+}
+
+// Decodes the modified UTF-8 of DataInput.readUTF() in src[0, length)
+// into <dst>. Returns the number of chars stored, or -1 if the input is
+// malformed.
+static jint modified_utf8_decode(const jubyte* src, jint length,
+                                 jchar* dst) {
+  const jubyte* const end = src + length;
+  jchar* const start = dst;
+  while (src < end) {
+    const juint c = *src++;
+    if (c < 0x80) {
+      *dst++ = (jchar)c;
+      if (utf8_is_word_aligned(src)) {
+        while (end - src >= (int)sizeof(juint) &&
+               (*(juint*)src & 0x80808080) == 0) {
+          dst[0] = src[0];
+          dst[1] = src[1];
+          dst[2] = src[2];
+          dst[3] = src[3];
+          src += sizeof(juint);
+          dst += sizeof(juint);
+        }
+      }
+    } else if ((c >> 5) == 0x06) {
+      if (end - src < 1 || (src[0] & 0xC0) != 0x80) {
+        return -1;
+      }
+      *dst++ = (jchar)(((c & 0x1F) << 6) | (src[0] & 0x3F));
+      src += 1;
+    } else if ((c >> 4) == 0x0E) {
+      if (end - src < 2 ||
+          (src[0] & 0xC0) != 0x80 || (src[1] & 0xC0) != 0x80) {
+        return -1;
+      }
+      *dst++ = (jchar)(((c & 0x0F) << 12) | ((src[0] & 0x3F) << 6) |
+                       (src[1] & 0x3F));
+      src += 2;
+    } else {
+      return -1;
+    }
+  }
+  return dst - start;
+}
+
+// Returns the number of bytes modified_utf8_encode() produces for
+// src[0, length).
+static jint modified_utf8_encoded_length(const jchar* src, jint length) {
+  const jchar* const end = src + length;
+  jint result = 0;
+  while (src < end) {
+    const juint c = *src++;
+    if (c >= 0x0001 && c <= 0x007F) {
+      result += 1;
+    } else if (c > 0x07FF) {
+      result += 3;
+    } else {
+      result += 2;
+    }
+  }
+  return result;
+}
+
+// Encodes src[0, length) as in DataOutput.writeUTF(): '\u0000' takes two
+// bytes and each surrogate is encoded on its own.
+static jint modified_utf8_encode(const jchar* src, jint length,
+                                 jubyte* dst) {
+  const jchar* const end = src + length;
+  jubyte* const start = dst;
+  while (src < end) {
+    const juint c = *src++;
+    if (c >= 0x0001 && c <= 0x007F) {
+      *dst++ = (jubyte)c;
+    } else if (c > 0x07FF) {
+      *dst++ = (jubyte)(0xE0 | (c >> 12));
+      *dst++ = (jubyte)(0x80 | ((c >> 6) & 0x3F));
+      *dst++ = (jubyte)(0x80 | (c & 0x3F));
+    } else {
+      *dst++ = (jubyte)(0xC0 | (c >> 6));
+      *dst++ = (jubyte)(0x80 | (c & 0x3F));
+    }
+  }
+  return dst - start;
+}
+
+// Checks the arguments of a decoding native, whose <dst> must have room
+// for one char per source byte.
+static bool utf8_check_decode_args(TypeArray* src, jint src_offset,
+                                   jint src_length, TypeArray* dst,
+                                   jint dst_offset JVM_TRAPS) {
+  check_array_range(src, src_offset, src_length JVM_CHECK_0);
+  check_array_range(dst, dst_offset, src_length JVM_CHECK_0);
+  return true;
+}
+
+// public static native int utf8Decode(byte[] src, int srcOff, int srcLen,
+//                                     char[] dst, int dstOff);
+jint Java_com_sun_cldc_i18n_Helper_utf8Decode(JVM_SINGLE_ARG_TRAPS) {
+  TypeArray::Raw src = GET_PARAMETER_AS_OOP(1);
+  const jint src_offset = KNI_GetParameterAsInt(2);
+  const jint src_length = KNI_GetParameterAsInt(3);
+  TypeArray::Raw dst = GET_PARAMETER_AS_OOP(4);
+  const jint dst_offset = KNI_GetParameterAsInt(5);
+
+  utf8_check_decode_args(&src, src_offset, src_length, &dst, dst_offset
+                         JVM_CHECK_0);
+  return utf8_decode((jubyte*)src().base_address() + src_offset, src_length,
+                     (jchar*)dst().base_address() + dst_offset);
+}
+
+// public static native int utf8EncodedLength(char[] src, int off, int len);
+jint Java_com_sun_cldc_i18n_Helper_utf8EncodedLength(JVM_SINGLE_ARG_TRAPS) {
+  TypeArray::Raw src = GET_PARAMETER_AS_OOP(1);
+  const jint offset = KNI_GetParameterAsInt(2);
+  const jint length = KNI_GetParameterAsInt(3);
+
+  check_array_range(&src, offset, length JVM_CHECK_0);
+  return utf8_encoded_length((jchar*)src().base_address() + offset, length);
+}
+
+// public static native int utf8Encode(char[] src, int off, int len,
+//                                     byte[] dst, int dstOff);
+//
+// <dst> must have room for utf8EncodedLength(src, off, len) bytes.
+jint Java_com_sun_cldc_i18n_Helper_utf8Encode(JVM_SINGLE_ARG_TRAPS) {
+  TypeArray::Raw src = GET_PARAMETER_AS_OOP(1);
+  const jint offset = KNI_GetParameterAsInt(2);
+  const jint length = KNI_GetParameterAsInt(3);
+  TypeArray::Raw dst = GET_PARAMETER_AS_OOP(4);
+  const jint dst_offset = KNI_GetParameterAsInt(5);
+
+  check_array_range(&src, offset, length JVM_CHECK_0);
+  const jchar* chars = (jchar*)src().base_address() + offset;
+  check_array_range(&dst, dst_offset, utf8_encoded_length(chars, length)
+                    JVM_CHECK_0);
+  return utf8_encode(chars, length, (jubyte*)dst().base_address() + dst_offset);
+}
+
+// public static native int modifiedUtf8Decode(byte[] src, int srcOff,
+//                                             int srcLen, char[] dst,
+//                                             int dstOff);
+jint Java_com_sun_cldc_i18n_Helper_modifiedUtf8Decode(JVM_SINGLE_ARG_TRAPS) {
+  TypeArray::Raw src = GET_PARAMETER_AS_OOP(1);
+  const jint src_offset = KNI_GetParameterAsInt(2);
+  const jint src_length = KNI_GetParameterAsInt(3);
+  TypeArray::Raw dst = GET_PARAMETER_AS_OOP(4);
+  const jint dst_offset = KNI_GetParameterAsInt(5);
+
+  utf8_check_decode_args(&src, src_offset, src_length, &dst, dst_offset
+                         JVM_CHECK_0);
+  return modified_utf8_decode((jubyte*)src().base_address() + src_offset,
+                              src_length,
+                              (jchar*)dst().base_address() + dst_offset);
+}
+
+// public static native int modifiedUtf8EncodedLength(char[] src, int off,
+//                                                    int len);
+jint Java_com_sun_cldc_i18n_Helper_modifiedUtf8EncodedLength(
+                                                      JVM_SINGLE_ARG_TRAPS) {
+  TypeArray::Raw src = GET_PARAMETER_AS_OOP(1);
+  const jint offset = KNI_GetParameterAsInt(2);
+  const jint length = KNI_GetParameterAsInt(3);
+
+  check_array_range(&src, offset, length JVM_CHECK_0);
+  return modified_utf8_encoded_length((jchar*)src().base_address() + offset,
+                                      length);
+}
+
+// public static native int modifiedUtf8Encode(char[] src, int off, int len,
+//                                             byte[] dst, int dstOff);
+//
+// <dst> must have room for modifiedUtf8EncodedLength(src, off, len) bytes.
+jint Java_com_sun_cldc_i18n_Helper_modifiedUtf8Encode(JVM_SINGLE_ARG_TRAPS) {
+  TypeArray::Raw src = GET_PARAMETER_AS_OOP(1);
+  const jint offset = KNI_GetParameterAsInt(2);
+  const jint length = KNI_GetParameterAsInt(3);
+  TypeArray::Raw dst = GET_PARAMETER_AS_OOP(4);
+  const jint dst_offset = KNI_GetParameterAsInt(5);
+
+  check_array_range(&src, offset, length JVM_CHECK_0);
+  const jchar* chars = (jchar*)src().base_address() + offset;
+  check_array_range(&dst, dst_offset,
+                    modified_utf8_encoded_length(chars, length) JVM_CHECK_0);
+  return modified_utf8_encode(chars, length,
+                              (jubyte*)dst().base_address() + dst_offset);
+}
+
+// Copies <count> elements of <size> bytes from <src> to <dst>, reversing
+// the bytes of each element if <swap> is set.
+static void copy_elements(jubyte* dst, const jubyte* src, jint count,
+                          jint size, bool swap) {
+  if (!swap) {
+    jvm_memcpy(dst, src, count * size);
+    return;
+  }
+  for (; count > 0; count--, src += size, dst += size) {
+    for (int i = 0; i < size; i++) {
+      dst[i] = src[size - 1 - i];
+    }
+  }
+}
+
+static bool host_is_big_endian() {
+  const jint probe = 1;
+  return *(const jubyte*)&probe == 0;
+}
+
+// Checks the arguments of DataArrays.pack/unpack:
+// <count> elements of <size> bytes at <offset> in <array>, and their
+// bytes at the start of <bytes>.
+static bool check_packed_range(Array* array, jint offset, TypeArray* bytes,
+                               jint size, jint count JVM_TRAPS) {
+  check_array_range(array, offset, count JVM_CHECK_0);
+  if (count > bytes->length() / size) {
+    Throw::array_index_out_of_bounds_exception(empty_message JVM_THROW_0);
+  }
+  return true;
+}
+
+// private static native void pack(Object src, int srcOff, int size,
+//                                 byte[] dst, int count, boolean bigEndian);
+void Java_org_joshvm_util_DataArrays_pack(JVM_SINGLE_ARG_TRAPS) {
+  TypeArray::Raw src = GET_PARAMETER_AS_OOP(1);
+  const jint src_offset = KNI_GetParameterAsInt(2);
+  const jint size = KNI_GetParameterAsInt(3);
+  TypeArray::Raw dst = GET_PARAMETER_AS_OOP(4);
+  const jint count = KNI_GetParameterAsInt(5);
+  const bool big_endian = KNI_GetParameterAsBoolean(6) != KNI_FALSE;
+
+  check_array_range(&dst, 0, 0 JVM_CHECK);
+  check_packed_range(&src, src_offset, &dst, size, count JVM_CHECK);
+  copy_elements((jubyte*)dst().base_address(),
+                (jubyte*)src().base_address() + src_offset * size,
+                count, size, big_endian != host_is_big_endian());
+}
+
+// private static native void unpack(byte[] src, Object dst, int dstOff,
+//                                   int size, int count, boolean bigEndian);
+void Java_org_joshvm_util_DataArrays_unpack(JVM_SINGLE_ARG_TRAPS) {
+  TypeArray::Raw src = GET_PARAMETER_AS_OOP(1);
+  TypeArray::Raw dst = GET_PARAMETER_AS_OOP(2);
+  const jint dst_offset = KNI_GetParameterAsInt(3);
+  const jint size = KNI_GetParameterAsInt(4);
+  const jint count = KNI_GetParameterAsInt(5);
+  const bool big_endian = KNI_GetParameterAsBoolean(6) != KNI_FALSE;
+
+  check_array_range(&src, 0, 0 JVM_CHECK);
+  check_packed_range(&dst, dst_offset, &src, size, count JVM_CHECK);
+  copy_elements((jubyte*)dst().base_address() + dst_offset * size,
+                (jubyte*)src().base_address(),
+                count, size, big_endian != host_is_big_endian());
+}
+
 #if ENABLE_CLDC_11
 
 // native void initializeWeakReference(Object referent);
@@ -1578,6 +2229,13 @@ void Java_com_joshvm_system_PlatformControl_reset0() {
 
 #if (!ROMIZING) || (!defined(PRODUCT))
 
+// Returns true if <symbol> holds the same characters as <str>.
+static bool symbol_equals(Symbol* symbol, const char* str) {
+  const int length = symbol->length();
+  return jvm_strncmp(symbol->base_address(), str, length) == 0 &&
+         str[length] == 0;
+}
+
 void Natives::register_function(InstanceClass* c,
                                 const JvmNativeFunction* functions,
                                 bool is_native JVM_TRAPS) {
@@ -1588,11 +2246,19 @@ void Natives::register_function(InstanceClass* c,
   Method::Fast m;
 
   for (const JvmNativeFunction* func = functions; func->name != NULL; func++) {
-    name      = SymbolTable::symbol_for(func->name JVM_CHECK);
-    signature = TypeSymbol::parse(func->signature JVM_CHECK);
     address f = (address)(func->function);
+    signature.set_null();
     for (int i=0; i<methods().length(); i++) {
       m = methods().obj_at(i);
+      name = m().name();
+      // Compare the names in place, and parse the signature only for
+      // the methods that match, so that binding doesn't create symbols.
+      if (!symbol_equals(&name, func->name)) {
+        continue;
+      }
+      if (signature.is_null()) {
+        signature = TypeSymbol::parse(func->signature JVM_CHECK);
+      }
       if (m().match(&name, &signature)) {
         if (is_native) {
           GUARANTEE(m().is_native(), "must be native");
@@ -1605,26 +2271,46 @@ void Natives::register_function(InstanceClass* c,
   }
 }
 
+const JvmNativesTable* Natives::find_natives_table(Symbol* class_name) {
+  const JvmNativesHash* hash = &jvm_natives_hash;
+  const char* name = class_name->base_address();
+  const int length = class_name->length();
+
+  // Must match CLDC_HI_NativesWriter.nativesHash().
+  juint h = 2166136261u;
+  for (int i = 0; i < length; i++) {
+    h = (h ^ (juint)(unsigned char)name[i]) * 16777619;
+  }
+  const juint seed = hash->seeds[h & (hash->bucket_count - 1)];
+
+  h = 2166136261u ^ seed;
+  for (int i = 0; i < length; i++) {
+    h = (h ^ (juint)(unsigned char)name[i]) * 16777619;
+  }
+  const int index = hash->slots[h & (hash->slot_count - 1)];
+
+  if (index < 0) {
+    return NULL;
+  }
+  const JvmNativesTable* table = &jvm_natives_table[index];
+  return symbol_equals(class_name, table->name) ? table : NULL;
+}
+
 void Natives::register_natives_for(InstanceClass* c JVM_TRAPS) {
   UsingFastOops fast_oops;
   Symbol::Fast class_name = c->name();
-  Symbol::Fast name;
 
-#if (!ROMIZING) || (!defined(PRODUCT))
-  for (const JvmNativesTable* table= jvm_natives_table; table->name!= NULL;
-       table++) {
-    name = SymbolTable::symbol_for(table->name JVM_CHECK);
-    if (class_name.equals(&name)) {
-      if (table->natives != NULL) {
-        register_function(c, table->natives, true JVM_CHECK);
-      }
-      if (table->entries != NULL) {
-        register_function(c, table->entries, false JVM_CHECK);
-      }
-      return;
+  // The generated perfect hash finds the table of the class without
+  // comparing its name against every class that has natives.
+  const JvmNativesTable* table = find_natives_table(&class_name);
+  if (table != NULL) {
+    if (table->natives != NULL) {
+      register_function(c, table->natives, true JVM_CHECK);
+    }
+    if (table->entries != NULL) {
+      register_function(c, table->entries, false JVM_CHECK);
     }
   }
-#endif
 
   // Ignore classes that are not in the native table
   // This is needed to pass several TCK tests (very very strange)
@@ -29,6 +29,42 @@ private:
   static void register_function(InstanceClass* c,
                                 const JvmNativeFunction* functions,
                                 bool is_native JVM_TRAPS);
+#if (!ROMIZING) || (!defined(PRODUCT))
+  static const JvmNativesTable* find_natives_table(Symbol* class_name);
+#endif
+
+#if ENABLE_DYNAMIC_NATIVE_METHODS || ENABLE_ROM_GENERATOR
+  // Finds the symbols that make up the JNI name of <method>. <signature>
+  // is left null unless the native method is overloaded.
+  static void get_native_name_parts(Method *method, Symbol *class_name,
+                                    Symbol *method_name, Symbol *signature);
+  // Returns the length of the JNI name made of these symbols, without the
+  // terminating 0.
+  static int jni_name_length(Symbol *class_name, Symbol *method_name,
+                             Symbol *signature);
+  // Writes the JNI name into <buffer>, which must hold at least
+  // jni_name_length() + 1 bytes, and returns its length. If <buffer> is
+  // NULL, only the length is computed.
+  static int write_jni_name(char *buffer, Symbol *class_name,
+                            Symbol *method_name, Symbol *signature);
+#endif
+
+#if ENABLE_DYNAMIC_NATIVE_METHODS
+  struct DynamicSymbol {
+    char*   name;       // NULL for an empty slot
+    juint   hash;
+    address function;
+  };
+  enum {
+    // JNI names up to this length are built without allocating
+    MAX_STATIC_JNI_NAME = 256,
+    DYNAMIC_SYMBOL_CACHE_SIZE = 128
+  };
+  static address find_dynamic_symbol(const char* name);
+
+  static DynamicSymbol _dynamic_symbols[DYNAMIC_SYMBOL_CACHE_SIZE];
+#endif
+
 public:
 #if (!ROMIZING) || (!defined(PRODUCT))
   // We allow linking of native methods only in non-product or non-romizing
@@ -48,16 +84,19 @@ public:
                                        Symbol *method_name,
                                        Symbol *signature
                                        JVM_TRAPS);
-  static void append_jni(TypeArray *byte_array, const char *str, int *index);
-  static void append_jni(TypeArray *byte_array, Symbol *symbol,
-                                int skip, char end_char, int *index JVM_TRAPS);
-  static void append_jni(TypeArray *byte_array, CharacterStream *stream,
-                                int skip, char end_char, int *index JVM_TRAPS);
+  static void append_jni(char *buffer, const char *str, int *index);
+  static void append_jni(char *buffer, Symbol *symbol,
+                         int skip, char end_char, int *index);
+  static void append_jni(char *buffer, CharacterStream *stream,
+                         int skip, char end_char, int *index);
   static ReturnOop get_jni_class_name(InstanceClass *klass JVM_TRAPS);
 #endif
 
 #if ENABLE_DYNAMIC_NATIVE_METHODS
   static address load_dynamic_native_code(Method* method JVM_TRAPS);
+
+  // Frees the cache of the symbols found in dynamically loaded libraries.
+  static void dispose_dynamic_symbols();
 #endif
 };
 
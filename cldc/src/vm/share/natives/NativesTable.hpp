@@ -48,6 +48,16 @@ struct JvmNativesTable {
   const JvmNativeFunction*  entries;
 };
 
+// A perfect hash of the class names in jvm_natives_table[]. The name is
+// hashed with seed 0 to find its bucket, and then with the seed of the
+// bucket to find its slot, which holds the index of the class in
+// jvm_natives_table[], or -1. See Natives::find_natives_table().
+struct JvmNativesHash {
+  int                    bucket_count;   // a power of 2
+  int                    slot_count;     // a power of 2
+  const unsigned short*  seeds;
+  const short*           slots;
+};
 
 struct JvmExecutionEntry {
   const unsigned char* addr;
@@ -58,6 +68,7 @@ struct JvmExecutionEntry {
 // with the parameters {-writer CLDC_HI_Natives -o NativesTable.cpp}
 
 extern const JvmNativesTable   jvm_natives_table[];
+extern const JvmNativesHash    jvm_natives_hash;
 
 // This table is also in the generated NativesTable.cpp. It lists all
 // the special 'entry' points that implement fast handling of certain
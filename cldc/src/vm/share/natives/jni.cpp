@@ -1331,26 +1331,20 @@ _JNI_GetStringUTFLength(JNIEnv *env, jstring str) {
     return -1;
   }
 
-  TypeArray::Raw value = string().value();
-  const jint offset = string().offset();
-  const jint length = string().length();
-
-  CharStream stream(&value, offset, length);
+  StringStream stream(&string);
   return stream.utf8_length();
 }
 
 static void
 unchecked_get_string_utf_region(String * string, jsize start, jsize len,
                                 char * buf) {
-  TypeArray::Raw value = string->value();
-  const jint offset = string->offset();
   const jint utf8len = len * 3;
 
   LiteralStream stream(buf, 0, utf8len);
 
   int i, index;
   for (index = 0, i = start; i < start + len; i++) {
-    jchar ch = value().char_at(i + offset);
+    jchar ch = string->char_at(i);
     index = stream.utf8_write(index, ch);
   }
   GUARANTEE(index <= utf8len, "UTF8 encoder failed");
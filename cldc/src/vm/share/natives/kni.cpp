@@ -294,24 +294,14 @@ KNIEXPORT void KNI_GetStringRegion(jstring stringHandle, jsize offset, jsize n,
                                    jchar* jcharbuf) {
   String::Raw string = kni_read_handle(stringHandle);
   GUARANTEE(string.not_null(), "null argument to KNI_GetStringRegion");
-  jsize offset0 = string().offset();
-  TypeArray::Raw ta = string().value();
-  for (int i = 0; i < n; i++) {
-    *jcharbuf++ = ta().char_at(offset0 + i + offset);
-  }
+  string().get_chars(jcharbuf, offset, n);
 }
 
 KNIEXPORT void KNI_NewString(const jchar* src, jsize n, jstring stringHandle) {
   SETUP_ERROR_CHECKER_ARG;
-  UsingFastOops fast_oops;
   kni_clear_handle(stringHandle); // just in case of OutOfMemory
 
-  // Allocate Unicode string
-  TypeArray::Fast ta = Universe::new_char_array(n _KNI_CHECK);
-  for (int i = 0; i < n; ++i) {
-    ta().char_at_put(i, src[i]);
-  }
-  OopDesc *str = Universe::new_string(&ta, 0, n _KNI_CHECK);
+  OopDesc *str = Universe::new_string(src, n _KNI_CHECK);
   kni_set_handle(stringHandle, str);
 }
 
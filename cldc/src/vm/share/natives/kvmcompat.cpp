@@ -327,8 +327,6 @@ char* getStringContentsSafely(STRING_INSTANCE string, char *buf, int bufLen) {
   GUARANTEE(_in_kvm_native_method, "sanity");
 
   String::Raw str((OopDesc*)string);
-  TypeArray::Raw t = str().value();
-  int offset = str().offset();
   int length = str().length();
   if (length > bufLen-1) {
     length = bufLen-1;
@@ -336,7 +334,7 @@ char* getStringContentsSafely(STRING_INSTANCE string, char *buf, int bufLen) {
 
   int i = 0;
   for (; i<length; i++) {
-    buf[i] = (char)(t().char_at(i + offset));
+    buf[i] = (char)(str().char_at(i));
   }
   buf[i] = 0;
 
@@ -738,8 +738,8 @@ inline bool ClassFileParser::are_valid_method_access_flags(
 // Parse stackmaps that are used by the verifier later
 juint ClassFileParser::parse_stackmaps(ConstantPool *cp, jushort num_stackmaps,
                                        jushort max_stack, jushort frame_size,
-                                       juint code_length, ObjArray* stackmaps 
-                                       JVM_TRAPS) {
+                                       juint code_length, ObjArray* stackmaps,
+                                       const bool is_deferred JVM_TRAPS) {
   UsingFastOops fast_oops;
   TypeArray::Fast stackmap_scalars;
   ObjArray::Fast stackmap_classes;
@@ -802,11 +802,17 @@ juint ClassFileParser::parse_stackmaps(ConstantPool *cp, jushort num_stackmaps,
           jushort class_index = get_u2(JVM_SINGLE_ARG_CHECK_0);
           cpf_check_0(class_index != 0 && class_index < cp->length(),
                       bad_constantpool_index);
+          // When the stackmaps are expanded lazily (see expand_stackmaps())
+          // the entry may have been resolved in the meantime: verifying an
+          // earlier method of the class resolves its catch types with
+          // ConstantPool::klass_at(). While the class is being loaded no
+          // entry can be resolved yet.
           jubyte tag = cp->tag_value_at(class_index);
-          cpf_check_0(ConstantTag::is_unresolved_klass(tag),
+          cpf_check_0(ConstantTag::is_unresolved_klass(tag) ||
+                      (is_deferred && ConstantTag::is_resolved_klass(tag)),
                       bad_constantpool_index);
           Symbol::Raw class_name = 
-              cp->unresolved_klass_at(class_index JVM_CHECK_0);
+              cp->name_of_klass_at(class_index JVM_CHECK_0);
           // save the stack tag type and the class name
           stackmap_scalars().int_at_put(index, ITEM_Object);
           stackmap_classes().obj_at_put(index++, &class_name);
@@ -830,6 +836,38 @@ juint ClassFileParser::parse_stackmaps(ConstantPool *cp, jushort num_stackmaps,
   return (endpos - startpos) + 2;
 }
 
+ReturnOop ClassFileParser::expand_stackmaps(Method* method JVM_TRAPS) {
+  UsingFastOops fast_oops;
+  Oop::Fast maps = method->stackmaps();
+  if (maps.is_null() || !maps.is_byte_array()) {
+    return maps;
+  }
+
+  // See parse_code_attributes() for the layout of the raw attribute.
+  Buffer::Fast raw = maps.obj();
+  ConstantPool::Fast cp = method->constants();
+  ObjArray::Fast stackmaps;
+  {
+    ClassFileParser parser(&raw);
+    const jushort max_stack = parser.get_u2(JVM_SINGLE_ARG_CHECK_0);
+    const jushort num_stackmaps = parser.get_u2(JVM_SINGLE_ARG_CHECK_0);
+    stackmaps = Universe::new_obj_array(2*num_stackmaps JVM_CHECK_0);
+
+    juint stackmap_attribute_length =
+      parser.parse_stackmaps(&cp, num_stackmaps, max_stack,
+                             method->max_locals(), method->code_size(),
+                             &stackmaps, true JVM_CHECK_0);
+    if (stackmap_attribute_length != (juint)raw().length() - 2) {
+      classfile_parse_error(bad_stackmap_attribute_size
+                            JVM_NO_CHECK_AT_BOTTOM);
+      return NULL;
+    }
+  }
+
+  method->set_stackmaps(&stackmaps);
+  return stackmaps;
+}
+
 inline ReturnOop ClassFileParser::parse_exception_table(int code_length, 
                                                  ConstantPool* cp JVM_TRAPS) {
   const int table_length = get_u2(JVM_SINGLE_ARG_CHECK_0);
@@ -971,7 +1009,7 @@ ClassFileParser::parse_method(ClassParserState *state, ConstantPool* cp,
   bool is_code_required = 
       !(access_flags.is_native() || access_flags.is_abstract());
   bool parsed_checked_exceptions_attribute = false;
-  ObjArray::Fast stackmaps;
+  Oop::Fast stackmaps;
 
 #if USE_REFLECTION
   TypeArray::Fast thrown_exceptions;
@@ -1155,7 +1193,7 @@ inline ReturnOop ClassFileParser::parse_code_attributes(ConstantPool* cp,
                    LineVarTable *line_var_table JVM_TRAPS)
 {
   UsingFastOops fast_oops;
-  ObjArray::Fast stackmaps;
+  Oop::Fast stackmaps;
   jushort num_stackmaps;
   int attributes_count = get_u2(JVM_SINGLE_ARG_CHECK_0);
 
@@ -1234,13 +1272,39 @@ inline ReturnOop ClassFileParser::parse_code_attributes(ConstantPool* cp,
         return 0;
       }
 
-      num_stackmaps = get_u2(JVM_SINGLE_ARG_CHECK_0);
-      stackmaps = Universe::new_obj_array(2*num_stackmaps JVM_CHECK_0);
-
-      // parse the stackmap entries for this method
-      juint stackmap_attribute_length =
-               parse_stackmaps(cp, num_stackmaps, max_stack, max_locals,
-                                   code_length, &stackmaps JVM_CHECK_0);
+      juint stackmap_attribute_length;
+      if (LazyStackmapParsing && get_UseVerifier() && !GenerateROMImage) {
+        // The stackmaps are only needed when the class is verified, which
+        // never happens for classes that are loaded but not linked (e.g.,
+        // those loaded by the verifier for assignability checks). Parsed
+        // eagerly, every entry takes two arrays of max_stack + max_locals
+        // + 4 elements, 2 * (8 + 4 * 14) = 128 bytes for a method with 4
+        // stack and 6 local slots, from loading until verification. The
+        // raw entry takes 6 bytes plus 1 to 3 per recorded slot. Keep the
+        // raw attribute, prefixed by the declared max_stack (the method's
+        // max_stack is adjusted for monitors later), and let
+        // expand_stackmaps() parse it on demand.
+        if (available_bytes() < (jint)attribute_length) {
+          truncated_class_file_error(JVM_SINGLE_ARG_THROW_0);
+        }
+        TypeArray::Raw raw =
+          Universe::new_byte_array_raw(attribute_length + 2 JVM_CHECK_0);
+        Bytes::put_Java_u2(raw().base_address(), max_stack);
+        jvm_memcpy(raw().base_address() + 2, _bufptr, attribute_length);
+        _bufptr += attribute_length;
+        stackmaps = raw.obj();
+        stackmap_attribute_length = attribute_length;
+      } else {
+        num_stackmaps = get_u2(JVM_SINGLE_ARG_CHECK_0);
+        ObjArray::Fast parsed_stackmaps =
+          Universe::new_obj_array(2*num_stackmaps JVM_CHECK_0);
+
+        // parse the stackmap entries for this method
+        stackmap_attribute_length =
+          parse_stackmaps(cp, num_stackmaps, max_stack, max_locals,
+                          code_length, &parsed_stackmaps, false JVM_CHECK_0);
+        stackmaps = parsed_stackmaps.obj();
+      }
       if (stackmap_attribute_length != attribute_length) {
         // Bad stackmap attribute size
         classfile_parse_error(bad_stackmap_attribute_size 
@@ -1974,6 +2038,12 @@ ReturnOop ClassFileParser::parse_class_internal(ClassParserState *stack JVM_TRAP
   cpf_check_0(get_buffer_position() == _buffer->length(),
           inconsistent_classfile_size);
 
+#if USE_VERIFIER_CACHE
+  if (get_UseVerifier()) {
+    VerifierCache::class_parsed(&this_class, _buffer JVM_CHECK_0);
+  }
+#endif
+
 #if ENABLE_ROM_GENERATOR
   _total_classfile_bytes += get_buffer_position();
 #endif
@@ -2011,6 +2081,10 @@ ReturnOop ClassFileParser::parse_class_internal(ClassParserState *stack JVM_TRAP
   check_local_interfaces(&this_class JVM_CHECK_0);
   this_class().check_and_initialize_itable(JVM_SINGLE_ARG_CHECK_0);
 
+  // Subtype checks made while the class was being linked may have cached
+  // negative results that no longer hold.
+  JavaClass::flush_subtype_check_cache();
+
   if (VerboseClassLoading) {
     TTY_TRACE(("[Loaded "));
     Symbol sym = this_class().name();
@@ -52,6 +52,20 @@ class ClassFileParser: public StackObj {
     _head              = this;
   }
 
+  // Used by expand_stackmaps() to parse a raw StackMap attribute.
+  ClassFileParser(Buffer* buffer) {
+    _buffer            = buffer;
+    set_buffer_position(0);
+    _loader_ctx        = NULL;
+    _name              = NULL;
+#ifdef USE_CLASS_LOADER
+    _class_loader      = NULL;
+    _protection_domain = NULL;
+#endif
+    _previous          = _head;
+    _head              = this;
+  }
+
   ~ClassFileParser( void ) {
     // Pop this from the static class file parser list
     _head = _previous;
@@ -87,6 +101,12 @@ class ClassFileParser: public StackObj {
                                          address native_function JVM_TRAPS);
   static void gc_prologue( void );
   static void gc_epilogue( void );
+
+  // With +LazyStackmapParsing the stackmaps of a method are kept as the
+  // raw StackMap attribute until the class is verified. Returns the
+  // verifier stackmaps of <method>, parsing them (and storing them into
+  // the method) first if necessary.
+  static ReturnOop expand_stackmaps(Method* method JVM_TRAPS);
  private:
   TypeArray*       _buffer;
   jubyte*          _bufptr;
@@ -197,11 +217,13 @@ class ClassFileParser: public StackObj {
                                   LineVarTable *line_var_table JVM_TRAPS);
   static void init_native_method(Method *method, address native_function);
 
-  // Stackmap parsing
+  // Stackmap parsing. <is_deferred> is true when called from
+  // expand_stackmaps(), after the class has been loaded.
   juint parse_stackmaps(ConstantPool* cp, 
                         jushort num_stackmaps, jushort max_stack, 
                         jushort frame_size, juint code_length, 
-                        ObjArray* stackmaps JVM_TRAPS);
+                        ObjArray* stackmaps, const bool is_deferred
+                        JVM_TRAPS);
 
   // Classfile attribute parsing
   void parse_classfile_sourcefile_attribute(ConstantPool* cp JVM_TRAPS);
@@ -86,8 +86,272 @@ inline ReturnOop ClassPathAccess::open_local_file(PathChar* path_name,
                                JVM_NO_CHECK_AT_BOTTOM);
 }
 
+#if USE_CLASSPATH_NEGATIVE_CACHE
+
+ClassPathAccess::Element ClassPathAccess::_elements[max_cached_elements];
+ClassPathAccess::Miss*   ClassPathAccess::_misses = NULL;
+juint                    ClassPathAccess::_miss_mask = 0;
+juint                    ClassPathAccess::_classpath_signature = 0;
+
+// Two independent hashes of the entry name: FNV-1a, and the usual 31*h+c
+// hash with a final mix, so that the Bloom filter can derive all of its
+// probes from them (see filter_may_contain()).
+inline static void hash_name(juint& hash1, juint& hash2,
+                             const char* name, int length) {
+  juint h1 = hash1;
+  juint h2 = hash2;
+  for (int i=0; i<length; i++) {
+    const juint c = (juint)(unsigned char)name[i];
+    h1 = (h1 ^ c) * 16777619;
+    h2 = 31 * h2 + c;
+  }
+  hash1 = h1;
+  hash2 = h2;
+}
+
+inline static juint finish_hash(juint h) {
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  // An odd step visits 2^n different bits of the filter
+  return h | 1;
+}
+
+void ClassPathAccess::compute_key(Symbol* entry_symbol,
+                                  const bool is_class_file, NameKey& key) {
+  juint h1 = 2166136261u;
+  juint h2 = 0;
+  hash_name(h1, h2, entry_symbol->base_address(), entry_symbol->length());
+  if (is_class_file) {
+    hash_name(h1, h2, ".class", 6);
+  }
+  key.hash1 = h1;
+  key.hash2 = finish_hash(h2);
+}
+
+void ClassPathAccess::add_filter_entry(const char* name, int length,
+                                       void* data) {
+  Element* e = (Element*)data;
+  juint h1 = 2166136261u;
+  juint h2 = 0;
+  hash_name(h1, h2, name, length);
+  h2 = finish_hash(h2);
+
+  for (int i=0; i<bloom_hash_count; i++) {
+    const juint bit = h1 & e->filter_mask;
+    e->filter[bit >> 5] |= (juint)1 << (bit & 31);
+    h1 += h2;
+  }
+}
+
+inline bool ClassPathAccess::filter_may_contain(const Element* e,
+                                                const NameKey& key) {
+  juint h = key.hash1;
+  for (int i=0; i<bloom_hash_count; i++) {
+    const juint bit = h & e->filter_mask;
+    if ((e->filter[bit >> 5] & ((juint)1 << (bit & 31))) == 0) {
+      return false;
+    }
+    h += key.hash2;
+  }
+  return true;
+}
+
+void ClassPathAccess::build_filter(Element* e, JarFileParser* parser) {
+  const int bits_per_entry = min(max(ClassPathBloomBitsPerEntry, 1), 64);
+  const juint wanted = (juint)parser->total_entry_count() * bits_per_entry;
+  juint bits = min_filter_bits;
+  while (bits < wanted && bits < (juint)max_filter_bits) {
+    bits <<= 1;
+  }
+
+  e->kind = unfiltered_jar_element;
+  juint* filter = (juint*)OsMemory_allocate(bits / BitsPerByte);
+  if (filter == NULL) {
+    return;
+  }
+  jvm_memset(filter, 0, bits / BitsPerByte);
+  e->filter = filter;
+  e->filter_mask = bits - 1;
+
+  if (!parser->do_entry_names(&add_filter_entry, (void*)e)) {
+    // A Bloom filter that misses some names would hide these entries.
+    OsMemory_free(filter);
+    e->filter = NULL;
+    e->filter_mask = 0;
+    return;
+  }
+  e->kind = jar_element;
+
+  if (TraceClassPathCache) {
+    TTY_TRACE_CR(("ClassPathCache: element %d: %d entries, %d filter bits",
+                  (int)(e - _elements), parser->total_entry_count(), bits));
+  }
+}
+
+juint ClassPathAccess::classpath_signature(OopDesc* classpath) {
+  if (classpath == NULL) {
+    return 0;
+  }
+  ObjArray::Raw cp = classpath;
+  const int cp_length = cp().length();
+  juint signature = (juint)cp_length;
+  for (int index = 0; index < cp_length; index++) {
+    FilePath::Raw path = cp().obj_at(index);
+    if (path.is_null()) {
+      signature = 31 * signature + 1;
+      continue;
+    }
+    const int path_length = path().length();
+    signature = 31 * signature + (juint)path_length;
+    for (int i = 0; i < path_length; i++) {
+      signature = 31 * signature + (juint)path().char_at(i);
+    }
+  }
+  return signature;
+}
+
+void ClassPathAccess::check_classpath() {
+  Task* task = Task::current();
+  const juint signature =
+      31 * classpath_signature(task->sys_classpath()) +
+           classpath_signature(task->app_classpath());
+  if (signature != _classpath_signature) {
+    if (TraceClassPathCache) {
+      TTY_TRACE_CR(("ClassPathCache: classpath has changed"));
+    }
+    invalidate_cache();
+    _classpath_signature = signature;
+  }
+}
+
+void ClassPathAccess::invalidate_cache() {
+  for (int i = 0; i < max_cached_elements; i++) {
+    Element* e = &_elements[i];
+    if (e->filter != NULL) {
+      OsMemory_free(e->filter);
+    }
+    e->kind = unknown_element;
+    e->filter_mask = 0;
+    e->filter = NULL;
+  }
+  if (_misses != NULL) {
+    jvm_memset(_misses, 0, (_miss_mask + 1) * sizeof(Miss));
+  }
+}
+
+void ClassPathAccess::dispose() {
+  invalidate_cache();
+  if (_misses != NULL) {
+    OsMemory_free(_misses);
+    _misses = NULL;
+  }
+  _miss_mask = 0;
+  _classpath_signature = 0;
+}
+
+inline bool ClassPathAccess::is_known_miss(const int element,
+                                           const NameKey& key) {
+  jvm_perf_count.num_of_classpath_probes ++;
+  if (element >= max_cached_elements) {
+    return false;
+  }
+  const Element* e = &_elements[element];
+  bool is_miss = false;
+  if (e->kind == jar_element) {
+    is_miss = !filter_may_contain(e, key);
+  } else if (e->kind == directory_element && _misses != NULL) {
+    const Miss* m = &_misses[(key.hash1 + (juint)element) & _miss_mask];
+    is_miss = m->element == (juint)element + 1 &&
+              m->hash1 == key.hash1 && m->hash2 == key.hash2;
+  }
+  if (is_miss) {
+    jvm_perf_count.num_of_classpath_cache_hits ++;
+  }
+  return is_miss;
+}
+
+inline bool ClassPathAccess::is_directory(const int element) {
+  return element < max_cached_elements &&
+         _elements[element].kind == directory_element;
+}
+
+inline void ClassPathAccess::set_directory(const int element) {
+  if (element < max_cached_elements) {
+    _elements[element].kind = directory_element;
+  }
+}
+
+void ClassPathAccess::set_missing(const int element) {
+  if (element < max_cached_elements) {
+    Element* e = &_elements[element];
+    if (e->filter != NULL) {
+      // The JAR file has gone away since its filter was built.
+      OsMemory_free(e->filter);
+      e->filter = NULL;
+      e->filter_mask = 0;
+    }
+    e->kind = missing_element;
+  }
+}
+
+inline bool ClassPathAccess::jar_may_contain(const int element,
+                                             JarFileParser* parser,
+                                             const NameKey& key) {
+  if (element >= max_cached_elements) {
+    return true;
+  }
+  Element* e = &_elements[element];
+  if (e->kind == unknown_element) {
+    build_filter(e, parser);
+    if (e->kind == jar_element && !filter_may_contain(e, key)) {
+      jvm_perf_count.num_of_classpath_cache_hits ++;
+      return false;
+    }
+  }
+  return true;
+}
+
+void ClassPathAccess::record_miss(const int element, const NameKey& key) {
+  if (element >= max_cached_elements) {
+    return;
+  }
+  if (_elements[element].kind == jar_element) {
+    // The Bloom filter has let through a name that isn't in the JAR file.
+    jvm_perf_count.num_of_classpath_false_positives ++;
+    return;
+  }
+  if (_elements[element].kind != directory_element) {
+    return;
+  }
+  if (_misses == NULL) {
+    if (ClassPathMissCacheSize <= 0) {
+      return;
+    }
+    juint size = 1;
+    while (size < (juint)ClassPathMissCacheSize) {
+      size <<= 1;
+    }
+    _misses = (Miss*)OsMemory_allocate(size * sizeof(Miss));
+    if (_misses == NULL) {
+      return;
+    }
+    jvm_memset(_misses, 0, size * sizeof(Miss));
+    _miss_mask = size - 1;
+  }
+  Miss* m = &_misses[(key.hash1 + (juint)element) & _miss_mask];
+  m->element = (juint)element + 1;
+  m->hash1 = key.hash1;
+  m->hash2 = key.hash2;
+}
+
+#endif // USE_CLASSPATH_NEGATIVE_CACHE
+
 ReturnOop ClassPathAccess::open_entry(Symbol* entry_name,
-                     const bool is_class_file, OopDesc* classpath JVM_TRAPS)
+                     const bool is_class_file, OopDesc* classpath,
+                     const NameKey* key, const int first_element JVM_TRAPS)
 {
   if( !classpath ) {
     return NULL;
@@ -117,18 +381,58 @@ ReturnOop ClassPathAccess::open_entry(Symbol* entry_name,
     }
     path().string_copy( path_name, NAME_BUFFER_SIZE );
 
-    parser = JarFileParser::get(path_name, true JVM_NO_CHECK);
+    bool may_be_jar = true;
+#if USE_CLASSPATH_NEGATIVE_CACHE
+    const int element = first_element + index;
+    if( key != NULL ) {
+      if( is_known_miss(element, *key) ) {
+        continue;
+      }
+      may_be_jar = !is_directory(element);
+    }
+#else
+    (void)key;
+    (void)first_element;
+#endif
+
+    if( may_be_jar ) {
+      parser = JarFileParser::get(path_name, true JVM_NO_CHECK);
+    }
     if( parser.not_null() ) {
+#if USE_CLASSPATH_NEGATIVE_CACHE
+      if( key != NULL && !jar_may_contain(element, &parser, *key) ) {
+        parser.set_null();
+        continue;
+      }
+#endif
       p = open_jar_entry(&parser, entry_name, is_class_file JVM_CHECK_0);
       parser.set_null();
     } else if( (path_length + 1 + entry_name->length()) >= NAME_BUFFER_SIZE ){
       continue; // Sorry, name too long
     } else {
+#if USE_CLASSPATH_NEGATIVE_CACHE
+      // Don't take a JAR file that couldn't be opened for lack of memory
+      // for a missing one.
+      if( key != NULL && !CURRENT_HAS_PENDING_EXCEPTION &&
+          !is_directory(element) ) {
+        set_missing(element);
+      }
+#endif
       p = open_local_file(path_name, entry_name, is_class_file JVM_CHECK_0);
+#if USE_CLASSPATH_NEGATIVE_CACHE
+      if( p && key != NULL ) {
+        set_directory(element);
+      }
+#endif
     }
     if( p ) {
       break;
     }
+#if USE_CLASSPATH_NEGATIVE_CACHE
+    if( key != NULL ) {
+      record_miss(element, *key);
+    }
+#endif
   }
   return p;
 }
@@ -162,13 +466,27 @@ ReturnOop ClassPathAccess::open_entry(Symbol* entry_symbol,
   }
 #endif
 
+  const NameKey* key = NULL;
+#if USE_CLASSPATH_NEGATIVE_CACHE
+  NameKey name_key;
+  if (UseClassPathNegativeCache) {
+    check_classpath();
+    compute_key(entry_symbol, is_class_file, name_key);
+    key = &name_key;
+  }
+#endif
+
+  ObjArray::Raw sys_classpath = Task::current()->sys_classpath();
+  const int sys_length = sys_classpath.is_null() ? 0 : sys_classpath().length();
+
   OopDesc* p = open_entry( entry_symbol, is_class_file,
-                           Task::current()->sys_classpath() JVM_CHECK_0 );
+                           sys_classpath.obj(), key, 0 JVM_CHECK_0 );
   if( p ) {
     FileDecoder::Raw decoder(p);
     decoder().add_flags(SYSTEM_CLASSPATH);
     return p;
   }
   return open_entry( entry_symbol, is_class_file,
-                           Task::current()->app_classpath() JVM_NO_CHECK );
+                     Task::current()->app_classpath(), key, sys_length
+                     JVM_NO_CHECK );
 }
@@ -34,12 +34,94 @@ public:
   // Read the given entry from the system classpath.
   static ReturnOop open_entry(Symbol* entry_name, const bool is_class_file
                                                                 JVM_TRAPS);                              
+#if USE_CLASSPATH_NEGATIVE_CACHE
+  // Forget everything the negative lookup cache knows about the
+  // classpath elements, e.g., because a JAR file is being rewritten.
+  static void invalidate_cache();
+
+  // Free all memory used by the negative lookup cache.
+  static void dispose();
+#endif
+
 private:
+  // Identifies the name of a classpath entry (including the ".class"
+  // suffix of class files) in the negative lookup cache.
+  struct NameKey {
+    juint hash1;
+    juint hash2;
+  };
+
   static ReturnOop open_entry(Symbol* entry_name, const bool is_class_file,
-                                              OopDesc* classpath JVM_TRAPS);
+                              OopDesc* classpath, const NameKey* key,
+                              const int first_element JVM_TRAPS);
   static ReturnOop open_jar_entry(JarFileParser *parser, Symbol * entry_name,
                                   const bool is_class_file JVM_TRAPS);
   static ReturnOop open_local_file(PathChar* path_name, Symbol * entry_name,
                                   const bool is_class_file JVM_TRAPS);
   enum { NAME_BUFFER_SIZE = 270 };
+
+#if USE_CLASSPATH_NEGATIVE_CACHE
+  // The negative lookup cache remembers, for each element of the system
+  // and application classpath, which entries it doesn't contain:
+  //
+  // - For a JAR file, a Bloom filter of the names in its central
+  //   directory is built the first time the JAR file is searched. Names
+  //   rejected by the filter are skipped without opening the JAR file.
+  // - For a directory, the most recent misses are kept in a small
+  //   direct-mapped table. An element that can't be opened as a JAR file
+  //   is only taken for a directory once a file has been found in it.
+  //   Until then it may be a JAR file that doesn't exist yet, so it is
+  //   looked up again every time and no misses are cached for it.
+  //
+  // Elements are identified by their position in the classpath, so the
+  // whole cache is dropped when the classpath of the current task changes.
+  enum ElementKind {
+    unknown_element,
+    jar_element,            // a JAR file with a Bloom filter
+    unfiltered_jar_element, // a JAR file whose entries can't be read
+    missing_element,        // neither a JAR file nor a known directory
+    directory_element
+  };
+
+  struct Element {
+    juint  kind;
+    juint  filter_mask;     // number of bits in the filter - 1
+    juint* filter;
+  };
+
+  struct Miss {
+    juint element;          // index of the element + 1, 0 for an empty slot
+    juint hash1;
+    juint hash2;
+  };
+
+  enum {
+    max_cached_elements = 32,
+    bloom_hash_count    = 4,
+    min_filter_bits     = 64,
+    max_filter_bits     = 1 << 24
+  };
+
+  static void compute_key(Symbol* entry_name, const bool is_class_file,
+                          NameKey& key);
+  static void check_classpath();
+  static juint classpath_signature(OopDesc* classpath);
+
+  static bool is_known_miss(const int element, const NameKey& key);
+  static bool is_directory(const int element);
+  static void set_directory(const int element);
+  static void set_missing(const int element);
+  static bool jar_may_contain(const int element, JarFileParser* parser,
+                              const NameKey& key);
+  static void record_miss(const int element, const NameKey& key);
+
+  static void build_filter(Element* e, JarFileParser* parser);
+  static void add_filter_entry(const char* name, int length, void* data);
+  static bool filter_may_contain(const Element* e, const NameKey& key);
+
+  static Element _elements[max_cached_elements];
+  static Miss*   _misses;
+  static juint   _miss_mask;
+  static juint   _classpath_signature;
+#endif
 };
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) Max Mu
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License version 2 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * Please visit www.joshvm.org if you need additional information or
+ * have any questions.
+ */
+
+#include "incls/_precompiled.incl"
+#include "incls/_ConsoleOutput.cpp.incl"
+
+char                ConsoleOutput::_buffer[MaxBufferSize + 1];
+int                 ConsoleOutput::_length = 0;
+ConsoleOutput::Sink ConsoleOutput::_sink = NULL;
+ConsoleOutput::Drain ConsoleOutput::_drain = NULL;
+
+inline int ConsoleOutput::buffer_size() {
+  // A size of 0 (or 1) flushes every byte, as the VM always used to do.
+  const int size = ConsoleBufferSize;
+  if (size < 1) {
+    return 1;
+  }
+  return size < MaxBufferSize ? size : MaxBufferSize;
+}
+
+void ConsoleOutput::write(const char* s, int length) {
+  const int size = buffer_size();
+  const bool line_buffered = ConsoleLineBuffered;
+  for (int i = 0; i < length; i++) {
+    const char c = s[i];
+    if (c == 0) {
+      // The sinks print 0-terminated strings, and tty used to drop a
+      // printed '\0' as well.
+      continue;
+    }
+    _buffer[_length++] = c;
+    if (_length >= size || (line_buffered && c == '\n')) {
+      flush_buffer();
+    }
+  }
+}
+
+void ConsoleOutput::flush_buffer() {
+  // Empty the buffer before printing, as tty flushes this buffer
+  // itself before printing anything.
+  const int length = _length;
+  _length = 0;
+  _buffer[length] = 0;
+  if (_sink != NULL) {
+    _sink(_buffer, length);
+  } else {
+    print_on_tty(_buffer, length);
+  }
+}
+
+void ConsoleOutput::set_sink(Sink sink, Drain drain) {
+  flush();
+  _sink = sink;
+  _drain = drain;
+}
+
+void ConsoleOutput::print_on_tty(const char* s, int /*length*/) {
+  tty->print_raw(s);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) Max Mu
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License version 2 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * Please visit www.joshvm.org if you need additional information or
+ * have any questions.
+ */
+
+// ConsoleOutput collects the bytes that Java code writes to System.out
+// (through com.sun.cldchi.io.ConsoleOutputStream), so that they reach the
+// platform one line or one buffer at a time instead of one byte at a time.
+//
+// With +ConsoleLineBuffered the buffer is flushed at every '\n', otherwise
+// only when it is full. -XX:ConsoleBufferSize=0 turns buffering off. The
+// buffer is also flushed before the VM prints anything itself on tty, so
+// that VM and Java output stay in order, and when the VM shuts down.
+//
+// Flushed data goes to tty unless the OS port installs another sink, e.g.,
+// to move the actual printing to a separate native thread. Such a sink
+// comes with a drain function that waits until everything handed to the
+// sink has been printed, so that the order is kept in that case, too.
+
+class ConsoleOutput : public AllStatic {
+ public:
+  // Prints <length> bytes. <s>[<length>] is always 0. The buffer is
+  // reused once the sink returns, so a sink that prints later has to copy.
+  typedef void (*Sink)(const char* s, int length);
+  // Returns once all bytes given to the sink so far have been printed.
+  typedef void (*Drain)();
+
+  static void write(const char* s, int length);
+  static void write(char c) {
+    write(&c, 1);
+  }
+
+  // Hands all buffered bytes to the sink and waits until they are
+  // printed. Called before the VM prints on tty, when the VM shuts down,
+  // and by OS ports when the process is about to die on a fatal signal.
+  static void flush() {
+    if (_length > 0) {
+      flush_buffer();
+    }
+    if (_drain != NULL) {
+      _drain();
+    }
+  }
+
+  // Passing NULL restores the default sink, tty. <drain> may be NULL if
+  // <sink> prints synchronously.
+  static void set_sink(Sink sink, Drain drain = NULL);
+
+ private:
+  enum {
+    MaxBufferSize = 1024
+  };
+
+  static char _buffer[MaxBufferSize + 1];
+  static int  _length;
+  static Sink _sink;
+  static Drain _drain;
+
+  static int  buffer_size();
+  static void flush_buffer();
+  static void print_on_tty(const char* s, int length);
+};
@@ -100,6 +100,27 @@ int FileDecoder::get_bytes_raw(address dest_address, int count) {
   GUARANTEE(handle != NULL, "What are we reading from?");
 
   int pos = file_pos();
+
+#if USE_JAR_FILE_MAPPING
+  // STORED entries of a mapped JAR file are copied out of the mapping.
+  // The destination is a heap array, so one copy remains; the mapping
+  // only saves the seek, the read call and the copy through the stdio
+  // buffer.
+  long length;
+  const address mapped = OsFile_mapped_address(handle, &length);
+  if (mapped != NULL) {
+    if (pos < 0 || pos > length) {
+      return 0;
+    }
+    if (count > length - pos) {
+      count = (int)(length - pos);
+    }
+    jvm_memcpy(dest_address, mapped + pos, count);
+    set_file_pos(pos + count);
+    return count;
+  }
+#endif
+
   OsFile_seek(handle, pos, SEEK_SET);
   int bytes_read = OsFile_read(handle, dest_address, 1, count);
   set_file_pos(pos + bytes_read);
@@ -190,7 +190,31 @@ juint Inflater::crc32(const unsigned char *data, const juint length) {
 #if ENABLE_FAST_CRC32
   const juint *table = _fast_crc32_table;
 
-  switch (length & 3) {
+#if ENABLE_FAST_CRC32_SLICING
+  if (length >= 64) {
+    if (!_crc32_slicing_table_initialized) {
+      initialize_crc32_slicing_table();
+    }
+    const juint (*t)[256] = _crc32_slicing_table;
+    const unsigned char* last = end - 8;
+
+    // Bytes are assembled explicitly so that this works on unaligned
+    // data and on either byte order.
+    while (data <= last) {
+      juint one = crc ^ ((juint)data[0]       | ((juint)data[1] << 8) |
+                         ((juint)data[2] << 16) | ((juint)data[3] << 24));
+      juint two =        ((juint)data[4]       | ((juint)data[5] << 8) |
+                         ((juint)data[6] << 16) | ((juint)data[7] << 24));
+      crc = t[6][ one        & 0xFF] ^ t[5][(one >>  8) & 0xFF] ^
+            t[4][(one >> 16) & 0xFF] ^ t[3][ one >> 24        ] ^
+            t[2][ two        & 0xFF] ^ t[1][(two >>  8) & 0xFF] ^
+            t[0][(two >> 16) & 0xFF] ^ table[two >> 24       ];
+      data += 8;
+    }
+  }
+#endif
+
+  switch ((end - data) & 3) {
     do {
       crc = table[ ( crc ^ *data++ ) & 0xFF ] ^ (crc >> 8);
     case 3:
@@ -283,16 +283,22 @@ int Inflater::inflate_stored(JVM_SINGLE_ARG_TRAPS) {
 }
 
 int Inflater::inflate_huffman(bool fixedHuffman JVM_TRAPS) {
-  unsigned int code, litxlen;
-  unsigned int quickDataSize = 0, quickDistanceSize = 0;
-  HuffmanCodeTable *lcodes = NULL, *dcodes = NULL;
+  unsigned int litxlen;
+  unsigned int quickDataSize, quickDistanceSize;
+  HuffmanCodeTable *lcodes, *dcodes;
 
-  if (!fixedHuffman) {
+  if (fixedHuffman) {
+    if (!_fixed_tables_initialized) {
+      initialize_fixed_tables();
+    }
+    lcodes = (HuffmanCodeTable*) &_fixed_lcodes;
+    dcodes = (HuffmanCodeTable*) &_fixed_dcodes;
+  } else {
     lcodes = (HuffmanCodeTable*) ARRAY_BASE(length_buffer());
     dcodes = (HuffmanCodeTable*) ARRAY_BASE(distance_buffer());
-    quickDataSize = lcodes->h.quickBits;
-    quickDistanceSize = dcodes->h.quickBits;
   }
+  quickDataSize = lcodes->h.quickBits;
+  quickDistanceSize = dcodes->h.quickBits;
 
   LOAD_IN;
   LOAD_OUT;
@@ -305,33 +311,7 @@ int Inflater::inflate_huffman(bool fixedHuffman JVM_TRAPS) {
       break;
     }
     NEEDBITS(MAX_BITS + MAX_ZIP_EXTRA_LENGTH_BITS);
-    
-    if (fixedHuffman) {
-      //   literal (hex)
-      // 0x100 - 0x117   7   0.0000.00   -  0.0101.11
-      //     0 -    8f   8   0.0110.000  -  1.0111.111
-      //   118 -   11f   8   1.1000.000  -  1.1000.111
-      //    90 -    ff   9   1.1001.0000 -  1.1111.1111
-            
-      // Get 9 bits, and reverse them.
-      code = NEXTBITS(9);
-      code = reverse_9bits(code);
-      
-      if (code <  0x060) {
-        // A 7-bit code 
-        DUMPBITS(7);
-        litxlen = 0x100 + (code >> 2);
-      } else if (code < 0x190) {
-        DUMPBITS(8);
-        litxlen = (code >> 1) + ((code < 0x180) ? (0x000 - 0x030)
-                                 : (0x118 - 0x0c0));
-      } else {
-        DUMPBITS(9);
-        litxlen = 0x90 + code - 0x190;
-      }
-    } else {
-      GET_HUFFMAN_ENTRY(lcodes, quickDataSize, litxlen);
-    }
+    GET_HUFFMAN_ENTRY(lcodes, quickDataSize, litxlen);
 
     if (litxlen <= 255) {
       if (outOffset >= outLength) {
@@ -360,13 +340,7 @@ int Inflater::inflate_huffman(bool fixedHuffman JVM_TRAPS) {
       DUMPBITS(moreBits);
 
       NEEDBITS(MAX_BITS);
-      if (fixedHuffman) {
-        d0 = (juint) NEXTBITS(5);
-        d0 = reverse_5bits(d0);
-        DUMPBITS(5);
-      } else {
-        GET_HUFFMAN_ENTRY(dcodes, quickDistanceSize, d0);
-      }
+      GET_HUFFMAN_ENTRY(dcodes, quickDistanceSize, d0);
 
       if (d0 > MAX_ZIP_DISTANCE_CODE) {
         ziperr(KVM_MSG_JAR_BAD_DISTANCE_CODE);
@@ -391,16 +365,29 @@ int Inflater::inflate_huffman(bool fixedHuffman JVM_TRAPS) {
           return INFLATE_ERROR;
         }
       }
-      juint prev = outOffset - distance;
+      unsigned char* dst = &outFilePtr[outOffset];
+      outOffset += length;
+
       // src and destination may overlap, and we are to copy
       // in left-to-right order.
-      while (length > distance) {
-        outFilePtr[outOffset++] = outFilePtr[prev++];
-        length--;
+      if (distance == 1) {
+        // A run of a single byte
+        jvm_memset(dst, dst[-1], length);
+      } else if (distance < MIN_CHUNKED_COPY_DISTANCE) {
+        const unsigned char* src = dst - distance;
+        while (length-- > 0) {
+          *dst++ = *src++;
+        }
+      } else {
+        // Each chunk of <distance> bytes only reads bytes that have
+        // already been written, so a memcpy per chunk is safe.
+        while (length > distance) {
+          jvm_memcpy(dst, dst - distance, distance);
+          dst += distance;
+          length -= distance;
+        }
+        jvm_memcpy(dst, dst - distance, length);
       }
-      // With length <= distance, a memcpy is safe
-      jvm_memcpy(&outFilePtr[outOffset], &outFilePtr[prev], length);
-      outOffset += length;
     }
   } while (!buffer_full);
   
@@ -409,6 +396,62 @@ int Inflater::inflate_huffman(bool fixedHuffman JVM_TRAPS) {
   return INFLATE_MORE;
 }
 
+Inflater::FixedLiteralTable  Inflater::_fixed_lcodes;
+Inflater::FixedDistanceTable Inflater::_fixed_dcodes;
+bool Inflater::_fixed_tables_initialized = false;
+
+void Inflater::initialize_fixed_tables() {
+  // Code lengths of the fixed literal/length alphabet, followed by
+  // those of the fixed distance alphabet. Distance codes 30 and 31 never
+  // occur in valid data and are rejected by inflate_huffman().
+  unsigned char codelen[288 + 32];
+  jvm_memset(codelen,       8, 144);
+  jvm_memset(codelen + 144, 9, 256 - 144);
+  jvm_memset(codelen + 256, 7, 280 - 256);
+  jvm_memset(codelen + 280, 8, 288 - 280);
+  jvm_memset(codelen + 288, 5, 32);
+
+  fill_fixed_table((HuffmanCodeTable*) &_fixed_lcodes, codelen, 288,
+                   FIXED_LITERAL_BITS);
+  fill_fixed_table((HuffmanCodeTable*) &_fixed_dcodes, codelen + 288, 32,
+                   FIXED_DISTANCE_BITS);
+  _fixed_tables_initialized = true;
+}
+
+// Builds a complete single-level table, in the same format as
+// make_code_table(), for a code whose longest code is <codeLen> bits.
+void Inflater::fill_fixed_table(HuffmanCodeTable *table,
+                                const unsigned char *codelen,
+                                unsigned numElems, unsigned codeLen) {
+  unsigned int bitLengthCount[MAX_BITS + 1];
+  unsigned int codes[MAX_BITS + 1];
+  unsigned int code, bits, i, j;
+  const unsigned int tableLength = 1 << codeLen;
+
+  jvm_memset(bitLengthCount, 0, sizeof(bitLengthCount));
+  for (i = 0; i < numElems; i++) {
+    bitLengthCount[codelen[i]]++;
+  }
+  code = 0;
+  for (bits = 1; bits <= MAX_BITS; bits++) {
+    codes[bits] = code;
+    code += bitLengthCount[bits] << (MAX_BITS - bits);
+  }
+
+  table->h.quickBits  = (unsigned short)codeLen;
+  table->h.maxCodeLen = (unsigned short)codeLen;
+
+  for (i = 0; i < numElems; i++) {
+    bits = codelen[i];
+    GUARANTEE(bits >= 1 && bits <= codeLen, "sanity");
+    code = reverse_15bits(codes[bits]);
+    codes[bits] += 1 << (MAX_BITS - bits);
+    for (j = code; j < tableLength; j += 1 << bits) {
+      table->entries[j] = (unsigned short)((i << 4) + bits);
+    }
+  }
+}
+
 // Read in and decode the huffman tables in the compressed file
 
 int Inflater::decode_dynamic_huffman_tables(JVM_SINGLE_ARG_TRAPS) {
@@ -880,6 +923,22 @@ const unsigned char Inflater::reverse5[] = {
 };
 
 #if ENABLE_FAST_CRC32
+#if ENABLE_FAST_CRC32_SLICING
+juint Inflater::_crc32_slicing_table[7][256];
+bool  Inflater::_crc32_slicing_table_initialized = false;
+
+void Inflater::initialize_crc32_slicing_table() {
+  for (int i = 0; i < 256; i++) {
+    juint crc = _fast_crc32_table[i];
+    for (int k = 0; k < 7; k++) {
+      crc = _fast_crc32_table[crc & 0xFF] ^ (crc >> 8);
+      _crc32_slicing_table[k][i] = crc;
+    }
+  }
+  _crc32_slicing_table_initialized = true;
+}
+#endif
+
 const juint Inflater::_fast_crc32_table[] = {
   0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 
   0x076DC419, 0x706AF48F, 0xE963A535, 0x9E6495A3,
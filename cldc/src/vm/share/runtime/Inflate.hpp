@@ -191,6 +191,13 @@ private:
 
 #if ENABLE_FAST_CRC32
   const static juint _fast_crc32_table[];
+#if ENABLE_FAST_CRC32_SLICING
+  // _crc32_slicing_table[k][i] is the CRC of byte i followed by k+1 zero
+  // bytes; it is derived from _fast_crc32_table on first use.
+  static juint _crc32_slicing_table[7][256];
+  static bool  _crc32_slicing_table_initialized;
+  static void initialize_crc32_slicing_table();
+#endif
 #endif
 
   static juint crc32(const unsigned char *data, const juint length);
@@ -297,7 +304,14 @@ private:
 
     MAX_QUICK_CXD   = 6,
     MAX_QUICK_LXL   = 9,
-    MAX_BITS        = 15   // Maximum number of code bits in Huffman Code Table
+    MAX_BITS        = 15,  // Maximum number of code bits in Huffman Code Table
+
+    FIXED_LITERAL_BITS  = 9, // Longest fixed literal/length code
+    FIXED_DISTANCE_BITS = 5, // All fixed distance codes have 5 bits
+
+    // Back references with a shorter distance are copied byte by byte,
+    // longer ones in chunks of <distance> bytes.
+    MIN_CHUNKED_COPY_DISTANCE = 8
   };
 
   enum { 
@@ -308,15 +322,28 @@ private:
     BTYPE_UNKNOWN         = 0x7F
   };
 
-  unsigned int reverse_5bits(unsigned int code) { 
-    return reverse5[code];
-  }
+  // Single-level lookup tables for the fixed Huffman codes of RFC 1951,
+  // section 3.2.6. They are built on first use and shared by all
+  // Inflaters, so fixed blocks are decoded with the same table lookup
+  // as dynamic blocks.
+  struct FixedLiteralTable {
+    HuffmanCodeTableHeader h;
+    unsigned short entries[1 << FIXED_LITERAL_BITS];
+  };
+  struct FixedDistanceTable {
+    HuffmanCodeTableHeader h;
+    unsigned short entries[1 << FIXED_DISTANCE_BITS];
+  };
+  static FixedLiteralTable  _fixed_lcodes;
+  static FixedDistanceTable _fixed_dcodes;
+  static bool               _fixed_tables_initialized;
 
-  unsigned int reverse_9bits(unsigned int code) {
-    return ((reverse5[((code) & 0x1F)] << 4) | reverse5[(code) >> 4]);
-  }
+  static void initialize_fixed_tables();
+  static void fill_fixed_table(HuffmanCodeTable *table,
+                               const unsigned char *codelen,
+                               unsigned numElems, unsigned codeLen);
 
-  unsigned int reverse_15bits(unsigned int code) {
+  static unsigned int reverse_15bits(unsigned int code) {
     return (reverse5[code & 0x1F] << 10)
         | (reverse5[((code) >> 5) & 0x1F] << 5)
         | (reverse5[code >> 10]) ;
@@ -378,11 +378,19 @@ inline bool JVM::initialize( void ) {
     initialize_standalone_rom_generator();
   }
 
+#if USE_VERIFIER_CACHE
+  VerifierCache::initialize();
+#endif
+
   if (!Universe::bootstrap(_classpath)) {
     _exit_code = -1;
     return false;
   }
 
+#if ENABLE_PERF_MAP && ENABLE_COMPILER
+  PerfMap::initialize();
+#endif
+
 #if (ENABLE_COMPILER && ENABLE_PERFORMANCE_COUNTERS)
   if (TestCompiler) {
     CompilerTest::run();
@@ -397,6 +405,12 @@ inline bool JVM::initialize( void ) {
   }
 #endif
 
+#if !defined(PRODUCT) && USE_VERIFIER_CACHE
+  if (RunSha256Tests) {
+    JVM::exit(Sha256::run_test_cases() ? 0 : 1);
+  }
+#endif
+
   return true;
 }
 
@@ -549,6 +563,8 @@ void JVM::cleanup() {
     ObjectHeap::finalize_all();
   }
 
+  ConsoleOutput::flush();
+
 #if ENABLE_JAVA_DEBUGGER
   {
     Transport t = Universe::transport_head();
@@ -568,6 +584,9 @@ void JVM::cleanup() {
   if (PrintCompilationAtExit) {
     Compiler::print_compilation_history();
   }
+  if (PrintCompiledMethodCacheStatistics) {
+    CompiledMethodCache::print_statistics();
+  }
 #endif
 
 #if ENABLE_ISOLATES && ENABLE_PERFORMANCE_COUNTERS
@@ -585,9 +604,32 @@ void JVM::cleanup() {
   JVM::print_performance_counters();
 #endif
 
+  if (PrintHashTableStatistics) {
+    SystemDictionary::print_statistics(tty);
+    if (SymbolTable::current()->not_null()) {
+      SymbolTable::current()->print_statistics(tty);
+    }
+  }
+
   EventLogger::dump();
   EventLogger::dispose();
 
+#if ENABLE_PERF_MAP && ENABLE_COMPILER
+  PerfMap::dispose();
+#endif
+
+#if USE_VERIFIER_CACHE
+  VerifierCache::dispose();
+#endif
+
+#if USE_CLASSPATH_NEGATIVE_CACHE
+  ClassPathAccess::dispose();
+#endif
+
+#if ENABLE_DYNAMIC_NATIVE_METHODS
+  Natives::dispose_dynamic_symbols();
+#endif
+
   Universe::apocalypse();
   _is_started = false;  
   Thread::clear_current_pending_exception();
@@ -778,7 +820,7 @@ void JVM::get_binary_romizer_args(FilePath* input, FilePath *output JVM_TRAPS)
   if (_argc == 1) {
     char* arg = _argv[0];
     String str = Universe::new_string(arg, jvm_strlen(arg) JVM_CHECK);
-    *input = str.value();
+    *input = str.to_char_array(JVM_SINGLE_ARG_CHECK);
   } else if (_argc == 0 && Arguments::rom_input_file() != NULL) {
     const JvmPathChar *in = Arguments::rom_input_file();
     *input = FilePath::convert_to_unicode(in, fn_strlen(in) JVM_CHECK);
@@ -1383,6 +1425,13 @@ void JVM::print_performance_counters() {
   P_HRT(L, "max_load_hrticks",     pc->max_load_hrticks);
   P_HRT(A, "total_verify_hrticks", pc->total_verify_hrticks);
   P_HRT(L, "max_verify_hrticks",   pc->max_verify_hrticks);
+  P_INT(L, "num_of_verify_cache_hits", pc->num_of_verify_cache_hits);
+  P_HRT(L, "saved_verify_hrticks", pc->saved_verify_hrticks);
+  P_INT(L, "num_of_classpath_probes", pc->num_of_classpath_probes);
+  P_INT(L, "num_of_classpath_cache_hits",
+                                   pc->num_of_classpath_cache_hits);
+  P_INT(L, "num_of_classpath_false_positives",
+                                   pc->num_of_classpath_false_positives);
 
   P_INT(L, "num_of_romizer_steps", pc->num_of_romizer_steps);
   P_HRT(L, "total_romizer_hrticks",pc->total_romizer_hrticks);
@@ -1413,6 +1462,12 @@ void JVM::print_performance_counters() {
 
   P_INT(C, "uncommon_traps_generated", pc->uncommon_traps_generated);
   P_INT(C, "uncommon_traps_taken",     pc->uncommon_traps_taken);
+  P_INT(C, "escape_analysis_sites",    pc->escape_analysis_sites);
+  P_INT(C, "           eliminated",    pc->escape_analysis_eliminated);
+  P_INT(C, "compiled_method_evictions",pc->compiled_method_evictions);
+  P_INT(C, "         evicted_bytes",   pc->compiled_method_evicted_bytes);
+  P_INT(C, "         recompilations",  pc->compiled_method_recompilations);
+  P_INT(C, "         pins",            pc->compiled_method_pins);
   P_CR (C);
 
   if (UseROM) {
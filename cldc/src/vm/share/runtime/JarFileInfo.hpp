@@ -162,11 +162,9 @@ public:
   /// the uncompressed len of the current Jar entry.
   int length;
 
-#if ENABLE_ROM_GENERATOR
   /// the total number of entries in the central directory -- this value will
   /// never change as long as the JarFile is open.
   unsigned int totalEntryCount;
-#endif
 };
 
 typedef unsigned int (*GetByteFunctionType)(void *);
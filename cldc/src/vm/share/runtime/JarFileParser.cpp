@@ -261,6 +261,14 @@ ReturnOop JarFileParser::get(const JvmPathChar* jar_file_name1,
   parser().set_buffered_file(&bf);
   parser().set_timestamp(++_timestamp);
 
+#if USE_JAR_FILE_MAPPING
+  // A JAR file that is about to be rewritten (see remove_class_entries())
+  // must not be mapped.
+  if (UseMappedJarFiles && enable_entry_cache) {
+    OsFile_map(fh);
+  }
+#endif
+
   if (!parser().find_end_of_central_header()) {
     // The jar file is corrupted. Stop parsing it.
     parser().dispose();
@@ -475,9 +483,7 @@ bool JarFileParser::find_end_of_central_header() {
             raw_current_entry()->cenOffset = cenOffset;
             raw_current_entry()->nextCenOffset = cenOffset;
             raw_current_entry()->locOffset = locOffset;
-#if ENABLE_ROM_GENERATOR
             raw_current_entry()->totalEntryCount = ENDTOT(bp);
-#endif
           }
           return true; // Found central header
         }
@@ -518,6 +524,72 @@ bool JarFileParser::find_end_of_central_header() {
   } /* end of for loop */
 }
 
+#if USE_VERIFIER_CACHE
+bool JarFileParser::update_digest(Sha256& sha) {
+  enum { block_size = 1024 };
+  DECLARE_STATIC_BUFFER(unsigned char, buffer, block_size);
+  BufferedFile::Raw bf = buffered_file();
+
+  const juint length = (juint) bf().file_size();
+  juint offset = raw_current_entry()->cenOffset;
+  if (offset > length || bf().seek(offset, SEEK_SET) < 0) {
+    return false;
+  }
+
+  sha.update(&length, sizeof(length));
+  while (offset < length) {
+    size_t count = length - offset;
+    if (count > block_size) {
+      count = block_size;
+    }
+    if (bf().get_bytes(buffer, count) != count) {
+      return false;
+    }
+    sha.update(buffer, (juint)count);
+    offset += count;
+  }
+  return true;
+}
+#endif
+
+#if USE_CLASSPATH_NEGATIVE_CACHE
+bool JarFileParser::do_entry_names(entry_name_proc f, void* data) {
+  BufferedFile::Raw jar_buffer = buffered_file();
+  DECLARE_STATIC_BUFFER(unsigned char, name, MAX_ENTRY_NAME);
+  unsigned char cenp[CENHDRSIZ];
+
+  const juint total = raw_current_entry()->totalEntryCount;
+  juint offset = raw_current_entry()->cenOffset;
+
+  for (juint n=0; n<total; n++) {
+    if (jar_buffer().seek(offset, SEEK_SET) < 0 ||
+        jar_buffer().get_bytes(cenp, CENHDRSIZ) != CENHDRSIZ ||
+        GETSIG(cenp) != CENSIG) {
+      return false;
+    }
+
+    const juint name_len = (juint) CENNAM(cenp);
+    // Longer names can't be found by find_entry(), so they are skipped.
+    if (name_len <= MAX_ENTRY_NAME) {
+      if (jar_buffer().get_bytes(name, name_len) != name_len) {
+        return false;
+      }
+      f((const char*)name, (int)name_len, data);
+    }
+
+    offset += CENHDRSIZ + name_len + CENEXT(cenp) + CENCOM(cenp);
+  }
+
+  // Make sure that no entry has been left out.
+  if (jar_buffer().seek(offset, SEEK_SET) >= 0 &&
+      jar_buffer().get_bytes(cenp, 4) == 4 &&
+      GETSIG(cenp) == CENSIG) {
+    return false;
+  }
+  return true;
+}
+#endif
+
 #if USE_JAR_ENTRY_ENUMERATOR
 
 typedef struct {
@@ -943,6 +1015,11 @@ bool JarFileParser::remove_class_entries(FilePath *path JVM_TRAPS) {
   OsFile_Handle directory_file_handle = NULL;
   bool result = false;
 
+#if USE_CLASSPATH_NEGATIVE_CACHE
+  // The JAR file is rewritten, so its Bloom filter becomes stale.
+  ClassPathAccess::invalidate_cache();
+#endif
+
   path->string_copy(file_name, buffer_size - suffix_length);
 
   if (!OsFile_exists(file_name)) {
@@ -1146,6 +1223,145 @@ bool JarFileParser::add_current_entry_to_cache0(char * name, int name_len
   return true;
 }
 
+static juint entry_name_hash(const char *name, juint name_len) {
+  juint hash = 0;
+  for (juint i=0; i<name_len; i++) {
+    hash = 31 * hash + (juint)(unsigned char)name[i];
+  }
+  return hash;
+}
+
+// Returns true if the entry index is available for this JAR file, building
+// it if necessary. This function will never THROW
+bool JarFileParser::has_entry_index(JVM_SINGLE_ARG_TRAPS) {
+  if (entry_index() != NULL) {
+    return true;
+  }
+  if (entry_index_failed()) {
+    return false;
+  }
+
+  bool result = build_entry_index(JVM_SINGLE_ARG_NO_CHECK);
+  if (!result) {
+    if (CURRENT_HAS_PENDING_EXCEPTION) {
+      Thread::clear_current_pending_exception();
+    }
+    set_entry_index_failed(true);
+    if (TraceJarCache) {
+      TTY_TRACE_CR(("JAR: entry index not available"));
+    }
+  }
+  return result;
+}
+
+bool JarFileParser::build_entry_index(JVM_SINGLE_ARG_TRAPS) {
+  UsingFastOops fast_oops;
+  BufferedFile::Fast jar_buffer = buffered_file();
+  TypeArray::Fast index;
+
+  const juint total = raw_current_entry()->totalEntryCount;
+  if (total == 0 || total > (juint)MaxJarIndexEntryCount) {
+    return false;
+  }
+
+  // Keep the table at most 3/4 full, so that probe sequences stay short
+  // and every unsuccessful probe ends at an empty slot.
+  jint capacity = 4;
+  while ((juint)capacity * 3 < total * 4) {
+    capacity <<= 1;
+  }
+  const jint mask = capacity - 1;
+
+  index = Universe::new_int_array(capacity * 2 JVM_CHECK_0);
+
+  // No allocation below this point.
+  DECLARE_STATIC_BUFFER(unsigned char, name, MAX_ENTRY_NAME);
+  unsigned char cenp[CENHDRSIZ];
+  juint offset = raw_current_entry()->cenOffset;
+
+  for (juint n=0; n<total; n++) {
+    if (jar_buffer().seek(offset, SEEK_SET) < 0 ||
+        jar_buffer().get_bytes(cenp, CENHDRSIZ) != CENHDRSIZ ||
+        GETSIG(cenp) != CENSIG) {
+      return false;
+    }
+
+    const juint name_len = (juint) CENNAM(cenp);
+    // Names longer than MAX_ENTRY_NAME can't be found by find_entry()
+    // anyway, so they are left out of the index.
+    if (name_len <= MAX_ENTRY_NAME) {
+      if (jar_buffer().get_bytes(name, name_len) != name_len) {
+        return false;
+      }
+      const juint hash = entry_name_hash((char*)name, name_len);
+      jint i = (jint)(hash & mask);
+      while (index().int_at(2*i+1) != 0) {
+        i = (i + 1) & mask;
+      }
+      index().int_at_put(2*i,   (jint)hash);
+      index().int_at_put(2*i+1, (jint)(offset + 1));
+    }
+
+    offset += CENHDRSIZ + name_len + CENEXT(cenp) + CENCOM(cenp);
+  }
+
+  // The index must cover the whole central directory, otherwise it would
+  // report entries that do exist as missing.
+  if (jar_buffer().seek(offset, SEEK_SET) >= 0 &&
+      jar_buffer().get_bytes(cenp, 4) == 4 &&
+      GETSIG(cenp) == CENSIG) {
+    return false;
+  }
+
+  set_entry_index(&index);
+
+  if (TraceJarCache) {
+    TTY_TRACE_CR(("JAR: indexed %d entries in %d slots", total, capacity));
+  }
+  return true;
+}
+
+bool JarFileParser::find_entry_from_index(const char *match_name) {
+  TypeArray::Raw index = entry_index();
+  BufferedFile::Raw jar_buffer = buffered_file();
+  DECLARE_STATIC_BUFFER(unsigned char, found_name, MAX_ENTRY_NAME);
+
+  const juint match_name_len = (juint) jvm_strlen(match_name);
+  const juint hash = entry_name_hash(match_name, match_name_len);
+  const jint mask = index().length() / 2 - 1;
+
+  for (jint i = (jint)(hash & mask); ; i = (i + 1) & mask) {
+    const jint offset = index().int_at(2*i+1) - 1;
+    if (offset < 0) {
+      // Reached an empty slot: the entry is not in this JAR file.
+      return false;
+    }
+    if ((juint)index().int_at(2*i) != hash) {
+      continue;
+    }
+
+    unsigned char *cenp = raw_current_entry()->centralHeader;
+    if (jar_buffer().seek(offset, SEEK_SET) < 0 ||
+        jar_buffer().get_bytes(cenp, CENHDRSIZ) != CENHDRSIZ) {
+      return false;
+    }
+    if ((juint) CENNAM(cenp) != match_name_len) {
+      continue;
+    }
+    if (jar_buffer().get_bytes(found_name, match_name_len) != match_name_len) {
+      return false;
+    }
+    if (jvm_memcmp(found_name, match_name, match_name_len) == 0) {
+      raw_current_entry()->length = (int) CENLEN(cenp);
+
+      if (TraceJarCache) {
+        TTY_TRACE_CR(("JAR: entry index hit: %s", match_name));
+      }
+      return true;
+    }
+  }
+}
+
 #endif // ENABLE_JAR_ENTRY_CACHE
 
 ReturnOop JarFileParser::load_entry(JVM_SINGLE_ARG_TRAPS) {
@@ -1169,6 +1385,13 @@ bool JarFileParser::find_entry(const char *match_name JVM_TRAPS)
   BufferedFile::Fast jar_buffer = buffered_file();
   const bool use_entry_cache = CacheJarEntries && enable_entry_cache();
 
+#if ENABLE_JAR_ENTRY_CACHE
+  if (use_entry_cache && match_name != NULL && UseJarEntryIndex &&
+      has_entry_index(JVM_SINGLE_ARG_MUST_SUCCEED)) {
+    return find_entry_from_index(match_name);
+  }
+#endif
+
   if (use_entry_cache && match_name != NULL && 
       find_entry_from_cache(match_name)) {
     return true;
@@ -1402,10 +1625,18 @@ void JarFileParser::iterate(OopVisitor* visitor) {
     NamedField id("entry_cache", true);
     visitor->do_oop(&id, entry_cache_offset(), true);
   }
+  {
+    NamedField id("entry_index", true);
+    visitor->do_oop(&id, entry_index_offset(), true);
+  }
   { 
     NamedField id("entry_cache_count", true);
     visitor->do_int(&id, entry_cache_count_offset(), true);
   }
+  { 
+    NamedField id("entry_index_failed", true);
+    visitor->do_bool(&id, entry_index_failed_offset(), true);
+  }
 #endif
   { 
     NamedField id("timestamp", true);
@@ -1431,13 +1662,11 @@ void JarFileParser::iterate(OopVisitor* visitor) {
     visitor->do_int(&id, FIELD_OFFSET(JarFileParserDesc,
                                       _current_entry.length), true);
   }
-#if ENABLE_ROM_GENERATOR
   { 
     NamedField id("totalEntryCount", true);
     visitor->do_int(&id, FIELD_OFFSET(JarFileParserDesc,
                                       _current_entry.totalEntryCount), true);
   }
-#endif
   { 
     NamedField id("enable_entry_cache", true);
     visitor->do_int(&id, enable_entry_cache_offset(), true);
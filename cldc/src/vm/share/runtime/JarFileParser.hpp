@@ -84,6 +84,19 @@ class JarFileParserDesc : public MixedOopDesc {
    */
   OopDesc *         _entry_cache;
 
+  /**
+   * Hashed index of the JAR file's central directory, built in a single
+   * pass the first time an entry is looked up by name. This is an int
+   * TypeArray of open-addressed slots, each made of two ints:
+   *
+   *        [name hash][offset of central header + 1]
+   *
+   * An offset of 0 marks an empty slot. With the index in place a lookup
+   * costs one probe sequence plus a single seek to the matching central
+   * header, and a missing entry is rejected without touching the file.
+   */
+  TypeArrayDesc *   _entry_index;
+
 
   //
   // All non-oop fields must appear below here.
@@ -95,6 +108,13 @@ class JarFileParserDesc : public MixedOopDesc {
    * _entry_cache_count slots are in use.
    */
   int               _entry_cache_count;
+
+  /*
+   * Set when the entry index could not be built (too many entries,
+   * malformed central directory or out of memory), so that we don't
+   * try again on every lookup.
+   */
+  bool              _entry_index_failed;
 #endif
 
   int               _timestamp;
@@ -122,7 +142,7 @@ public:
   }
   static size_t pointer_count() {
 #if ENABLE_JAR_ENTRY_CACHE
-    return 4;
+    return 5;
 #else
     return 3;
 #endif
@@ -215,6 +235,27 @@ public:
   void set_entry_cache_count(int value) {
     int_field_put(entry_cache_count_offset(), value);
   }
+
+  static jint entry_index_offset() {
+    return FIELD_OFFSET(JarFileParserDesc, _entry_index);
+  }
+  static jint entry_index_failed_offset() {
+    return FIELD_OFFSET(JarFileParserDesc, _entry_index_failed);
+  }
+
+  ReturnOop entry_index() const {
+    return obj_field(entry_index_offset());
+  }
+  void set_entry_index(TypeArray *value) {
+    obj_field_put(entry_index_offset(), value);
+  }
+
+  bool entry_index_failed() const {
+    return bool_field(entry_index_failed_offset());
+  }
+  void set_entry_index_failed(bool value) {
+    bool_field_put(entry_index_failed_offset(), value);
+  }
 #endif
 
 private:
@@ -264,6 +305,22 @@ public:
 
   static void flush_caches();
 
+#if USE_VERIFIER_CACHE
+  // Adds the file length and the central directory to <sha>. This covers
+  // the name, size and CRC32 of every entry without reading the entries.
+  bool update_digest(Sha256& sha);
+#endif
+
+#if USE_CLASSPATH_NEGATIVE_CACHE
+  // Calls <f> with the name of every entry in the central directory.
+  // Returns false if the central directory can't be read completely.
+  typedef void (*entry_name_proc)(const char* name, int length, void* data);
+  bool do_entry_names(entry_name_proc f, void* data);
+  int total_entry_count() {
+    return (int)raw_current_entry()->totalEntryCount;
+  }
+#endif
+
 #if USE_JAR_ENTRY_ENUMERATOR
   typedef void (*do_entry_proc)(char* name, int length, JarFileParser *jf
                                 JVM_TRAPS);
@@ -319,6 +376,10 @@ public:
   bool find_entry_from_cache(const char *entryname);
   bool add_current_entry_to_cache(char * name, int name_len JVM_TRAPS);
   bool add_current_entry_to_cache0(char * name, int name_len JVM_TRAPS);
+
+  bool has_entry_index(JVM_SINGLE_ARG_TRAPS);
+  bool build_entry_index(JVM_SINGLE_ARG_TRAPS);
+  bool find_entry_from_index(const char *entryname);
 #else
   inline bool find_entry_from_cache(const char* /*entryname*/) {
     return false;
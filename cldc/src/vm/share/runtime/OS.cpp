@@ -100,6 +100,8 @@ bool DefaultStream::has_log_file() {
 static unsigned int __charcount;
 
 void DefaultStream::print_raw(const char* s) {
+  // Print what Java code has written to System.out so far first.
+  ConsoleOutput::flush();
   JVMSPI_PrintRaw(s);
 
   // print to log file
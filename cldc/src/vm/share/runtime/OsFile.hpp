@@ -53,6 +53,22 @@ int      OsFile_eof(OsFile_Handle handle);
 int      OsFile_remove(const JvmPathChar *filename);
 bool     OsFile_rename(const JvmPathChar *from, const JvmPathChar *to);
 
+#if USE_JAR_FILE_MAPPING
+/*
+ * Maps the whole file read-only into memory. The mapping remains valid
+ * until the file is closed with OsFile_close(). Returns false if the file
+ * cannot be mapped; the file can still be accessed with OsFile_read().
+ * The file must not be truncated while it is mapped.
+ */
+bool     OsFile_map(OsFile_Handle handle);
+
+/*
+ * Returns the start address of the mapping created by OsFile_map() and
+ * stores its length in *length, or returns NULL if <handle> is not mapped.
+ */
+address  OsFile_mapped_address(OsFile_Handle handle, long *length);
+#endif
+
 #if USE_IMAGE_MAPPING
 
 struct OsFile_MappedImage {
@@ -50,6 +50,23 @@ void OsMisc_page_unprotect();
 
 void OsMisc_hardware_power_reset();
 
+#if ENABLE_PERF_MAP
+// Used for naming the /tmp/perf-<pid>.map file. Returns -1 if the port
+// has no process id the perf tool would know, in which case the map is
+// not written.
+int OsMisc_get_process_id();
+#endif
+
+#if USE_VERIFIER_CACHE
+// Fills <key> with a secret that authenticates the verifier cache file
+// <cache_file>. The secret must be created on first use and must not be
+// readable or writable by anyone who can't already change the classpath.
+// Returns false if no such secret is available, and the verifier cache
+// is then not used.
+bool OsMisc_get_verifier_cache_key(const JvmPathChar* cache_file,
+                                   unsigned char* key, int key_length);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
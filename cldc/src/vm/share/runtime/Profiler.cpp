@@ -122,6 +122,7 @@ class ProfilerNode {
   }
   virtual bool match(int id) { (void)id; return true; }
   virtual void print_title_on(Stream* out) JVM_PURE_VIRTUAL_1_PARAM(out);
+  virtual void print_hot_method_on(Stream* out) { (void)out; }
   virtual void oops_do(void do_oop(OopDesc**)) JVM_PURE_VIRTUAL_1_PARAM(do_oop);
 
   int total_ticks() {
@@ -170,6 +171,24 @@ class MethodNode : public ProfilerNode {
     name().print_symbol_on(out);
 #endif
   }
+  virtual void print_hot_method_on(Stream* out) {
+    UsingFastOops fast_oops;
+    Method::Fast m = _method;
+    InstanceClass::Fast ic = m().holder();
+    Symbol::Fast class_name = ic().name();
+    Symbol::Fast name = m().name();
+
+    if (class_name.equals(Symbols::unknown()) ||
+        name.equals(Symbols::unknown())) {
+      // Renamed by the romizer, can't be matched by the next romization
+      return;
+    }
+    out->print("HotMethod = ");
+    class_name().print_symbol_on(out, true);
+    out->print(".");
+    name().print_symbol_on(out);
+    out->cr();
+  }
   virtual void oops_do(void do_oop(OopDesc**)) {
     do_oop((OopDesc**) &_method);
   }
@@ -295,6 +314,7 @@ public:
   void clear(int id);
 
   void print(Stream* out, int id);
+  void print_hot_methods(Stream* out, int id);
 
   ProfilerNode** flatten_and_sort(int id, int* size, ProfilerNode* sum_node);
 };
@@ -392,6 +412,31 @@ void FlatProfiler::print(Stream* out, int id) {
   }
 }
 
+// Print the profiled methods, hottest first, in the format of the ROM
+// configuration file. The romizer clusters these methods in ROM.
+void FlatProfiler::print_hot_methods(Stream* out, int id) {
+#if ENABLE_ISOLATES
+  TaskContext maybeSwitchTask;
+#endif
+
+  int size;
+  SumNode local_sum(id);
+  ProfilerNode** flat_table = flatten_and_sort(id, &size, &local_sum);
+
+  out->print_cr("# Generated by +ProfilerPrintHotMethods");
+  for (int index = 0; index < size; index++) {
+    ProfilerNode* node = flat_table[index];
+#if ENABLE_ISOLATES      
+    if (id == -1 && node->task_id > 0) {
+      Universe::set_current_task(node->task_id);
+    }
+#endif
+    node->print_hot_method_on(out);
+  }
+
+  FREE_GLOBAL_HEAP_ARRAY(flat_table, "flat table"); 
+}
+
 void* ProfilerNode::operator new(size_t size){
   return (ProfilerNode*)GlobalObj::malloc_bytes(size);
 }
@@ -484,6 +529,17 @@ void Profiler::dump_and_clear_profile_data(int id) {
   if (profiler != NULL) {
     profiler->disengage();
     profiler->print(get_default_output_stream(), id);
+    if (ProfilerPrintHotMethods && id < 0) {
+      static JvmPathChar filename[] = {
+        'h','o','t','.','c','f','g',0
+      };
+#if defined(GBA)
+      profiler->print_hot_methods(tty, id);
+#else
+      FileStream hot_methods_output(filename, 200);
+      profiler->print_hot_methods(&hot_methods_output, id);
+#endif
+    }
     if (id < 0) {
       dispose();
     } else {
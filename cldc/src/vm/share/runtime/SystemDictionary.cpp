@@ -33,19 +33,12 @@ char SystemDictionary::_last_class_loaded[LAST_CLASS_LOADED_BUF_SIZE];
 #endif
 
 ReturnOop SystemDictionary::bucket_for(ObjArray *sd, juint hash_value) {
-  juint len = (juint)sd->length();
-  juint index;
-  if (len == 64) {
-    index = hash_value & (64 - 1);
-  } else {
-    index = hash_value % len;
-  }
-  return sd->obj_at(index);
+  return sd->obj_at(bucket_index(sd, hash_value));
 }
 
 void SystemDictionary::set_bucket_for(ObjArray *sd, juint hash_value,
                                       InstanceClass* bucket) {
-  sd->obj_at_put(hash_value % sd->length(), bucket);
+  sd->obj_at_put(bucket_index(sd, hash_value), bucket);
 }
 
 // lookup_only -- only search loaded classes, don't try to load
@@ -308,6 +301,14 @@ void SystemDictionary::insert(LoaderContext *loader_ctx,
   instance_class->set_next(&next);
   set_bucket_for(&dictionary, hash_value, instance_class);
 
+  int chain_length = 1;
+  for (; next.not_null(); next = next().next()) {
+    chain_length ++;
+  }
+  if (chain_length >= long_chain_length) {
+    grow(&dictionary);
+  }
+
 #ifdef AZZERT
   if (loader_ctx != NULL) {
     InstanceClass::Raw result = find(loader_ctx JVM_CHECK);
@@ -316,6 +317,114 @@ void SystemDictionary::insert(LoaderContext *loader_ctx,
 #endif
 }
 
+// Rehash all classes into a dictionary with twice as many buckets, if the
+// dictionary holds more than max_load_factor classes per bucket. Failure
+// to grow is not an error: the classes stay in the old dictionary.
+void SystemDictionary::grow(ObjArray *dictionary) {
+  const int old_length = dictionary->length();
+  if (old_length >= max_dictionary_length ||
+      !ObjectHeap::contains_moveable(dictionary->obj())) {
+    return;
+  }
+
+  int count = 0;
+  int i;
+  for (i = 0; i < old_length; i++) {
+    for (InstanceClass::Raw cl = dictionary->obj_at(i); cl.not_null();
+         cl = cl().next()) {
+      if (!ObjectHeap::contains_moveable(cl.obj())) {
+        // Classes from a binary image can't be relinked.
+        return;
+      }
+      count ++;
+    }
+  }
+  if (count <= old_length * max_load_factor) {
+    return;
+  }
+
+  SETUP_ERROR_CHECKER_ARG;
+  UsingFastOops fast_oops;
+  ObjArray::Fast new_dictionary =
+      Universe::new_obj_array(old_length * 2 JVM_NO_CHECK);
+  if (new_dictionary.is_null()) {
+    Thread::clear_current_pending_exception();
+    return;
+  }
+
+  // No allocation below this point.
+  for (i = 0; i < old_length; i++) {
+    InstanceClass::Raw cl = dictionary->obj_at(i);
+    while (cl.not_null()) {
+      InstanceClass::Raw next = cl().next();
+      Symbol::Raw name = cl().name();
+      const juint hash_value = name().hash();
+      InstanceClass::Raw head = bucket_for(&new_dictionary, hash_value);
+      cl().set_next(&head);
+      set_bucket_for(&new_dictionary, hash_value, &cl);
+      cl = next;
+    }
+    dictionary->obj_at_clear(i);
+  }
+
+  if (Universe::system_dictionary()->equals(dictionary)) {
+    *Universe::system_dictionary() = new_dictionary.obj();
+  }
+  *Universe::current_dictionary() = new_dictionary.obj();
+#if ENABLE_ISOLATES
+  Task::current()->set_dictionary(new_dictionary.obj());
+#endif
+  dictionary->set_obj(new_dictionary.obj());
+
+  if (Verbose) {
+    TTY_TRACE_CR(("Expanding system dictionary to %d buckets for %d classes",
+                  old_length * 2, count));
+  }
+}
+
+void SystemDictionary::print_statistics(Stream* st) {
+  print_dictionary_statistics(st, "system dictionary",
+                              Universe::system_dictionary()->obj());
+  if (!Universe::current_dictionary()->equals(
+                                       Universe::system_dictionary())) {
+    print_dictionary_statistics(st, "current dictionary",
+                                Universe::current_dictionary()->obj());
+  }
+}
+
+void SystemDictionary::print_dictionary_statistics(Stream* st,
+                                                   const char* name,
+                                                   OopDesc* dictionary) {
+  if (dictionary == NULL) {
+    return;
+  }
+  ObjArray::Raw sd = dictionary;
+  const int length = sd().length();
+  int count = 0;
+  int used = 0;
+  int max_chain = 0;
+  for (int i = 0; i < length; i++) {
+    int chain = 0;
+    for (InstanceClass::Raw cl = sd().obj_at(i); cl.not_null();
+         cl = cl().next()) {
+      chain ++;
+    }
+    if (chain > 0) {
+      used ++;
+    }
+    if (chain > max_chain) {
+      max_chain = chain;
+    }
+    count += chain;
+  }
+
+  // Average chain length of the used buckets, in hundredths.
+  const int avg = (used == 0) ? 0 : (count * 100 / used);
+  st->print_cr("%s: %d buckets, %d classes, %d used buckets, "
+               "chain length avg %d.%02d max %d", name, length, count, used,
+               avg / 100, avg % 100, max_chain);
+}
+
 void SystemDictionary::update_fake_class(InstanceClass *real_cls, 
                                          InstanceClass *fake_cls JVM_TRAPS)
 {
@@ -126,12 +126,38 @@ class SystemDictionary : public AllStatic {
 #ifndef PRODUCT
   static char _last_class_loaded[];
 #endif
+
+  // Prints the number of buckets and classes, and the chain lengths of
+  // the system and the current dictionary.
+  static void print_statistics(Stream* st);
+
  private:
+  enum {
+    // A chain of this many classes makes insert() check the load of
+    // the whole dictionary.
+    long_chain_length = 8,
+    // The dictionary is doubled in size when it contains more than
+    // max_load_factor classes per bucket.
+    max_load_factor = 2,
+    max_dictionary_length = 4096
+  };
+
   static ReturnOop load_system_class(LoaderContext *loader_ctx JVM_TRAPS);
 
   static ReturnOop fetch_buffer(LoaderContext *loader_ctx JVM_TRAPS);
 
+  static juint bucket_index(ObjArray *sd, juint hash_value) {
+    const juint len = (juint)sd->length();
+    if (is_power_of_2(len)) {
+      return hash_value & (len - 1);
+    } else {
+      return hash_value % len;
+    }
+  }
   static ReturnOop bucket_for(ObjArray *sd, juint hash_value);
+  static void grow(ObjArray *dictionary);
+  static void print_dictionary_statistics(Stream* st, const char* name,
+                                          OopDesc* dictionary);
   static void set_bucket_for(ObjArray *sd, juint hash_value, InstanceClass* bucket);
   static void set_bucket_for(ObjArray *sd, juint hash_value, ObjArrayClass* bucket);
   static ReturnOop create_fake_class(LoaderContext *loader_ctx JVM_TRAPS);
@@ -90,6 +90,11 @@ void TaskGCContext::init(const OopDesc* object) {
 void TaskGCContext::set(const int task_id) {
   Task::Raw task = Universe::task_from_id(task_id);
   if( task.not_null() ) {
+    if (task_id != _global_current_task_id) {
+      // Native finalizers run in this context and may check subtypes
+      // with the class ids of <task_id>.
+      JavaClass::flush_subtype_check_cache();
+    }
     _global_current_task_id = task_id;
     _global_number_of_java_classes = task().class_count();
     _class_list_base =((address)task().class_list() ) + ObjArray::base_offset();
@@ -135,6 +140,7 @@ void TaskGCContextDebug::init(int class_id, int tag) {
         }
         _class_list_base = (address)task().class_list();
         _class_list_base += ObjArray::base_offset();
+        JavaClass::flush_subtype_check_cache();
         if (TraceGC) {
           //          tty->print("new: 0x%x,", (int)_class_list_base);
         }
@@ -160,6 +166,7 @@ void TaskGCContextDebug::dispose() {
         //        tty->print_cr("new: 0x%x, ", (int)_class_list_base);
       }
       _global_number_of_java_classes = task().class_count();
+      JavaClass::flush_subtype_check_cache();
     }
   }
 }
@@ -185,6 +192,8 @@ void TaskContext::set_current_task(int task_id) {
     _global_number_of_java_classes = task().class_count();
     _current_task = task.obj();
     _global_current_task_id = task_id;
+    // Class ids of the new task denote different classes
+    JavaClass::flush_subtype_check_cache();
 #if USE_BINARY_IMAGE_LOADER
     ROM::on_task_switch(task_id);
 #endif
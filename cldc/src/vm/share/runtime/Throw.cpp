@@ -76,8 +76,7 @@ Throw::new_exception(Symbol* class_name, String* message JVM_TRAPS) {
     } else {
       UsingFastOops raw_internal2;
       LiteralStream s2(": ", 0, jvm_strlen(": "));
-      TypeArray::Fast message_char_array = message->value();
-      CharStream s3(&message_char_array);
+      StringStream s3(message);
       ConcatenatedStream c2(&s1, &s2);
       ConcatenatedStream c3(&c2, &s3);
       err_message = Universe::new_string(&c3 JVM_CHECK_0);
@@ -386,11 +385,8 @@ ReturnOop Throw::add_message_prefix(char *prefix, String *message JVM_TRAPS) {
   if (message->not_null()) {
     *ptr ++ = (jchar)':';
     *ptr ++ = (jchar)' ';
-    TypeArray::Raw v = message->value();
-    jchar *msgptr = ((jchar*)v().base_address()) + message->offset();
-    for (int i=0; i<msglen; i++) {
-      *ptr ++ = *msgptr++;
-    }
+    message->get_chars(ptr, 0, msglen);
+    ptr += msglen;
   }
   GUARANTEE(ptr == (jchar*)char_array().base_address() + len, "sanity");
   String::Fast str = Universe::new_string(&char_array, 0, len JVM_NO_CHECK);
@@ -515,6 +515,21 @@ typedef struct _JVM_PerformanceCounters {
   jlong total_verify_hrticks;  /* Total number of hrticks in verification */
   jlong max_verify_hrticks;    /* Number of hrticks spent in the longest
                                 * verification. */
+  int num_of_verify_cache_hits;/* Number of classes that were not verified
+                                * because -verifiercache recorded them as
+                                * verified */
+  jlong saved_verify_hrticks;  /* Number of hrticks it took to verify these
+                                * classes when they were recorded */
+
+  int num_of_classpath_probes; /* Number of classpath elements searched
+                                * for a class or resource */
+  int num_of_classpath_cache_hits;
+                               /* Number of these searches that the
+                                * negative lookup cache answered without
+                                * touching the file system */
+  int num_of_classpath_false_positives;
+                               /* Number of searches of a JAR file whose
+                                * Bloom filter wrongly reported a match */
 
   /*----------------------------------------------------------------------
    * Romization
@@ -556,6 +571,21 @@ typedef struct _JVM_PerformanceCounters {
                                 * compiler */
   int uncommon_traps_taken;    /* Number of uncommon traps taken during
                                 * execution of compiled code */
+  int escape_analysis_sites;   /* Number of allocation sites examined by the
+                                * compiler's escape analysis */
+  int escape_analysis_eliminated;
+                               /* Number of allocation sites whose object
+                                * was scalar-replaced by the compiler */
+  int compiled_method_evictions;/* Number of compiled methods evicted from
+                                * the compiler area */
+  int compiled_method_evicted_bytes;
+                               /* Total size of the evicted compiled
+                                * methods */
+  int compiled_method_recompilations;
+                               /* Number of compilations of methods whose
+                                * compiled code had been evicted */
+  int compiled_method_pins;    /* Number of methods pinned in the compiler
+                                * area after repeated recompilation */
 
 
   /*----------------------------------------------------------------------
@@ -148,6 +148,10 @@ void JVMSPI_DisplayUsage(char* message) {
   P("    -convert    : Create binary rom image of application classes");
   P("    -romoutputfile");
   P("                : Output filename for binary rom image");
+#if USE_BINARY_IMAGE_GENERATOR
+  P("    -romconfig <file>");
+  P("                : InitAtBuild classes to initialize during -convert");
+#endif
 #endif
 
 #if USE_DEBUG_PRINTING
@@ -42,6 +42,8 @@
  * -verbose             Enable verbose output
  * -int                 Execute code in pure interpreter mode (no compilation)
  * -comp                Execute code in pure compiler mode (no interpretation)
+ * -verifiercache <file> Skip verifying classes recorded in <file> by an
+ *                      earlier run, and record newly verified classes there
  *
  * In addition, the VM provides a large number
  * of development-time options for turning on various
@@ -76,6 +78,10 @@ int                        Arguments::_monitor_memory;
 Arguments::Path            Arguments::_generator_output_dir;
 #endif
 
+#if USE_VERIFIER_CACHE
+Arguments::Path            Arguments::_verifier_cache_file;
+#endif
+
 #if ENABLE_ROM_GENERATOR
 Arguments::Path            Arguments::_rom_config_file;
 Arguments::Path            Arguments::_rom_output_file;
@@ -136,6 +142,12 @@ int Arguments::parse_one_arg(int argc, char** argv) {
     MixedMode = false;
     UseCompiler = true;
   }
+#if USE_VERIFIER_CACHE
+  else if (jvm_strcmp(argv[0], "-verifiercache") == 0 && argc >= 2) {
+    set_pathname_from_const_ascii(&_verifier_cache_file, argv[1]);
+    count = 2;
+  }
+#endif
   else if ((*argv[0] == '-') && (*(argv[0]+1) == 'D')) {
     char *key;
     char *value;
@@ -177,11 +189,12 @@ int Arguments::parse_one_arg(int argc, char** argv) {
 
 #if ENABLE_ROM_GENERATOR
 
-#if USE_SOURCE_IMAGE_GENERATOR
   else if (jvm_strcmp(argv[0], "-romconfig") == 0) {
     set_pathname_from_const_ascii(&_rom_config_file, argv[1]);
     count = 2;
   }
+
+#if USE_SOURCE_IMAGE_GENERATOR
   else if (jvm_strcmp(argv[0], "-romincludepath") == 0) {
     ROMIncludePath *ptr =
       (ROMIncludePath*)OsMemory_allocate(sizeof(ROMIncludePath));
@@ -568,6 +581,10 @@ void Arguments::finalize() {
   free_pathname(&_generator_output_dir);
 #endif
 
+#if USE_VERIFIER_CACHE
+  free_pathname(&_verifier_cache_file);
+#endif
+
 #if ENABLE_ROM_GENERATOR
   free_pathname(&_rom_config_file);
   free_pathname(&_rom_output_file);
@@ -80,6 +80,10 @@ private:
   static Path             _generator_output_dir;
 #endif
 
+#if USE_VERIFIER_CACHE
+  static Path             _verifier_cache_file;
+#endif
+
 public:
 
 #if ENABLE_JAVA_DEBUGGER
@@ -111,6 +115,10 @@ public:
     _generator_output_dir._path = NULL;
 #endif
 
+#if USE_VERIFIER_CACHE
+    _verifier_cache_file._path = NULL;
+#endif
+
 #ifndef PRODUCT
     _compiler_test_config_file._path = NULL;
 #endif
@@ -221,6 +229,12 @@ public:
     return _classpath._path;
   }
 
+#if USE_VERIFIER_CACHE
+  static const JvmPathChar* verifier_cache_file() {
+    return _verifier_cache_file._path;
+  }
+#endif
+
 #if USE_BINARY_IMAGE_GENERATOR
   static const JvmPathChar* rom_input_file() {
     return _rom_input_file._path;
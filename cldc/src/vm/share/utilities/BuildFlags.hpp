@@ -169,6 +169,11 @@
 //                                    code instead of the generated assembler
 //                                    interpreter.
 //
+// ENABLE_CLASSPATH_NEGATIVE_CACHE 1,1 Remember the classpath elements
+//                                    that don't contain a class or
+//                                    resource, so that repeated lookups
+//                                    of missing entries don't open files.
+//
 // ENABLE_CLDC_11                1,1  Support CLDC 1.1 Specification instead
 //                                    of CLDC 1.0.
 //
@@ -200,6 +205,11 @@
 // ENABLE_FAST_CRC32             1,1  Use fast CRC32 routine? Adds 1KB
 //                                    footprint.
 //
+// ENABLE_FAST_CRC32_SLICING     1,1  Compute CRC32 eight bytes at a time
+//                                    (slicing-by-8) when ENABLE_FAST_CRC32
+//                                    is also set. Adds 7KB of static data
+//                                    that is initialized on first use.
+//
 // ENABLE_FAST_MEM_ROUTINES      1,1  Use built-in memcmp and memcpy routines
 //                                    in the generated interpreter loop.
 //
@@ -218,6 +228,11 @@
 //
 // ENABLE_FLOAT                  1,1  Support floating point byte codes.
 //
+// ENABLE_HOSTED_LIBM            0,0  Implement java.lang.Math with the
+//                                    C library (and so the FPU) instead
+//                                    of the software routines in
+//                                    src/vm/share/float.
+//
 //
 // ENABLE_INCREASING_JAVA_STACK  0,0  If true, the Java stack grows
 //                                    upwards. E.g., when an item is
@@ -325,6 +340,14 @@
 // ENABLE_PCSL                   0,0  Enable support for the Portable Common
 //                                    Services Library.
 //
+// ENABLE_PERF_MAP               0,0  Add the +UsePerfMap option for writing
+//                                    the location of compiled methods to
+//                                    /tmp/perf-<pid>.map, so that the
+//                                    Linux perf tool can attribute samples
+//                                    to Java methods. Only the linux OS
+//                                    port writes the map; the others
+//                                    have no process id for it.
+//
 // ENABLE_PERFORMANCE_COUNTERS   1,0  Enable coarse-grain performance counters.
 //                                    for methods compiled, memory allocated,
 //                                    etc. These counters usually do not
@@ -413,6 +436,12 @@
 // ENABLE_VERBOSE_ASSERTION      1,0  Print detailed error messages
 //                                    when a run-time assertion fails.
 //
+// ENABLE_VERIFIER_CACHE         1,1  Add the -verifiercache <file> option,
+//                                    which records classes that passed
+//                                    verification and skips verifying them
+//                                    again in later runs with the same VM,
+//                                    ROM image and classpath.
+//
 // ENABLE_VERIFY_ONLY            1,1  Add support for using the VM as a tool
 //                                    for classpath verification
 //                                    without any byte code execution.
@@ -674,6 +703,12 @@
 #error "ENABLE_ROM_GENERATOR must be enabled to support ENABLE_MONET"
 #endif
 
+#if ENABLE_PERF_MAP && !ENABLE_COMPILER
+// The perf map only describes compiled code
+#undef  ENABLE_PERF_MAP
+#define ENABLE_PERF_MAP 0
+#endif
+
 #if ENABLE_MONET_COMPILATION && (!ENABLE_MONET || !ENABLE_COMPILER)
 // ENABLE_MONET_COMPILATION makes no sense if Monet or compiler is not enabled
 #undef ENABLE_MONET_COMPILATION
@@ -1031,6 +1066,41 @@
 #  endif
 #endif
 
+// USE_JAR_FILE_MAPPING               Map JAR files read-only using an
+//                                    OS-specific file mapping API (such as
+//                                    mmap() on Linux), so that STORED
+//                                    entries are copied straight out of
+//                                    the mapping instead of going through
+//                                    seek() and read() calls.
+
+#if SUPPORTS_MEMORY_MAPPED_FILES && ENABLE_MEMORY_MAPPED_FILES && !ENABLE_PCSL
+#  define USE_JAR_FILE_MAPPING 1
+#else
+#  define USE_JAR_FILE_MAPPING 0
+#endif
+
+// USE_VERIFIER_CACHE                 Include the persistent verification
+//                                    cache. It is keyed by the classpath
+//                                    of the running task, so it's not
+//                                    available with ENABLE_ISOLATES.
+
+#if ENABLE_VERIFIER_CACHE && !ENABLE_ISOLATES
+#  define USE_VERIFIER_CACHE 1
+#else
+#  define USE_VERIFIER_CACHE 0
+#endif
+
+// USE_CLASSPATH_NEGATIVE_CACHE       Include the negative lookup cache of
+//                                    ClassPathAccess. It is bound to the
+//                                    classpath of a single task, so it's
+//                                    not available with ENABLE_ISOLATES.
+
+#if ENABLE_CLASSPATH_NEGATIVE_CACHE && !ENABLE_ISOLATES
+#  define USE_CLASSPATH_NEGATIVE_CACHE 1
+#else
+#  define USE_CLASSPATH_NEGATIVE_CACHE 0
+#endif
+
 // USE_DEBUG_PRINTING                 Include code to print various internal
 //                                    data structures and symbolic definitions
 //                                    in the VM. This feature can be turned off
@@ -200,6 +200,15 @@ int UnicodeStream::utf8_length() {
   }
   return result;
 }
+
+StringStream::StringStream(String* string)
+    : UnicodeStream(0, string->length()) {
+  _string = string;
+}
+
+jchar StringStream::char_at(int index) {
+  return _string->char_at(index);
+}
 #endif
 
 #ifndef PRODUCT
@@ -244,6 +244,16 @@ class CharStream : public UnicodeStream {
   TypeArray* _array;
 };
 
+// Reads the characters of a java.lang.String, whichever body it uses.
+class StringStream : public UnicodeStream {
+ public:
+  StringStream(String* string);
+  virtual jchar char_at(int index);
+
+ private:
+  String* _string;
+};
+
 #endif
 
 #ifndef PRODUCT
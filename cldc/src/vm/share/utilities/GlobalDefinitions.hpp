@@ -1660,6 +1660,7 @@ typedef class OopDesc* ReturnOop;
  template(verification_error,      "Verification error") \
  template(binary_file_error,       "BinaryFileStream output error") \
  template(romizer_not_supported,   "Romizer not supported in this VM build") \
+ template(rom_config_file_error,   "Cannot read ROM configuration file") \
  template(unsatisfied_link_error,  "Failed to load shared library. " \
                                    "Make sure dynamic loading is enabled, " \
                                    "and library exists") \
@@ -265,6 +265,15 @@ private:
   develop(bool, UseVSFMergeOptimization, true,                              \
           "Use optimized VSF merge implementation")                         \
                                                                             \
+  product(bool, UseEscapeAnalysis, false,                                   \
+          "Do not allocate objects that never escape the compiled method "  \
+          "and whose fields are never read. Experimental: objects whose "   \
+          "fields are read are not scalar-replaced")                        \
+                                                                            \
+  product(bool, PresizeStringConcat, true,                                  \
+          "Allocate StringBuffers of string concatenations with the "       \
+          "estimated length of the result")                                 \
+                                                                            \
   develop(bool, GenerateCompilerAssertions, COMPILER_ASSERTION_DEFAULT,     \
           "Generate assertion in compiled code (DEBUG mode only)")          \
                                                                             \
@@ -295,6 +304,10 @@ private:
   product(bool, UseVerifier, true,                                          \
           "Should class file verification be performed?")                   \
                                                                             \
+  product(bool, LazyStackmapParsing, true,                                  \
+          "Keep the raw StackMap attributes of a class until it is "        \
+          "verified, instead of parsing them when the class is loaded")     \
+                                                                            \
   product(bool, VerifyOnly, false,                                          \
           "Verify all jar/zip files in the classpath, then exit")           \
                                                                             \
@@ -310,6 +323,17 @@ private:
   product(bool, LogVMOutput, false,                                         \
           "Log VM output on file cldc_vm.log")                              \
                                                                             \
+  product(int, ConsoleBufferSize, 256,                                      \
+          "Number of bytes written to System.out that are collected "       \
+          "before they are printed (0 = print every byte, at most 1024)")   \
+                                                                            \
+  product(bool, ConsoleLineBuffered, true,                                  \
+          "Print the bytes written to System.out at the end of every line") \
+                                                                            \
+  product(bool, PrintHashTableStatistics, false,                            \
+          "Print the load and the chain and probe lengths of the symbol "   \
+          "table and the system dictionary when the VM exits")              \
+                                                                            \
   product(int, CachedAsyncDataSize, 8,                                      \
           "Precreated buffer size for SNI_AllocateReentryData")             \
                                                                             \
@@ -328,6 +352,13 @@ private:
   develop(int, MaxJarCacheEntryCount, 256,                                  \
           "The maximum number of entries cached for a Jar file")            \
                                                                             \
+  develop(bool, UseJarEntryIndex, ENABLE_JAR_ENTRY_CACHE,                   \
+          "Look up Jar entries by name through a hashed index of the "      \
+          "central directory, when built with ENABLE_JAR_ENTRY_CACHE=true") \
+                                                                            \
+  develop(int, MaxJarIndexEntryCount, 8192,                                 \
+          "Jar files with more entries than this are not indexed")          \
+                                                                            \
   develop(bool, PrintAllObjects, false,                                     \
           "Print all object by iterating over the object heap")             \
                                                                             \
@@ -373,6 +404,15 @@ private:
           "to compile (in milliseconds.) MaxCompilationTime can be "        \
           "by reimplementing Os::check_compiler_timer()")                   \
                                                                             \
+  product(int, CompiledMethodPinThreshold, 3,                               \
+          "Number of times a method can be evicted from the compiler area " \
+          "and compiled again before its code is kept (pinned) while the "  \
+          "method is still executed. 0 disables pinning")                   \
+                                                                            \
+  product(bool, PrintCompiledMethodCacheStatistics, false,                  \
+          "Print compilation, eviction and recompilation counts of the "    \
+          "compiled methods (at VM exit)")                                  \
+                                                                            \
   product(int, InterpretationLogSize, INTERP_LOG_SIZE,                      \
           "How many elements of _interpretation_log[] to examine during "   \
           "timer tick -- set to 0 to disable interpretation log")           \
@@ -431,15 +471,87 @@ private:
 #define JVMPI_PROFILE_VERIFY_RUNTIME_FLAGS(develop, product)
 #endif
 
+#if USE_JAR_FILE_MAPPING
+#define JAR_FILE_MAPPING_RUNTIME_FLAGS(develop, product)                    \
+  product(bool, UseMappedJarFiles, false,                                   \
+          "Map JAR files into memory and copy STORED entries from the "     \
+          "mapping instead of reading them. Only safe if the JAR files "    \
+          "are never truncated or rewritten while the VM runs: touching "   \
+          "a page past the new end of file raises SIGBUS")
+#else
+#define JAR_FILE_MAPPING_RUNTIME_FLAGS(develop, product)
+#endif
+
+#if USE_VERIFIER_CACHE
+#define VERIFIER_CACHE_RUNTIME_FLAGS(develop, product)                      \
+  product(bool, UseVerifierCache, true,                                     \
+          "Skip the verification of classes that are recorded in the "      \
+          "-verifiercache file as verified by an earlier run. The file "    \
+          "is authenticated with a per-device key, which only the linux "   \
+          "port provides; on other ports (including javacall) the cache "   \
+          "is not used")                                                    \
+                                                                            \
+  product(int, MaxVerifierCacheEntries, 4096,                               \
+          "Maximum number of classes recorded in the verification cache")   \
+                                                                            \
+  develop(bool, RunSha256Tests, false,                                      \
+          "Run the SHA-256 and HMAC-SHA256 known-answer tests and exit")
+#else
+#define VERIFIER_CACHE_RUNTIME_FLAGS(develop, product)
+#endif
+
+#if USE_CLASSPATH_NEGATIVE_CACHE
+#define CLASSPATH_NEGATIVE_CACHE_RUNTIME_FLAGS(develop, product)            \
+  product(bool, UseClassPathNegativeCache, true,                            \
+          "Remember which classpath elements don't contain an entry, so "   \
+          "that looking it up again doesn't touch the file system")         \
+                                                                            \
+  product(int, ClassPathBloomBitsPerEntry, 10,                              \
+          "Size of the Bloom filter built for each JAR file on the "        \
+          "classpath, in bits per JAR entry")                               \
+                                                                            \
+  product(int, ClassPathMissCacheSize, 256,                                 \
+          "Number of recent misses remembered for the directories on "      \
+          "the classpath")
+#else
+#define CLASSPATH_NEGATIVE_CACHE_RUNTIME_FLAGS(develop, product)
+#endif
+
+#if ENABLE_HOSTED_LIBM && ENABLE_FLOAT
+#define HOSTED_LIBM_RUNTIME_FLAGS(develop, product)                         \
+  product(bool, UseHostedLibmTranscendentals, false,                        \
+          "Use the C library for Math.sin, cos, tan, asin, acos, atan "     \
+          "and atan2 (only for ENABLE_HOSTED_LIBM). Only turn this on "     \
+          "for a C library whose results are known to be within 1 ulp")
+#else
+#define HOSTED_LIBM_RUNTIME_FLAGS(develop, product)
+#endif
+
+#if ENABLE_PERF_MAP && ENABLE_COMPILER
+#define PERF_MAP_RUNTIME_FLAGS(develop, product)                            \
+  product(bool, UsePerfMap, false,                                          \
+         "Write the location of compiled methods to /tmp/perf-<pid>.map")
+#else
+#define PERF_MAP_RUNTIME_FLAGS(develop, product)
+#endif
+
 // If ENABLE_PROFILER, support +UseProfiler also for product build
 #if ENABLE_PROFILER
 #define PROFILER_RUNTIME_FLAGS(develop, product)                            \
   product(bool, UseProfiler, false,                                         \
-          "Use execution time profiler")
+          "Use execution time profiler")                                    \
+                                                                            \
+  product(bool, ProfilerPrintHotMethods, false,                             \
+          "Write the profiled methods to hot.cfg as HotMethod entries "     \
+          "for the ROM configuration file")
 #else
 #define PROFILER_RUNTIME_FLAGS(develop, product)                            \
   develop(bool, UseProfiler, false,                                         \
-          "Use execution time profiler")
+          "Use execution time profiler")                                    \
+                                                                            \
+  develop(bool, ProfilerPrintHotMethods, false,                             \
+          "Write the profiled methods to hot.cfg as HotMethod entries "     \
+          "for the ROM configuration file")
 #endif
 
 #ifndef USE_EVENT_LOGGER
@@ -561,6 +673,9 @@ private:
        op(bool, TraceMethodInlining, false,                                 \
           "Trace method inlining (only for ENABLE_INLINE)")                 \
                                                                             \
+       op(bool, TraceEscapeAnalysis, false,                                 \
+          "Trace allocations eliminated by the compiler's escape analysis") \
+                                                                            \
        op(bool, TraceNativeCalls, false,                                    \
           "Trace native method calls")                                      \
                                                                             \
@@ -582,6 +697,9 @@ private:
        op(bool, TraceVerifier, false,                                       \
           "Trace class file verification")                                  \
                                                                             \
+       op(bool, TraceVerifierCache, false,                                  \
+          "Trace hits, misses and updates of the verification cache")       \
+                                                                            \
        op(bool, TraceStackmaps, false,                                      \
           "Trace stack map generation")                                     \
                                                                             \
@@ -630,6 +748,9 @@ private:
        op(bool, TraceJarCache, false,                                       \
           "Verbose trace of JarFile cache")                                 \
                                                                             \
+       op(bool, TraceClassPathCache, false,                                 \
+          "Trace the negative lookup cache of the classpath")               \
+                                                                            \
        op(bool, VerboseGC, false,                                           \
           "Print user-level GC information")                                \
                                                                             \
@@ -974,6 +1095,11 @@ private:
       WTK_PROFILER_RUNTIME_FLAGS(develop, product)         \
       JVMPI_PROFILE_RUNTIME_FLAGS(develop, product)        \
       JVMPI_PROFILE_VERIFY_RUNTIME_FLAGS(develop, product) \
+      PERF_MAP_RUNTIME_FLAGS(develop, product)             \
+      HOSTED_LIBM_RUNTIME_FLAGS(develop, product)          \
+      JAR_FILE_MAPPING_RUNTIME_FLAGS(develop, product)     \
+      VERIFIER_CACHE_RUNTIME_FLAGS(develop, product)       \
+      CLASSPATH_NEGATIVE_CACHE_RUNTIME_FLAGS(develop, product) \
       CPU_VARIANT_RUNTIME_FLAGS(develop, product)          \
       VFP_RUNTIME_FLAGS(develop, product)                  \
       TTY_TRACE_RUNTIME_FLAGS(always, develop, product)
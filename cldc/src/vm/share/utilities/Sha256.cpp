@@ -0,0 +1,284 @@
+/*
+ *
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+#include "incls/_precompiled.incl"
+#include "incls/_Sha256.cpp.incl"
+
+#if USE_VERIFIER_CACHE
+
+static const juint sha256_k[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+  0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+  0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+  0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+  0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+  0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline juint sha256_rotr(juint x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+void Sha256::reset() {
+  _state[0] = 0x6a09e667;
+  _state[1] = 0xbb67ae85;
+  _state[2] = 0x3c6ef372;
+  _state[3] = 0xa54ff53a;
+  _state[4] = 0x510e527f;
+  _state[5] = 0x9b05688c;
+  _state[6] = 0x1f83d9ab;
+  _state[7] = 0x5be0cd19;
+  _buffered = 0;
+  _length = 0;
+}
+
+void Sha256::transform(const jubyte* block) {
+  juint w[64];
+  int i;
+  for (i = 0; i < 16; i++) {
+    w[i] = ((juint)block[i * 4]     << 24) | ((juint)block[i * 4 + 1] << 16) |
+           ((juint)block[i * 4 + 2] <<  8) |  (juint)block[i * 4 + 3];
+  }
+  for (; i < 64; i++) {
+    const juint s0 = sha256_rotr(w[i - 15], 7) ^ sha256_rotr(w[i - 15], 18) ^
+                     (w[i - 15] >> 3);
+    const juint s1 = sha256_rotr(w[i - 2], 17) ^ sha256_rotr(w[i - 2], 19) ^
+                     (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  juint a = _state[0], b = _state[1], c = _state[2], d = _state[3];
+  juint e = _state[4], f = _state[5], g = _state[6], h = _state[7];
+  for (i = 0; i < 64; i++) {
+    const juint s1 = sha256_rotr(e, 6) ^ sha256_rotr(e, 11) ^
+                     sha256_rotr(e, 25);
+    const juint ch = (e & f) ^ (~e & g);
+    const juint t1 = h + s1 + ch + sha256_k[i] + w[i];
+    const juint s0 = sha256_rotr(a, 2) ^ sha256_rotr(a, 13) ^
+                     sha256_rotr(a, 22);
+    const juint maj = (a & b) ^ (a & c) ^ (b & c);
+    const juint t2 = s0 + maj;
+    h = g; g = f; f = e; e = d + t1;
+    d = c; c = b; b = a; a = t1 + t2;
+  }
+  _state[0] += a; _state[1] += b; _state[2] += c; _state[3] += d;
+  _state[4] += e; _state[5] += f; _state[6] += g; _state[7] += h;
+}
+
+void Sha256::update(const void* data, juint length) {
+  const jubyte* p = (const jubyte*)data;
+  _length += length;
+
+  if (_buffered > 0) {
+    juint n = block_size - _buffered;
+    if (n > length) {
+      n = length;
+    }
+    jvm_memcpy(_buffer + _buffered, p, n);
+    _buffered += n;
+    p += n;
+    length -= n;
+    if (_buffered < block_size) {
+      return;
+    }
+    transform(_buffer);
+    _buffered = 0;
+  }
+  while (length >= block_size) {
+    transform(p);
+    p += block_size;
+    length -= block_size;
+  }
+  if (length > 0) {
+    jvm_memcpy(_buffer, p, length);
+    _buffered = length;
+  }
+}
+
+void Sha256::finish(jubyte digest[digest_size]) {
+  const julong bits = _length * 8;
+  _buffer[_buffered++] = 0x80;
+  if (_buffered > block_size - 8) {
+    jvm_memset(_buffer + _buffered, 0, block_size - _buffered);
+    transform(_buffer);
+    _buffered = 0;
+  }
+  jvm_memset(_buffer + _buffered, 0, block_size - 8 - _buffered);
+  for (int i = 0; i < 8; i++) {
+    _buffer[block_size - 1 - i] = (jubyte)(bits >> (i * 8));
+  }
+  transform(_buffer);
+
+  for (int j = 0; j < 8; j++) {
+    digest[j * 4]     = (jubyte)(_state[j] >> 24);
+    digest[j * 4 + 1] = (jubyte)(_state[j] >> 16);
+    digest[j * 4 + 2] = (jubyte)(_state[j] >>  8);
+    digest[j * 4 + 3] = (jubyte)(_state[j]);
+  }
+  reset();
+}
+
+HmacSha256::HmacSha256(const jubyte* key, juint key_length) {
+  jubyte pad[Sha256::block_size];
+  jvm_memset(pad, 0, sizeof(pad));
+  if (key_length > Sha256::block_size) {
+    Sha256::digest(key, key_length, pad);
+  } else {
+    jvm_memcpy(pad, key, key_length);
+  }
+
+  for (int i = 0; i < Sha256::block_size; i++) {
+    _outer_pad[i] = (jubyte)(pad[i] ^ 0x5c);
+    pad[i] ^= 0x36;
+  }
+  _inner.update(pad, sizeof(pad));
+  jvm_memset(pad, 0, sizeof(pad));
+}
+
+void HmacSha256::finish(jubyte mac[Sha256::digest_size]) {
+  jubyte inner_digest[Sha256::digest_size];
+  _inner.finish(inner_digest);
+
+  Sha256 outer;
+  outer.update(_outer_pad, sizeof(_outer_pad));
+  outer.update(inner_digest, sizeof(inner_digest));
+  outer.finish(mac);
+  jvm_memset(_outer_pad, 0, sizeof(_outer_pad));
+}
+
+bool HmacSha256::equals(const jubyte* a, const jubyte* b) {
+  jubyte diff = 0;
+  for (int i = 0; i < Sha256::digest_size; i++) {
+    diff |= (jubyte)(a[i] ^ b[i]);
+  }
+  return diff == 0;
+}
+
+#ifndef PRODUCT
+
+static bool check_digest(const char* name, const jubyte* digest,
+                         const char* expected) {
+  char hex[Sha256::digest_size * 2 + 1];
+  for (int i = 0; i < Sha256::digest_size; i++) {
+    jvm_sprintf(hex + i * 2, "%02x", digest[i]);
+  }
+  const bool ok = (jvm_strcmp(hex, expected) == 0);
+  tty->print_cr("%s %s", ok ? "PASSED" : "FAILED", name);
+  if (!ok) {
+    tty->print_cr("    expected %s", expected);
+    tty->print_cr("    got      %s", hex);
+  }
+  return ok;
+}
+
+static bool check_hmac(const char* name, jubyte key_byte, juint key_length,
+                       const char* data, const char* expected) {
+  jubyte key[131];
+  GUARANTEE(key_length <= sizeof(key), "sanity");
+  jvm_memset(key, key_byte, key_length);
+
+  jubyte mac[Sha256::digest_size];
+  HmacSha256 hmac(key, key_length);
+  hmac.update(data, (juint)jvm_strlen(data));
+  hmac.finish(mac);
+  return check_digest(name, mac, expected);
+}
+
+bool Sha256::run_test_cases() {
+  jubyte digest[digest_size];
+  bool ok = true;
+
+  // FIPS 180-4 examples, plus the empty message.
+  Sha256::digest("", 0, digest);
+  ok &= check_digest("SHA-256 \"\"", digest,
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+  Sha256::digest("abc", 3, digest);
+  ok &= check_digest("SHA-256 \"abc\"", digest,
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+  static const char two_blocks[] =
+      "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+  Sha256::digest(two_blocks, sizeof(two_blocks) - 1, digest);
+  ok &= check_digest("SHA-256 448-bit message", digest,
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+  // One million 'a's, in pieces that don't line up with the blocks.
+  {
+    char piece[1000];
+    jvm_memset(piece, 'a', sizeof(piece));
+    Sha256 sha;
+    for (int i = 0; i < 1000; i++) {
+      sha.update(piece, sizeof(piece));
+    }
+    sha.finish(digest);
+    ok &= check_digest("SHA-256 1000000 x 'a'", digest,
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+  }
+
+  // RFC 4231 test cases 1, 2 and 6 (a key longer than a block).
+  ok &= check_hmac("HMAC-SHA256 case 1", 0x0b, 20, "Hi There",
+      "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7");
+
+  {
+    static const char data[] = "what do ya want for nothing?";
+    jubyte mac[digest_size];
+    HmacSha256 hmac((const jubyte*)"Jefe", 4);
+    hmac.update(data, sizeof(data) - 1);
+    hmac.finish(mac);
+    ok &= check_digest("HMAC-SHA256 case 2", mac,
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+
+    jubyte other[digest_size];
+    jvm_memcpy(other, mac, digest_size);
+    const bool same = HmacSha256::equals(mac, other);
+    other[digest_size - 1] ^= 1;
+    const bool differ = !HmacSha256::equals(mac, other);
+    tty->print_cr("%s HmacSha256::equals", (same && differ) ? "PASSED"
+                                                              : "FAILED");
+    ok &= (same && differ);
+  }
+
+  ok &= check_hmac("HMAC-SHA256 case 6", 0xaa, 131,
+      "Test Using Larger Than Block-Size Key - Hash Key First",
+      "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+
+  return ok;
+}
+
+#endif // PRODUCT
+
+#endif // USE_VERIFIER_CACHE
@@ -0,0 +1,87 @@
+/*
+ *
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+#if USE_VERIFIER_CACHE
+
+// SHA-256 (FIPS 180-4) and HMAC-SHA256 (RFC 2104). These are used to
+// identify class files and to authenticate the verifier cache file, where
+// a plain checksum could be forged.
+
+class Sha256 : public StackObj {
+ public:
+  enum {
+    digest_size = 32,
+    block_size  = 64
+  };
+
+  Sha256() {
+    reset();
+  }
+
+  void reset();
+  void update(const void* data, juint length);
+  void finish(jubyte digest[digest_size]);
+
+  static void digest(const void* data, juint length,
+                     jubyte digest[digest_size]) {
+    Sha256 sha;
+    sha.update(data, length);
+    sha.finish(digest);
+  }
+
+#ifndef PRODUCT
+  // Checks Sha256 and HmacSha256 against the FIPS 180-4 and RFC 4231
+  // test vectors. Returns false if any of them fails.
+  static bool run_test_cases();
+#endif
+
+ private:
+  void transform(const jubyte* block);
+
+  juint  _state[8];
+  jubyte _buffer[block_size];
+  juint  _buffered;
+  julong _length;
+};
+
+class HmacSha256 : public StackObj {
+ public:
+  HmacSha256(const jubyte* key, juint key_length);
+
+  void update(const void* data, juint length) {
+    _inner.update(data, length);
+  }
+  void finish(jubyte mac[Sha256::digest_size]);
+
+  // Compares two MACs in time independent of their contents.
+  static bool equals(const jubyte* a, const jubyte* b);
+
+ private:
+  Sha256 _inner;
+  jubyte _outer_pad[Sha256::block_size];
+};
+
+#endif // USE_VERIFIER_CACHE
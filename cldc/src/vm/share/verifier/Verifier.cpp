@@ -84,7 +84,7 @@ void Verifier::verify_class_internal(InstanceClass* ic JVM_TRAPS) {
     }
 #endif
     VerifyMethodCodes verifier;
-    stackmap = method().stackmaps();
+    stackmap = ClassFileParser::expand_stackmaps(&method JVM_CHECK);
     verifier.verify(&method, &stackmap JVM_CHECK);
   }
 
@@ -94,6 +94,16 @@ void Verifier::verify_class_internal(InstanceClass* ic JVM_TRAPS) {
 } 
 
 void Verifier::verify_class(InstanceClass* ic JVM_TRAPS) {
+#if USE_VERIFIER_CACHE
+  if (VerifierCache::is_recorded(ic)) {
+    // This exact class file has passed verification in an earlier run of
+    // the VM with the same classpath, so only the stackmaps are needed.
+    StackmapGenerator::compress_verifier_stackmaps(ic JVM_CHECK);
+    ic->set_verified();
+    return;
+  }
+#endif
+
   GUARANTEE(!is_active(), "not re-entrant");
 
   // this one allows is_active to be restored to false, even if 
@@ -136,7 +146,7 @@ void Verifier::verify_class(InstanceClass* ic JVM_TRAPS) {
   }
 
 
-  verify_class_internal(ic JVM_NO_CHECK_AT_BOTTOM); 
+  verify_class_internal(ic JVM_NO_CHECK); 
 
 #if ENABLE_PERFORMANCE_COUNTERS
   // Don't count the class loading time during verification, since we want
@@ -151,6 +161,15 @@ void Verifier::verify_class(InstanceClass* ic JVM_TRAPS) {
   }
 #endif
 
+#if USE_VERIFIER_CACHE
+  if (!CURRENT_HAS_PENDING_EXCEPTION) {
+#if ENABLE_PERFORMANCE_COUNTERS
+    VerifierCache::record(ic, elapsed);
+#else
+    VerifierCache::record(ic, 0);
+#endif
+  }
+#endif
 }
 
 bool Verifier::flush_cache() {
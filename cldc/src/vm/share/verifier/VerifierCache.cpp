@@ -0,0 +1,437 @@
+/*
+ *
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+#include "incls/_precompiled.incl"
+#include "incls/_VerifierCache.cpp.incl"
+
+#if USE_VERIFIER_CACHE
+
+VerifierCache::State  VerifierCache::_state = VerifierCache::disabled;
+bool                  VerifierCache::_is_dirty;
+VerifierCache::Header VerifierCache::_header;
+VerifierCache::Entry* VerifierCache::_table;
+juint                 VerifierCache::_table_capacity;
+juint                 VerifierCache::_entry_count;
+jubyte                VerifierCache::_key[VerifierCache::key_size];
+VerifierCache::PendingClass* VerifierCache::_pending;
+int                          VerifierCache::_pending_size;
+
+void VerifierCache::initialize() {
+  _state = disabled;
+  _is_dirty = false;
+  _table = NULL;
+  _table_capacity = 0;
+  _entry_count = 0;
+  _pending = NULL;
+  _pending_size = 0;
+
+  if (Arguments::verifier_cache_file() == NULL || !UseVerifierCache ||
+      !UseVerifier || VerifyOnly || GenerateROMImage) {
+    return;
+  }
+  if (!OsMisc_get_verifier_cache_key(Arguments::verifier_cache_file(),
+                                     _key, key_size)) {
+    if (TraceVerifierCache) {
+      TTY_TRACE_CR(("VerifierCache: not used, no key for the cache file"));
+    }
+    return;
+  }
+  if (!allocate_table()) {
+    return;
+  }
+
+  jvm_memset(&_header, 0, sizeof(Header));
+  _header.magic = file_magic;
+  _header.version = file_version;
+  _header.build_stamp = build_stamp();
+  read_file();
+  _state = unchecked;
+}
+
+void VerifierCache::dispose() {
+  if (_state == active && _is_dirty) {
+    write_file();
+  }
+  if (_table != NULL) {
+    OsMemory_free(_table);
+    _table = NULL;
+  }
+  if (_pending != NULL) {
+    OsMemory_free(_pending);
+    _pending = NULL;
+  }
+  _pending_size = 0;
+  jvm_memset(_key, 0, key_size);
+  _state = disabled;
+}
+
+bool VerifierCache::allocate_table() {
+  // Keep the table at most 3/4 full, so that probe sequences stay short
+  // and every unsuccessful probe ends at an empty slot.
+  const juint max_entries = (juint)max(MaxVerifierCacheEntries, 1);
+  juint capacity = 4;
+  while (capacity * 3 < max_entries * 4) {
+    capacity <<= 1;
+  }
+  const size_t size = capacity * sizeof(Entry);
+  _table = (Entry*)OsMemory_allocate(size);
+  if (_table == NULL) {
+    return false;
+  }
+  jvm_memset(_table, 0, size);
+  _table_capacity = capacity;
+  return true;
+}
+
+juint VerifierCache::build_stamp() {
+  // The ROM image is linked into the VM, so its size and contents are
+  // checked together with the build version of the VM itself. The build
+  // date isn't included: it would drop the cache on every rebuild and
+  // make the VM binary irreproducible.
+  static const char version[] = JVM_RELEASE_VERSION " " JVM_BUILD_VERSION;
+  juint stamp = Inflater::crc32((const unsigned char*)version,
+                                sizeof(version) - 1);
+  stamp = stamp * 31 + (juint)_rom_number_of_java_classes;
+  stamp = stamp * 31 + (juint)_rom_data_block_size;
+  stamp = stamp * 31 + (juint)_rom_heap_block_size;
+  stamp = stamp * 31 + (juint)_rom_method_variable_parts_size;
+  stamp = stamp * 31 + Inflater::crc32((const unsigned char*)_rom_heap_block,
+                                       (juint)_rom_heap_block_size);
+  return stamp;
+}
+
+void VerifierCache::compute_mac(const Header& header, const Entry* entries,
+                                jubyte mac[Sha256::digest_size]) {
+  HmacSha256 hmac(_key, key_size);
+  hmac.update(&header, sizeof(Header) - sizeof(header.mac));
+  hmac.update(entries, header.entry_count * sizeof(Entry));
+  hmac.finish(mac);
+}
+
+void VerifierCache::compute_key(Buffer* buffer, Entry& key) {
+  jubyte digest[Sha256::digest_size];
+  Sha256::digest(buffer->base_address(), (juint)buffer->length(), digest);
+
+  key.length = (juint)buffer->length();
+  key.hrticks = 0;
+  jvm_memcpy(key.digest, digest, entry_digest_size);
+}
+
+inline juint VerifierCache::slot(const Entry& key) {
+  return ((juint)key.digest[0]        | ((juint)key.digest[1] << 8) |
+          ((juint)key.digest[2] << 16) | ((juint)key.digest[3] << 24)) &
+         (_table_capacity - 1);
+}
+
+VerifierCache::Entry* VerifierCache::find(const Entry& key) {
+  const juint mask = _table_capacity - 1;
+  for (juint i = slot(key); _table[i].length != 0; i = (i + 1) & mask) {
+    Entry* e = &_table[i];
+    if (e->length == key.length &&
+        jvm_memcmp(e->digest, key.digest, entry_digest_size) == 0) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+bool VerifierCache::add(const Entry& key) {
+  if (find(key) != NULL) {
+    return true;
+  }
+  if (_entry_count >= (juint)MaxVerifierCacheEntries) {
+    return false;
+  }
+  const juint mask = _table_capacity - 1;
+  juint i = slot(key);
+  while (_table[i].length != 0) {
+    i = (i + 1) & mask;
+  }
+  _table[i] = key;
+  _entry_count ++;
+  return true;
+}
+
+void VerifierCache::read_file() {
+  OsFile_Handle file = OsFile_open(Arguments::verifier_cache_file(), "rb");
+  if (file == NULL) {
+    // The first run with this cache file.
+    _is_dirty = true;
+    return;
+  }
+
+  Header header;
+  Entry* entries = NULL;
+  const long file_length = OsFile_length(file);
+  bool ok = OsFile_read(file, &header, sizeof(Header), 1) == 1 &&
+            header.magic == _header.magic &&
+            header.version == _header.version &&
+            header.build_stamp == _header.build_stamp &&
+            header.entry_count <= (juint)MaxVerifierCacheEntries &&
+            file_length == (long)(sizeof(Header) +
+                                  header.entry_count * sizeof(Entry));
+  if (ok && header.entry_count > 0) {
+    const juint count = header.entry_count;
+    entries = (Entry*)OsMemory_allocate(count * sizeof(Entry));
+    ok = entries != NULL &&
+         OsFile_read(file, entries, sizeof(Entry), count) == count;
+  }
+  OsFile_close(file);
+
+  if (ok) {
+    // Nothing in the file is used before the MAC has been checked.
+    jubyte mac[Sha256::digest_size];
+    compute_mac(header, entries, mac);
+    ok = HmacSha256::equals(mac, header.mac);
+  }
+
+  if (ok) {
+    for (juint i = 0; i < header.entry_count; i++) {
+      if (entries[i].length == 0 || !add(entries[i])) {
+        ok = false;
+        break;
+      }
+    }
+  }
+
+  if (entries != NULL) {
+    OsMemory_free(entries);
+  }
+
+  if (ok) {
+    jvm_memcpy(_header.classpath_digest, header.classpath_digest,
+               sizeof(header.classpath_digest));
+  } else {
+    jvm_memset(_table, 0, _table_capacity * sizeof(Entry));
+    _entry_count = 0;
+    _is_dirty = true;
+  }
+
+  if (TraceVerifierCache) {
+    if (ok) {
+      TTY_TRACE_CR(("VerifierCache: read %d entries", _entry_count));
+    } else {
+      TTY_TRACE_CR(("VerifierCache: ignoring stale or damaged file"));
+    }
+  }
+}
+
+void VerifierCache::write_file() {
+  Entry* entries = NULL;
+  if (_entry_count > 0) {
+    entries = (Entry*)OsMemory_allocate(_entry_count * sizeof(Entry));
+    if (entries == NULL) {
+      return;
+    }
+    juint n = 0;
+    for (juint i = 0; i < _table_capacity; i++) {
+      if (_table[i].length != 0) {
+        entries[n++] = _table[i];
+      }
+    }
+    GUARANTEE(n == _entry_count, "sanity");
+  }
+
+  _header.entry_count = _entry_count;
+  compute_mac(_header, entries, _header.mac);
+
+  // A partially written file is rejected by read_file(), because its
+  // length doesn't match the header.
+  OsFile_Handle file = OsFile_open(Arguments::verifier_cache_file(), "wb");
+  if (file != NULL) {
+    bool ok = OsFile_write(file, &_header, sizeof(Header), 1) == 1;
+    if (ok && _entry_count > 0) {
+      ok = OsFile_write(file, entries, sizeof(Entry), _entry_count) ==
+           _entry_count;
+    }
+    OsFile_close(file);
+    if (TraceVerifierCache) {
+      TTY_TRACE_CR(("VerifierCache: %s %d entries",
+                    ok ? "wrote" : "failed to write", _entry_count));
+    }
+  }
+
+  if (entries != NULL) {
+    OsMemory_free(entries);
+  }
+}
+
+bool VerifierCache::classpath_digest(OopDesc* classpath, Sha256& sha
+                                     JVM_TRAPS) {
+  if (classpath == NULL) {
+    return true;
+  }
+
+  UsingFastOops fast_oops;
+  ObjArray::Fast cp(classpath);
+  JarFileParser::Fast parser;
+  const int cp_length = cp().length();
+
+  for (int index = 0; index < cp_length; index++) {
+    FilePath::Raw path = cp().obj_at(index);
+    if (path.is_null()) {
+      // A preloaded binary image, which isn't covered by the digest.
+      return false;
+    }
+
+    DECLARE_STATIC_BUFFER(PathChar, path_name, NAME_BUFFER_SIZE);
+    if (path().length() >= NAME_BUFFER_SIZE) {
+      return false;
+    }
+    path().string_copy(path_name, NAME_BUFFER_SIZE);
+
+    parser = JarFileParser::get(path_name, true JVM_CHECK_0);
+    if (parser.is_null()) {
+      // A directory.
+      return false;
+    }
+    if (!parser().update_digest(sha)) {
+      return false;
+    }
+    parser.set_null();
+  }
+  return true;
+}
+
+bool VerifierCache::check_classpath(JVM_SINGLE_ARG_TRAPS) {
+  Sha256 sha;
+  Task* task = Task::current();
+  bool ok = classpath_digest(task->sys_classpath(), sha JVM_CHECK_0);
+  if (ok) {
+    ok = classpath_digest(task->app_classpath(), sha JVM_CHECK_0);
+  }
+
+  if (!ok) {
+    if (TraceVerifierCache) {
+      TTY_TRACE_CR(("VerifierCache: not used, the classpath contains "
+                    "entries that are not JAR files"));
+    }
+    _state = disabled;
+    return false;
+  }
+
+  jubyte digest[Sha256::digest_size];
+  sha.finish(digest);
+  if (jvm_memcmp(digest, _header.classpath_digest, sizeof(digest)) != 0) {
+    if (TraceVerifierCache && _entry_count > 0) {
+      TTY_TRACE_CR(("VerifierCache: classpath has changed, dropping %d "
+                    "entries", _entry_count));
+    }
+    jvm_memset(_table, 0, _table_capacity * sizeof(Entry));
+    _entry_count = 0;
+    jvm_memcpy(_header.classpath_digest, digest, sizeof(digest));
+    _is_dirty = true;
+  }
+  _state = active;
+  return true;
+}
+
+VerifierCache::PendingClass* VerifierCache::pending_class(int class_id,
+                                                          bool create) {
+  if (class_id >= _pending_size) {
+    if (!create) {
+      return NULL;
+    }
+    int new_size = max(_pending_size * 2, 64);
+    while (new_size <= class_id) {
+      new_size *= 2;
+    }
+    PendingClass* p =
+        (PendingClass*)OsMemory_allocate(new_size * sizeof(PendingClass));
+    if (p == NULL) {
+      return NULL;
+    }
+    jvm_memset(p, 0, new_size * sizeof(PendingClass));
+    if (_pending != NULL) {
+      jvm_memcpy(p, _pending, _pending_size * sizeof(PendingClass));
+      OsMemory_free(_pending);
+    }
+    _pending = p;
+    _pending_size = new_size;
+  }
+  return &_pending[class_id];
+}
+
+void VerifierCache::class_parsed(InstanceClass* ic, Buffer* buffer
+                                 JVM_TRAPS) {
+  if (_state == unchecked) {
+    check_classpath(JVM_SINGLE_ARG_CHECK);
+  }
+  if (_state != active) {
+    return;
+  }
+
+  PendingClass* pending = pending_class(ic->class_id(), true);
+  if (pending != NULL) {
+    compute_key(buffer, pending->key);
+    pending->is_recorded = (find(pending->key) != NULL);
+  }
+}
+
+bool VerifierCache::is_recorded(InstanceClass* ic) {
+  if (_state != active) {
+    return false;
+  }
+  PendingClass* pending = pending_class(ic->class_id(), false);
+  if (pending == NULL || !pending->is_recorded) {
+    return false;
+  }
+  pending->is_recorded = false;
+
+#if ENABLE_PERFORMANCE_COUNTERS
+  const Entry* e = find(pending->key);
+  jvm_perf_count.num_of_verify_cache_hits ++;
+  jvm_perf_count.saved_verify_hrticks += e->hrticks;
+#endif
+#if ENABLE_TTY_TRACE
+  if (TraceVerifierCache) {
+    tty->print("VerifierCache: skipping verification of ");
+    ic->print_name_on(tty);
+    tty->cr();
+  }
+#endif
+  pending->key.length = 0;
+  return true;
+}
+
+void VerifierCache::record(InstanceClass* ic, jlong hrticks) {
+  if (_state != active) {
+    return;
+  }
+  PendingClass* pending = pending_class(ic->class_id(), false);
+  if (pending == NULL || pending->key.length == 0) {
+    return;
+  }
+
+  pending->key.hrticks = (hrticks > (jlong)0xffffffff) ? 0xffffffff
+                                                       : (juint)hrticks;
+  if (add(pending->key)) {
+    _is_dirty = true;
+  }
+  pending->key.length = 0;
+}
+
+#endif // USE_VERIFIER_CACHE
@@ -0,0 +1,138 @@
+/*
+ *
+ *
+ * Copyright  1990-2009 Sun Microsystems, Inc. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version
+ * 2 only, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License version 2 for more details (a copy is
+ * included at /legal/license.txt).
+ *
+ * You should have received a copy of the GNU General Public License
+ * version 2 along with this work; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa
+ * Clara, CA 95054 or visit www.sun.com if you need additional
+ * information or have any questions.
+ */
+
+#if USE_VERIFIER_CACHE
+
+// VerifierCache remembers the classes that passed verification, so that
+// later runs of the VM don't have to verify them again. It is used only
+// when the VM is started with -verifiercache <file>.
+//
+// A class is identified by the length and the SHA-256 digest of its class
+// file. Whether a class verifies also depends on the classes it refers to,
+// so a recorded entry is only valid together with the rest of the
+// classpath. The file header therefore contains a stamp of the VM build
+// and ROM image, and a SHA-256 digest of the central directory of every
+// JAR file on the classpath. If any of them has changed, the recorded
+// entries are dropped and the file is written again from scratch.
+// Directories on the classpath can't be digested cheaply, so the cache is
+// not used when the classpath contains one.
+//
+// Only the central directories are read at startup, so a changed class
+// that another class was verified against is noticed by its size or
+// CRC32. A class crafted to keep the CRC32 of the one it replaces is
+// itself verified again (its own digest changed), but the classes that
+// were verified against the original aren't. JAR files on the classpath
+// must therefore be as trusted as the cache file itself.
+//
+// A recorded entry lets a class skip verification, so the file is
+// authenticated with an HMAC-SHA256 keyed by a per-device secret from
+// OsMisc_get_verifier_cache_key(). The file is only accepted as a whole:
+// a wrong magic number, size or MAC means that all classes are fully
+// verified. Without a secret the cache is not used at all; only the linux
+// port provides one so far.
+
+class VerifierCache : public AllStatic {
+ public:
+  // Reads the cache file, if one is given on the command line.
+  static void initialize();
+
+  // Writes the cache file if new classes have been recorded, and frees
+  // all memory used by the cache.
+  static void dispose();
+
+  // Called when <ic> has been parsed from <buffer>, to compute the key
+  // of the class and look it up in the cache.
+  static void class_parsed(InstanceClass* ic, Buffer* buffer JVM_TRAPS);
+
+  // Returns true if <ic> is recorded as verified, so that the caller can
+  // mark it as verified without running the verifier.
+  static bool is_recorded(InstanceClass* ic);
+
+  // Called when <ic> has passed verification, which took <hrticks>.
+  static void record(InstanceClass* ic, jlong hrticks);
+
+ private:
+  enum {
+    file_magic        = 0x4a564346, // 'JVCF'
+    file_version      = 2,
+    entry_digest_size = 16,         // leading bytes of the SHA-256 digest
+    key_size          = Sha256::digest_size
+  };
+
+  struct Entry {
+    juint  length;      // length of the class file, 0 for an empty slot
+    juint  hrticks;     // time it took to verify the class
+    jubyte digest[entry_digest_size];
+  };
+
+  struct Header {
+    juint  magic;
+    juint  version;
+    juint  build_stamp;
+    juint  entry_count;
+    jubyte classpath_digest[Sha256::digest_size];
+    jubyte mac[Sha256::digest_size]; // HMAC of all of the above + entries
+  };
+
+  enum State {
+    disabled,           // no cache file, or the cache can't be used
+    unchecked,          // classpath digest not computed yet
+    active
+  };
+
+  static void compute_key(Buffer* buffer, Entry& key);
+  static juint slot(const Entry& key);
+  static Entry* find(const Entry& key);
+  static bool add(const Entry& key);
+  static bool allocate_table();
+  static bool check_classpath(JVM_SINGLE_ARG_TRAPS);
+  static bool classpath_digest(OopDesc* classpath, Sha256& sha JVM_TRAPS);
+  static juint build_stamp();
+  static void compute_mac(const Header& header, const Entry* entries,
+                          jubyte mac[Sha256::digest_size]);
+  static void read_file();
+  static void write_file();
+  struct PendingClass {
+    Entry key;
+    bool  is_recorded;
+  };
+  static PendingClass* pending_class(int class_id, bool create);
+
+  static State  _state;
+  static bool   _is_dirty;
+  static Header _header;
+  static Entry* _table;
+  static juint  _table_capacity;
+  static juint  _entry_count;
+  static jubyte _key[key_size];
+
+  // The classes that have been parsed but not yet verified, indexed by
+  // class id.
+  static PendingClass* _pending;
+  static int           _pending_size;
+};
+
+#endif // USE_VERIFIER_CACHE
@@ -106,7 +106,7 @@ public class I2CSlaveImpl implements I2CDevice {
 
     public int read() throws IOException,
             UnavailableDeviceException, ClosedDeviceException {
-        ByteBuffer dst = ByteBuffer.allocateDirect(1);
+        ByteBuffer dst = ByteBuffer.allocate(1);
         read(dst);
         return dst.get(0);
     }
@@ -158,7 +158,7 @@ public class I2CSlaveImpl implements I2CDevice {
 
     public void write(int srcData) throws IOException,
             UnavailableDeviceException, ClosedDeviceException {
-        ByteBuffer dst = ByteBuffer.allocateDirect(1);
+        ByteBuffer dst = ByteBuffer.allocate(1);
         dst.put((byte) srcData);
         dst.flip();
         write(dst);
@@ -174,7 +174,7 @@ public class I2CSlaveImpl implements I2CDevice {
 
         doCheck(0, src);
 
-        ByteBuffer tmp = ByteBuffer.allocateDirect(4/*size of int*/ + src.remaining());
+        ByteBuffer tmp = ByteBuffer.allocate(4/*size of int*/ + src.remaining());
         //tmp.order(ByteOrder.BIG_ENDIAN);
         tmp.putInt(subaddress);
         tmp.put(src);
@@ -184,7 +184,8 @@ final class SPICompositeMessageImpl implements SPICompositeMessage {
     /**
      * Returns buffers are suitable for low level SPI operations
      * New src buffer is located at index 0, dst buffer is at index 1
-     * The both buffers are direct to avoid native resource allocations in low levels
+     * The caller's buffers are reused when large enough, direct or not, since
+     * the native transfer accesses both kinds in place
      * The both buffers are the same length
      *
      * @param originalSrc original array to be sent
@@ -201,8 +202,8 @@ final class SPICompositeMessageImpl implements SPICompositeMessage {
 
         ByteBuffer[] array = new ByteBuffer[2];
 
-        if (originalSrc == null || !originalSrc.isDirect() || originalSrc.remaining() < newRequiredSizeOfBuffers) {
-            array[0] = (ByteBuffer) ByteBuffer.allocateDirect(newRequiredSizeOfBuffers);
+        if (originalSrc == null || originalSrc.remaining() < newRequiredSizeOfBuffers) {
+            array[0] = (ByteBuffer) ByteBuffer.allocate(newRequiredSizeOfBuffers);
             if (originalSrc != null) {
                 array[0].put(originalSrc);
             }
@@ -213,8 +214,8 @@ final class SPICompositeMessageImpl implements SPICompositeMessage {
             array[0] = originalSrc.slice();
         }
 
-        if (originalDst == null || !originalDst.isDirect() || originalDst.remaining() < newRequiredSizeOfBuffers) {
-            array[1] = ByteBuffer.allocateDirect(newRequiredSizeOfBuffers);
+        if (originalDst == null || originalDst.remaining() < newRequiredSizeOfBuffers) {
+            array[1] = ByteBuffer.allocate(newRequiredSizeOfBuffers);
         } else {
             //Can not use originalDst as is, because caller code can change position and limit
             //after calling read/write/append operations
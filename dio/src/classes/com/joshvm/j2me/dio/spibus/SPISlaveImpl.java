@@ -147,7 +147,7 @@ public class SPISlaveImpl implements SPIDevice {
      */
     public int read() throws IOException, UnavailableDeviceException,
             ClosedDeviceException {
-        ByteBuffer dst = ByteBuffer.allocateDirect(byteNum);        
+        ByteBuffer dst = ByteBuffer.allocate(byteNum);        
         transferInternal(null, 0, dst);
         return byteArray2int(dst);
     }
@@ -272,7 +272,7 @@ public class SPISlaveImpl implements SPIDevice {
 
     private ByteBuffer int2byteArray(int intVal) {
 		// TODO: Consider bitOrdering??
-        ByteBuffer retA = ByteBuffer.allocateDirect(byteNum);
+        ByteBuffer retA = ByteBuffer.allocate(byteNum);
         for (int i=0; i< byteNum ; i++) {
             retA.put((byte)((intVal >> (8*(byteNum-i-1))) & 0xff));
         }
@@ -313,7 +313,9 @@ public class SPISlaveImpl implements SPIDevice {
     
     /**
      * Performs a SPI transfer operation with locking the SPI peripheral
-     * The both buffers should be direct and same length
+     * The both buffers should be same length. Direct buffers are handed
+     * to the native by address, heap buffers by their backing array;
+     * neither is copied.
      *
      * @param src 
      *            Direct byte buffer which will be sent to the slave device
@@ -324,19 +326,39 @@ public class SPISlaveImpl implements SPIDevice {
      */    
     void transferWithLock(ByteBuffer src, ByteBuffer dst) throws IOException {
     	// TODO: Is inter-app Lock really needed???
-    	byte[] src_array = src.array();
-		byte[] dst_array = dst.array();
 		if (src.remaining() != dst.remaining()) {
 			throw new IllegalArgumentException("Input and Output buffers are not in same size");
 		}
+    	byte[] src_array = src.isDirect() ? null : src.array();
+		byte[] dst_array = dst.isDirect() ? null : dst.array();
+		int src_offset = nativeOffset(src);
+		int dst_offset = nativeOffset(dst);
 
-        int bytesTransferred = writeAndRead0(handle, src_array, src.position()+src.arrayOffset(), 
-					  dst_array, dst.position()+dst.arrayOffset(),
+        int bytesTransferred = writeAndRead0(handle, src_array, src_offset, 
+					  dst_array, dst_offset,
 					  src.remaining());
 		src.position(src.position()+bytesTransferred);
 		dst.position(dst.position()+bytesTransferred);
     }
 
+    /*
+     * Returns the offset handed to writeAndRead0 for the remaining bytes of
+     * bb: the native address of a direct buffer, or the index into the
+     * backing array. The native doesn't check it, so the range is checked
+     * here.
+     */
+    private static int nativeOffset(ByteBuffer bb) {
+        if (bb.isDirect()) {
+            return bb.positionAddress();
+        }
+        int offset = bb.arrayOffset() + bb.position();
+        if (bb.position() < 0 || bb.remaining() < 0 ||
+                offset < 0 || bb.remaining() > bb.array().length - offset) {
+            throw new IndexOutOfBoundsException();
+        }
+        return offset;
+    }
+
     void beginTransaction() throws IOException {
         // interapp lock
         //conditionalLock();
@@ -383,7 +405,9 @@ public class SPISlaveImpl implements SPIDevice {
                                               int bitOrdering, boolean exclusive) throws
             IOException, DeviceNotFoundException, InvalidDeviceConfigException, UnavailableDeviceException, UnsupportedAccessModeException;
 
-    /* PREREQUISITES: either dst.len must be equals to src.len*/
+    /* PREREQUISITES: either dst.len must be equals to src.len
+     * A null src or dst means the corresponding offset is the native
+     * address of a direct buffer. */
     private native int writeAndRead0(int handle, byte[] src, int src_offset, byte[] dst, int dst_offset, int length) throws IOException;
 	private native void close0(int handle);
 }
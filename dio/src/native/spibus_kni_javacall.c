@@ -147,12 +147,17 @@ Java_com_joshvm_j2me_dio_spibus_SPISlaveImpl_writeAndRead0()
 	    KNI_GetParameterAsObject(2, src_buffer_object);
 		KNI_GetParameterAsObject(4, dst_buffer_object);
 
-		DEBUG_PRINTF("[KNI]SPISlaveImpl_writeAndRead0: src_buf len=%d, dst_buf len=%d\n", 
-						KNI_GetArrayLength(src_buffer_object),
-						KNI_GetArrayLength(dst_buffer_object));
-		
-	    srcbuf = (char *) SNI_GetRawArrayPointer(src_buffer_object) + src_offset;
-		dstbuf = (char *) SNI_GetRawArrayPointer(dst_buffer_object) + dst_offset;
+		/* A null array means a direct buffer: the offset is its native address */
+		if (KNI_IsNullHandle(src_buffer_object)) {
+			srcbuf = (char *) src_offset;
+		} else {
+			srcbuf = (char *) SNI_GetRawArrayPointer(src_buffer_object) + src_offset;
+		}
+		if (KNI_IsNullHandle(dst_buffer_object)) {
+			dstbuf = (char *) dst_offset;
+		} else {
+			dstbuf = (char *) SNI_GetRawArrayPointer(dst_buffer_object) + dst_offset;
+		}
 
 	    bytesTransffered = javacall_spi_send_and_receive_sync((javacall_handle)handle, srcbuf, dstbuf, len);
 		if (bytesTransffered < 0) {
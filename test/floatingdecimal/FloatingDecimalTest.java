@@ -0,0 +1,188 @@
+/**
+ * Conformance test for the conversions between floating-point values and
+ * strings: Double/Float.toString() and Double.parseDouble()/
+ * Float.parseFloat(), which FloatingDecimal implements partly in the VM.
+ *
+ * The expected strings are those of the original Java FloatingDecimal
+ * code, quirks included ("0.0020"). The expected parse results are the
+ * correctly rounded values. CLDC doesn't parse "NaN" or "Infinity".
+ *
+ * Prints every failure and a summary, and exits with status 1 if any
+ * case failed.
+ */
+class FloatingDecimalTest {
+
+	private static int passed;
+	private static int failed;
+
+	private static void check(String what, String actual, String expected) {
+		if (expected.equals(actual)) {
+			passed++;
+		} else {
+			failed++;
+			System.out.println("FAILED " + what + ": got " + actual
+					+ ", expected " + expected);
+		}
+	}
+
+	private static void formatDouble(long bits, String expected) {
+		double d = Double.longBitsToDouble(bits);
+		check("Double.toString(0x" + Long.toString(bits, 16) + ")",
+				Double.toString(d), expected);
+	}
+
+	private static void formatFloat(int bits, String expected) {
+		float f = Float.intBitsToFloat(bits);
+		check("Float.toString(0x" + Integer.toHexString(bits) + ")",
+				Float.toString(f), expected);
+	}
+
+	private static void parseDouble(String s, long expected) {
+		String actual;
+		try {
+			long bits = Double.doubleToLongBits(Double.parseDouble(s));
+			actual = "0x" + Long.toString(bits, 16);
+		} catch (NumberFormatException e) {
+			actual = "NumberFormatException";
+		}
+		check("Double.parseDouble(\"" + s + "\")", actual,
+				"0x" + Long.toString(expected, 16));
+	}
+
+	private static void parseFloat(String s, int expected) {
+		String actual;
+		try {
+			int bits = Float.floatToIntBits(Float.parseFloat(s));
+			actual = "0x" + Integer.toHexString(bits);
+		} catch (NumberFormatException e) {
+			actual = "NumberFormatException";
+		}
+		check("Float.parseFloat(\"" + s + "\")", actual,
+				"0x" + Integer.toHexString(expected));
+	}
+
+	private static void parseInvalid(String s) {
+		String actual;
+		try {
+			actual = Double.toString(Double.parseDouble(s));
+		} catch (NumberFormatException e) {
+			actual = "NumberFormatException";
+		}
+		check("Double.parseDouble(\"" + s + "\")", actual,
+				"NumberFormatException");
+		try {
+			actual = Float.toString(Float.parseFloat(s));
+		} catch (NumberFormatException e) {
+			actual = "NumberFormatException";
+		}
+		check("Float.parseFloat(\"" + s + "\")", actual,
+				"NumberFormatException");
+	}
+
+	private static void testFormatDouble() {
+		formatDouble(0x0000000000000000L, "0.0");
+		formatDouble(0x8000000000000000L, "-0.0");
+		formatDouble(0x3ff0000000000000L, "1.0");
+		formatDouble(0xbff8000000000000L, "-1.5");
+		formatDouble(0x3fb999999999999aL, "0.1");
+		formatDouble(0x3f60624dd2f1a9fcL, "0.0020");	// 0.002
+		formatDouble(0x3f50624dd2f1a9fcL, "0.0010");	// 0.001
+		formatDouble(0x4059000000000000L, "100.0");
+		// Switch to E notation at 10^7.
+		formatDouble(0x416312cfe0000000L, "9999999.0");
+		formatDouble(0x416312d000000000L, "1.0E7");
+		formatDouble(0x419d6f3454000000L, "1.23456789E8");
+		formatDouble(0x3fd5555555555555L, "0.3333333333333333");
+		formatDouble(0x3fe5555555555555L, "0.6666666666666666");
+		formatDouble(0xbeea36e2eb1c432dL, "-1.25E-5");
+		// Double.MAX_VALUE, denormals and the smallest normal value.
+		formatDouble(0x7fefffffffffffffL, "1.7976931348623157E308");
+		formatDouble(0x0000000000000001L, "4.9E-324");
+		formatDouble(0x0000000000000002L, "1.0E-323");
+		formatDouble(0x000fffffffffffffL, "2.225073858507201E-308");
+		formatDouble(0x0010000000000000L, "2.2250738585072014E-308");
+		formatDouble(0x7ff8000000000000L, "NaN");
+		formatDouble(0x7ff0000000000000L, "Infinity");
+		formatDouble(0xfff0000000000000L, "-Infinity");
+	}
+
+	private static void testFormatFloat() {
+		formatFloat(0x00000000, "0.0");
+		formatFloat(0x80000000, "-0.0");
+		formatFloat(0x3f800000, "1.0");
+		formatFloat(0x3dcccccd, "0.1");
+		formatFloat(0x3b03126f, "0.0020");	// 0.002f
+		formatFloat(0x4b189680, "1.0E7");
+		formatFloat(0x4b800000, "1.6777216E7");
+		formatFloat(0x501502f9, "1.0E10");
+		formatFloat(0x3eaaaaab, "0.33333334");
+		// Float.MAX_VALUE, denormals and the smallest normal value.
+		formatFloat(0x7f7fffff, "3.4028235E38");
+		formatFloat(0x00000001, "1.4E-45");
+		formatFloat(0x007fffff, "1.1754942E-38");
+		formatFloat(0x00800000, "1.17549435E-38");
+		formatFloat(0x7fc00000, "NaN");
+		formatFloat(0x7f800000, "Infinity");
+		formatFloat(0xff800000, "-Infinity");
+	}
+
+	private static void testParseDouble() {
+		parseDouble("0", 0x0000000000000000L);
+		parseDouble("-0.0", 0x8000000000000000L);
+		parseDouble("1", 0x3ff0000000000000L);
+		parseDouble("+1.5", 0x3ff8000000000000L);
+		parseDouble("0.1", 0x3fb999999999999aL);
+		parseDouble("  12.5  ", 0x4029000000000000L);
+		parseDouble("8.5d", 0x4021000000000000L);
+		parseDouble("3.0E-5", 0x3eff75104d551d69L);
+		parseDouble("1e23", 0x44b52d02c7e14af6L);
+		parseDouble("123456789012345678", 0x437b69b4ba630f35L);
+		// Halfway between two doubles: round to even.
+		parseDouble("9007199254740993", 0x4340000000000000L);
+		parseDouble("9007199254740995", 0x4340000000000002L);
+		// Extremes, which are left to the Java code.
+		parseDouble("1.7976931348623157E308", 0x7fefffffffffffffL);
+		parseDouble("2.2250738585072014E-308", 0x0010000000000000L);
+		parseDouble("4.9E-324", 0x0000000000000001L);
+		parseDouble("1e400", 0x7ff0000000000000L);
+		parseDouble("-1e-400", 0x8000000000000000L);
+	}
+
+	private static void testParseFloat() {
+		parseFloat("0", 0x00000000);
+		parseFloat("1.5", 0x3fc00000);
+		parseFloat("0.1", 0x3dcccccd);
+		parseFloat("2.5f", 0x40200000);
+		// Halfway between two floats: round to even.
+		parseFloat("16777217", 0x4b800000);
+		parseFloat("16777219", 0x4b800002);
+		parseFloat("3.4028235E38", 0x7f7fffff);
+		parseFloat("3.4028236E38", 0x7f800000);
+		parseFloat("1e39", 0x7f800000);
+		parseFloat("1.17549435E-38", 0x00800000);
+		parseFloat("1.4E-45", 0x00000001);
+		parseFloat("0.7e-45", 0x00000000);
+	}
+
+	private static void testParseInvalid() {
+		parseInvalid("");
+		parseInvalid("NaN");
+		parseInvalid("Infinity");
+		parseInvalid("1e");
+		parseInvalid("abc");
+	}
+
+	public static void main(String args[]) {
+		testFormatDouble();
+		testFormatFloat();
+		testParseDouble();
+		testParseFloat();
+		testParseInvalid();
+
+		System.out.println("FloatingDecimalTest: " + passed + " passed, "
+				+ failed + " failed");
+		if (failed != 0) {
+			System.exit(1);
+		}
+	}
+}
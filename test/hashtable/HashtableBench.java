@@ -0,0 +1,84 @@
+import java.util.Hashtable;
+
+/**
+ * Micro-benchmark for String.hashCode() caching: repeated Hashtable
+ * lookups with the same key objects, which is what property tables,
+ * resource bundles and protocol parsers do.
+ *
+ * Usage: HashtableBench [keys [rounds [keyLength]]]
+ */
+class HashtableBench {
+
+	private static String[] makeKeys(int count, int length) {
+		String[] keys = new String[count];
+		for (int i = 0; i < count; i++) {
+			// Built at run time, so none of the keys is a ROM string
+			// with a precomputed hash.
+			StringBuffer sb = new StringBuffer(length);
+			sb.append("key.");
+			sb.append(i);
+			while (sb.length() < length) {
+				sb.append((char)('a' + (sb.length() + i) % 26));
+			}
+			keys[i] = sb.toString();
+		}
+		return keys;
+	}
+
+	private static long lookups(Hashtable table, String[] keys, int rounds) {
+		long found = 0;
+		for (int r = 0; r < rounds; r++) {
+			for (int i = 0; i < keys.length; i++) {
+				if (table.get(keys[i]) != null) {
+					found++;
+				}
+			}
+		}
+		return found;
+	}
+
+	private static int hashes(String[] keys, int rounds) {
+		int h = 0;
+		for (int r = 0; r < rounds; r++) {
+			for (int i = 0; i < keys.length; i++) {
+				h += keys[i].hashCode();
+			}
+		}
+		return h;
+	}
+
+	private static int arg(String args[], int index, int dflt) {
+		return args.length > index ? Integer.parseInt(args[index]) : dflt;
+	}
+
+	public static void main(String args[]) {
+		int count = arg(args, 0, 512);
+		int rounds = arg(args, 1, 200);
+		int length = arg(args, 2, 24);
+
+		String[] keys = makeKeys(count, length);
+		Hashtable table = new Hashtable(count * 2);
+		for (int i = 0; i < count; i++) {
+			table.put(keys[i], keys[i]);
+		}
+
+		// Warm up, so that the compiler has seen the loops.
+		lookups(table, keys, 10);
+		hashes(keys, 10);
+
+		long start = System.currentTimeMillis();
+		long found = lookups(table, keys, rounds);
+		long lookupTime = System.currentTimeMillis() - start;
+
+		start = System.currentTimeMillis();
+		int h = hashes(keys, rounds);
+		long hashTime = System.currentTimeMillis() - start;
+
+		System.out.println("HashtableBench keys=" + count + " rounds=" + rounds
+				+ " keyLength=" + length);
+		System.out.println("  Hashtable.get: " + lookupTime + " ms ("
+				+ found + " hits)");
+		System.out.println("  String.hashCode: " + hashTime + " ms ("
+				+ h + ")");
+	}
+}